@@ -0,0 +1,1046 @@
+/**
+ ******************************************************************************
+ * @file    apps_crypto_benchmark.c
+ * @author  CS application team
+ * @brief   Host cryptographic platform benchmark
+ ******************************************************************************
+ * @copyright 2022 STMicroelectronics
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "Apps/apps_crypto_benchmark.h"
+#include "Drivers/crc16/crc16.h"
+#include "Drivers/cycle_counter/cycle_counter.h"
+#include "Drivers/ram_arena/ram_arena.h"
+#include "Middleware/STM32_Cryptographic/include/cmox_crypto.h"
+#include "stse_platform_aes.h"
+#include "stse_platform_ecc.h"
+#include "stse_platform_frame_pool.h"
+#include "stse_platform_hash.h"
+#include "stse_platform_i2c.h"
+#include "stse_platform_scratch.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef STSE_CONF_CRYPTO_BENCHMARK
+
+#define APPS_BENCHMARK_KEY_MAX_SIZE 132U
+#define APPS_BENCHMARK_NOT_SUPPORTED 0xFFFFFFFFU
+
+/* Benchmarked curves */
+static const struct {
+    stse_ecc_key_type_t key_type;
+    const char *name;
+} apps_benchmark_curves[] = {
+#ifdef STSE_CONF_ECC_NIST_P_256
+    {STSE_ECC_KT_NIST_P_256, "NIST P-256"},
+#endif
+#ifdef STSE_CONF_ECC_NIST_P_384
+    {STSE_ECC_KT_NIST_P_384, "NIST P-384"},
+#endif
+#ifdef STSE_CONF_ECC_NIST_P_521
+    {STSE_ECC_KT_NIST_P_521, "NIST P-521"},
+#endif
+#ifdef STSE_CONF_ECC_BRAINPOOL_P_256
+    {STSE_ECC_KT_BP_P_256, "BP P-256"},
+#endif
+#ifdef STSE_CONF_ECC_BRAINPOOL_P_384
+    {STSE_ECC_KT_BP_P_384, "BP P-384"},
+#endif
+#ifdef STSE_CONF_ECC_BRAINPOOL_P_512
+    {STSE_ECC_KT_BP_P_512, "BP P-512"},
+#endif
+#ifdef STSE_CONF_ECC_CURVE_25519
+    {STSE_ECC_KT_CURVE25519, "X25519"},
+#endif
+#ifdef STSE_CONF_ECC_EDWARD_25519
+    {STSE_ECC_KT_ED25519, "Ed25519"},
+#endif
+};
+
+#define APPS_BENCHMARK_CURVE_COUNT (sizeof(apps_benchmark_curves) / sizeof(apps_benchmark_curves[0]))
+
+/* Streamed hash algorithms */
+static const struct {
+    stse_hash_algorithm_t hash_algo;
+    uint16_t digest_size;
+    const char *name;
+} apps_benchmark_hashes[] = {
+#ifdef STSE_CONF_HASH_SHA_1
+    {STSE_SHA_1, CMOX_SHA1_SIZE, "SHA-1"},
+#endif
+#ifdef STSE_CONF_HASH_SHA_224
+    {STSE_SHA_224, CMOX_SHA224_SIZE, "SHA-224"},
+#endif
+#ifdef STSE_CONF_HASH_SHA_256
+    {STSE_SHA_256, CMOX_SHA256_SIZE, "SHA-256"},
+#endif
+#ifdef STSE_CONF_HASH_SHA_384
+    {STSE_SHA_384, CMOX_SHA384_SIZE, "SHA-384"},
+#endif
+#ifdef STSE_CONF_HASH_SHA_512
+    {STSE_SHA_512, CMOX_SHA512_SIZE, "SHA-512"},
+#endif
+#ifdef STSE_CONF_HASH_SHA_3_256
+    {STSE_SHA3_256, CMOX_SHA3_256_SIZE, "SHA3-256"},
+#endif
+#ifdef STSE_CONF_HASH_SHA_3_384
+    {STSE_SHA3_384, CMOX_SHA3_384_SIZE, "SHA3-384"},
+#endif
+#ifdef STSE_CONF_HASH_SHA_3_512
+    {STSE_SHA3_512, CMOX_SHA3_512_SIZE, "SHA3-512"},
+#endif
+};
+#define APPS_BENCHMARK_HASH_COUNT (sizeof(apps_benchmark_hashes) / sizeof(apps_benchmark_hashes[0]))
+
+/* ECC operation cycle counts */
+typedef struct {
+    uint32_t keygen;
+    uint32_t sign;
+    uint32_t verify;
+    uint32_t ecdh;
+} apps_benchmark_ecc_cycles_t;
+
+/* --- Static Function Definitions --- */
+
+/**
+ * @brief  Print a cycle count column.
+ * @param  cycles: Average cycle count
+ */
+static void apps_benchmark_print_cycles(uint32_t cycles) {
+    if (cycles == APPS_BENCHMARK_NOT_SUPPORTED) {
+        printf(" %12s %8s", "-", "");
+    } else {
+        printf(" %12lu %5lu ms", (unsigned long)cycles, (unsigned long)cycle_counter_to_ms(cycles));
+    }
+}
+
+/**
+ * @brief  Measure one curve with the current profile.
+ * @param  key_type: Curve
+ * @param  pCycles: Average cycles per operation
+ * @retval STSE_OK on success, first error otherwise
+ */
+static stse_ReturnCode_t apps_benchmark_ecc_curve(stse_ecc_key_type_t key_type, apps_benchmark_ecc_cycles_t *pCycles) {
+    static uint8_t priv_key[2][APPS_BENCHMARK_KEY_MAX_SIZE];
+    static uint8_t pub_key[2][APPS_BENCHMARK_KEY_MAX_SIZE];
+    static uint8_t signature[APPS_BENCHMARK_KEY_MAX_SIZE];
+    static uint8_t secret[APPS_BENCHMARK_KEY_MAX_SIZE];
+    uint8_t digest[32];
+    uint8_t has_signature = 1;
+    uint8_t has_ecdh = 1;
+    uint64_t keygen = 0, sign = 0, verify = 0, ecdh = 0;
+    uint32_t start;
+    stse_ReturnCode_t ret;
+
+#ifdef STSE_CONF_ECC_CURVE_25519
+    has_signature = (key_type != STSE_ECC_KT_CURVE25519);
+#endif
+#ifdef STSE_CONF_ECC_EDWARD_25519
+    has_ecdh = (key_type != STSE_ECC_KT_ED25519);
+#endif
+
+    for (uint8_t i = 0; i < sizeof(digest); i++) {
+        digest[i] = i;
+    }
+
+    for (uint32_t n = 0; n < APPS_CRYPTO_BENCHMARK_ITERATIONS; n++) {
+        /* - Key generation (two key pairs for ECDH) */
+        start = cycle_counter_get();
+        ret = stse_platform_ecc_generate_key_pair(key_type, priv_key[0], pub_key[0]);
+        keygen += cycle_counter_get() - start;
+        if (ret != STSE_OK) {
+            return ret;
+        }
+
+        if (has_signature) {
+            start = cycle_counter_get();
+            ret = stse_platform_ecc_sign(key_type, priv_key[0], digest, sizeof(digest), signature);
+            sign += cycle_counter_get() - start;
+            if (ret != STSE_OK) {
+                return ret;
+            }
+
+            start = cycle_counter_get();
+            ret = stse_platform_ecc_verify(key_type, pub_key[0], digest, sizeof(digest), signature);
+            verify += cycle_counter_get() - start;
+            if (ret != STSE_OK) {
+                return ret;
+            }
+        }
+
+        if (has_ecdh) {
+            ret = stse_platform_ecc_generate_key_pair(key_type, priv_key[1], pub_key[1]);
+            if (ret != STSE_OK) {
+                return ret;
+            }
+
+            start = cycle_counter_get();
+            ret = stse_platform_ecc_ecdh(key_type, pub_key[1], priv_key[0], secret);
+            ecdh += cycle_counter_get() - start;
+            if (ret != STSE_OK) {
+                return ret;
+            }
+        }
+    }
+
+    pCycles->keygen = (uint32_t)(keygen / APPS_CRYPTO_BENCHMARK_ITERATIONS);
+    pCycles->sign = has_signature ? (uint32_t)(sign / APPS_CRYPTO_BENCHMARK_ITERATIONS) : APPS_BENCHMARK_NOT_SUPPORTED;
+    pCycles->verify = has_signature ? (uint32_t)(verify / APPS_CRYPTO_BENCHMARK_ITERATIONS) : APPS_BENCHMARK_NOT_SUPPORTED;
+    pCycles->ecdh = has_ecdh ? (uint32_t)(ecdh / APPS_CRYPTO_BENCHMARK_ITERATIONS) : APPS_BENCHMARK_NOT_SUPPORTED;
+
+    /* - Keys are not reused */
+    memset(priv_key, 0, sizeof(priv_key));
+    memset(secret, 0, sizeof(secret));
+
+    return STSE_OK;
+}
+
+/* --- Public Function Definitions --- */
+
+void apps_crypto_benchmark_ecc(void) {
+    static const char *profile_names[] = {"SMALL", "FAST"};
+    apps_benchmark_ecc_cycles_t cycles;
+    uint32_t math_buffer_used;
+    stse_ReturnCode_t ret;
+
+    printf("\n\r ## ECC benchmark (%lu MHz, average of %u runs, math buffer %u bytes)",
+           (unsigned long)(SystemCoreClock / 1000000U), APPS_CRYPTO_BENCHMARK_ITERATIONS, STSE_PLATFORM_ECC_MATH_BUFFER_SIZE);
+    printf("\n\r %-10s %-5s %21s %21s %21s %21s", "curve", "prof.", "keygen (cycles)", "sign (cycles)", "verify (cycles)", "ecdh (cycles)");
+
+    for (uint8_t c = 0; c < APPS_BENCHMARK_CURVE_COUNT; c++) {
+        stse_ecc_key_type_t key_type = apps_benchmark_curves[c].key_type;
+        stse_platform_ecc_profile_t initial_profile = stse_platform_ecc_get_profile(key_type);
+
+        for (uint8_t p = STSE_PLATFORM_ECC_PROFILE_SMALL; p <= STSE_PLATFORM_ECC_PROFILE_FAST; p++) {
+            /* - Skip profiles not linked in this build */
+            if (stse_platform_ecc_set_profile(key_type, (stse_platform_ecc_profile_t)p) != STSE_OK) {
+                continue;
+            }
+
+            printf("\n\r %-10s %-5s", apps_benchmark_curves[c].name, profile_names[p]);
+            ret = apps_benchmark_ecc_curve(key_type, &cycles);
+            if (ret != STSE_OK) {
+                printf(" ERROR 0x%04X", ret);
+                continue;
+            }
+            apps_benchmark_print_cycles(cycles.keygen);
+            apps_benchmark_print_cycles(cycles.sign);
+            apps_benchmark_print_cycles(cycles.verify);
+            apps_benchmark_print_cycles(cycles.ecdh);
+        }
+
+        stse_platform_ecc_set_profile(key_type, initial_profile);
+    }
+
+    /* - Math buffer size check of the current profiles */
+    ret = stse_platform_ecc_check_math_buffer(&math_buffer_used);
+    printf("\n\r  - Math buffer check : %s, %lu / %u bytes used", (ret == STSE_OK) ? "OK" : "ERROR",
+           (unsigned long)math_buffer_used, STSE_PLATFORM_ECC_MATH_BUFFER_SIZE);
+    printf("\n\r");
+}
+
+/**
+ * @brief  Math buffer of the benchmarks, carved once from the RAM2 arena (same
+ *         memory as the math buffers of the platform ECC contexts).
+ * @retval Buffer of STSE_PLATFORM_ECC_MATH_BUFFER_SIZE bytes, NULL if the arena is too small
+ */
+static uint8_t *apps_benchmark_math_buffer(void) {
+    static uint8_t *pMath_buffer = NULL;
+
+    if (pMath_buffer == NULL) {
+        pMath_buffer = ram_arena_alloc(STSE_PLATFORM_ECC_MATH_BUFFER_SIZE, 4);
+        if (pMath_buffer == NULL) {
+            printf("\n\r ## RAM2 arena too small for the benchmark math buffer (%lu bytes free)\n\r",
+                   (unsigned long)ram_arena_get_free());
+        }
+    }
+
+    return pMath_buffer;
+}
+
+void apps_crypto_benchmark_ecc_context(void) {
+    static cmox_ecc_handle_t ecc_ctx;
+    uint8_t *math_buffer = apps_benchmark_math_buffer();
+    stse_platform_ecc_pool_stats_t stats;
+    uint64_t cycles = 0;
+    uint32_t start;
+
+    if (math_buffer == NULL) {
+        return;
+    }
+
+    /* - Per-operation setup of the unpooled glue : construct + cleanup */
+    for (uint32_t n = 0; n < APPS_CRYPTO_BENCHMARK_ITERATIONS; n++) {
+        start = cycle_counter_get();
+        cmox_ecc_construct(&ecc_ctx, CMOX_MATH_FUNCS_SMALL, math_buffer, STSE_PLATFORM_ECC_MATH_BUFFER_SIZE);
+        cmox_ecc_cleanup(&ecc_ctx);
+        cycles += cycle_counter_get() - start;
+    }
+
+    stse_platform_ecc_get_pool_stats(&stats);
+    printf("\n\r ## ECC context pool (%u contexts)", STSE_CONF_ECC_CONTEXT_POOL_SIZE);
+    printf("\n\r  - Setup eliminated per operation : %lu cycles (construct + cleanup)",
+           (unsigned long)(cycles / APPS_CRYPTO_BENCHMARK_ITERATIONS));
+    printf("\n\r  - %lu operations, %lu constructions, %lu rejected (pool exhausted), %u contexts used at most",
+           (unsigned long)stats.acquire_count,
+           (unsigned long)stats.construct_count,
+           (unsigned long)stats.exhausted_count,
+           stats.max_in_use);
+    printf("\n\r");
+}
+
+void apps_crypto_benchmark_scratch(void) {
+    uint8_t *math_buffer = apps_benchmark_math_buffer();
+    stse_platform_ecc_pool_stats_t pool_stats;
+    stse_platform_scratch_stats_t scratch_stats;
+    uint32_t hwm;
+    uint32_t touched;
+    uint32_t cycles[3];
+    uint32_t start;
+
+    if (math_buffer == NULL) {
+        return;
+    }
+
+    /* - Math buffer usage of the ECC operations run so far */
+    stse_platform_ecc_get_pool_stats(&pool_stats);
+    hwm = pool_stats.math_buffer_hwm;
+
+    /* - Blanket wipe of the whole math buffer */
+    memset(math_buffer, 0xA5, hwm);
+    start = cycle_counter_get();
+    memset(math_buffer, 0, STSE_PLATFORM_ECC_MATH_BUFFER_SIZE);
+    cycles[0] = cycle_counter_get() - start;
+
+    /* - Wipe up to the learned bound and check the guard word (ECC context release) */
+    memset(math_buffer, 0xA5, hwm);
+    start = cycle_counter_get();
+    touched = stse_platform_scratch_wipe_touched(math_buffer, STSE_PLATFORM_ECC_MATH_BUFFER_SIZE, hwm, 0);
+    cycles[1] = cycle_counter_get() - start;
+
+    /* - Scan from the end and wipe (first or periodic release) */
+    memset(math_buffer, 0xA5, hwm);
+    start = cycle_counter_get();
+    touched = stse_platform_scratch_wipe_touched(math_buffer, STSE_PLATFORM_ECC_MATH_BUFFER_SIZE, hwm, 1);
+    cycles[2] = cycle_counter_get() - start;
+
+    stse_platform_scratch_get_stats(&scratch_stats);
+    printf("\n\r ## Crypto scratch zeroisation (math buffer %u bytes, %lu bytes touched, %lu wiped)",
+           STSE_PLATFORM_ECC_MATH_BUFFER_SIZE, (unsigned long)hwm, (unsigned long)touched);
+    printf("\n\r  - memset of the whole buffer : %lu cycles", (unsigned long)cycles[0]);
+    printf("\n\r  - Bounded wipe + guard word  : %lu cycles (%ld saved)", (unsigned long)cycles[1],
+           (long)cycles[0] - (long)cycles[1]);
+    printf("\n\r  - Scan from the end and wipe : %lu cycles (1 release out of %u)", (unsigned long)cycles[2],
+           STSE_PLATFORM_ECC_MATH_FULL_SCAN_PERIOD);
+    printf("\n\r  - Average per release        : %lu cycles, %lu / %lu releases scanned",
+           (unsigned long)((cycles[1] * (STSE_PLATFORM_ECC_MATH_FULL_SCAN_PERIOD - 1U) + cycles[2]) /
+                           STSE_PLATFORM_ECC_MATH_FULL_SCAN_PERIOD),
+           (unsigned long)pool_stats.math_scan_count, (unsigned long)pool_stats.acquire_count);
+    printf("\n\r  - Scratch arena : %lu regions, peak %lu / %u bytes, %lu bytes wiped, %lu rejected",
+           (unsigned long)scratch_stats.alloc_count,
+           (unsigned long)scratch_stats.peak,
+           STSE_CONF_CRYPTO_SCRATCH_SIZE,
+           (unsigned long)scratch_stats.wiped_byte_count,
+           (unsigned long)scratch_stats.failed_count);
+    printf("\n\r");
+}
+
+#ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
+void apps_crypto_benchmark_frame_pool(void) {
+    static const uint16_t frame_lengths[] = {STSE_PLATFORM_FRAME_POOL_SMALL_SIZE, STSE_PLATFORM_FRAME_POOL_MEDIUM_SIZE,
+                                             STSE_PLATFORM_FRAME_POOL_LARGE_SIZE};
+    stse_platform_frame_pool_stats_t stats;
+    stse_platform_frame_t frame = {0};
+    uint8_t *pBuffer;
+    uint32_t start;
+
+    printf("\n\r ## I2C frame buffers (start + stop)      malloc/free   frame pool");
+    for (uint8_t i = 0; i < (sizeof(frame_lengths) / sizeof(frame_lengths[0])); i++) {
+        uint64_t heap_cycles = 0;
+        uint64_t pool_cycles = 0;
+
+        for (uint32_t n = 0; n < APPS_CRYPTO_BENCHMARK_ITERATIONS; n++) {
+            start = cycle_counter_get();
+            pBuffer = malloc(frame_lengths[i]);
+            free(pBuffer);
+            heap_cycles += cycle_counter_get() - start;
+
+            start = cycle_counter_get();
+            if (stse_platform_frame_pool_alloc(&frame, frame_lengths[i]) == STSE_OK) {
+                stse_platform_frame_pool_free(&frame);
+            }
+            pool_cycles += cycle_counter_get() - start;
+        }
+
+        printf("\n\r  - %3u bytes frame                   %12lu %12lu", frame_lengths[i],
+               (unsigned long)(heap_cycles / APPS_CRYPTO_BENCHMARK_ITERATIONS),
+               (unsigned long)(pool_cycles / APPS_CRYPTO_BENCHMARK_ITERATIONS));
+    }
+
+    /* - Aborted transaction : the next start reclaims the block */
+    stse_platform_frame_pool_alloc(&frame, STSE_PLATFORM_FRAME_POOL_LARGE_SIZE);
+    stse_platform_frame_pool_alloc(&frame, STSE_PLATFORM_FRAME_POOL_LARGE_SIZE);
+    stse_platform_frame_pool_free(&frame);
+
+    stse_platform_frame_pool_get_stats(&stats);
+    printf("\n\r  - Pool : %lu/%lu/%lu blocks handed out, %lu spilled, %lu exhausted, %lu reclaimed, %lu stale",
+           (unsigned long)stats.alloc_count[STSE_PLATFORM_FRAME_POOL_SMALL],
+           (unsigned long)stats.alloc_count[STSE_PLATFORM_FRAME_POOL_MEDIUM],
+           (unsigned long)stats.alloc_count[STSE_PLATFORM_FRAME_POOL_LARGE],
+           (unsigned long)stats.spill_count,
+           (unsigned long)stats.exhausted_count,
+           (unsigned long)stats.reclaim_count,
+           (unsigned long)stats.stale_count);
+    printf("\n\r");
+}
+#endif /* STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION */
+
+/**
+ * @brief  Echoed frame compare of the result callback (flash code)
+ * @param  pFrame: Sent frame
+ * @param  pEchoed: Echoed frame
+ * @param  length: Frame length
+ * @retval Number of differing bytes
+ */
+static uint32_t apps_benchmark_frame_compare(const uint8_t *pFrame, const uint8_t *pEchoed, uint16_t length) {
+    uint32_t error_count = 0;
+
+    for (uint16_t i = 0; i < length; i++) {
+        if (pFrame[i] != pEchoed[i]) {
+            error_count++;
+        }
+    }
+
+    return error_count;
+}
+
+void apps_crypto_benchmark_hot_path(void) {
+    static uint8_t frame[APPS_CRYPTO_BENCHMARK_FRAME_SIZE];
+    static uint8_t echoed[APPS_CRYPTO_BENCHMARK_FRAME_SIZE];
+    const uint32_t acr_mask = FLASH_ACR_LATENCY_Msk | FLASH_ACR_PRFTEN | FLASH_ACR_ICEN | FLASH_ACR_DCEN;
+    uint32_t initial_acr = FLASH->ACR;
+    const struct {
+        const char *name;
+        uint32_t acr;
+    } flash_configs[] = {
+        {"4 WS, no prefetch     ", FLASH_ACR_LATENCY_4WS | FLASH_ACR_ICEN | FLASH_ACR_DCEN},
+        {"Current (prefetch+ART)", initial_acr & acr_mask},
+    };
+    uint32_t error_count = 0;
+
+    for (uint16_t i = 0; i < sizeof(frame); i += 4) {
+        uint32_t random = stse_platform_generate_random();
+        memcpy(&frame[i], &random, ((sizeof(frame) - i) < 4) ? (sizeof(frame) - i) : 4);
+    }
+    memcpy(echoed, frame, sizeof(frame));
+
+    /* - crc16_Calculate() is the .ramfunc copy (flash with RAM_FUNC_IN_FLASH), crc16_Calculate_flash() stays in flash */
+    printf("\n\r ## Echo hot path (%u bytes frame, CRC16 kernel in flash vs %s)", APPS_CRYPTO_BENCHMARK_FRAME_SIZE,
+           (((uint32_t)&crc16_Calculate & 0xFF000000U) == SRAM2_BASE) ? "SRAM2" : "flash (RAM_FUNC_IN_FLASH)");
+
+    for (uint8_t c = 0; c < (sizeof(flash_configs) / sizeof(flash_configs[0])); c++) {
+        uint64_t crc_flash_cycles = 0;
+        uint64_t crc_cycles = 0;
+        uint64_t compare_cycles = 0;
+        uint16_t crc_flash;
+        uint16_t crc;
+        uint32_t start;
+
+        /* - Switch the flash configuration (4 WS is valid up to 80 MHz, the current one at the current clock) */
+        FLASH->ACR = (FLASH->ACR & ~acr_mask) | flash_configs[c].acr;
+        while ((FLASH->ACR & FLASH_ACR_LATENCY_Msk) != (flash_configs[c].acr & FLASH_ACR_LATENCY_Msk))
+            ;
+
+        for (uint32_t n = 0; n < APPS_CRYPTO_BENCHMARK_ITERATIONS; n++) {
+            start = cycle_counter_get();
+            crc_flash = crc16_Calculate_flash(frame, sizeof(frame));
+            crc_flash_cycles += cycle_counter_get() - start;
+
+            start = cycle_counter_get();
+            crc = crc16_Calculate(frame, sizeof(frame));
+            crc_cycles += cycle_counter_get() - start;
+            error_count += (crc != crc_flash);
+
+            start = cycle_counter_get();
+            error_count += apps_benchmark_frame_compare(frame, echoed, sizeof(echoed));
+            compare_cycles += cycle_counter_get() - start;
+        }
+
+        printf("\n\r  - %s : CRC16 flash %lu cycles, .ramfunc %lu cycles, compare %lu cycles", flash_configs[c].name,
+               (unsigned long)(crc_flash_cycles / APPS_CRYPTO_BENCHMARK_ITERATIONS),
+               (unsigned long)(crc_cycles / APPS_CRYPTO_BENCHMARK_ITERATIONS),
+               (unsigned long)(compare_cycles / APPS_CRYPTO_BENCHMARK_ITERATIONS));
+    }
+
+    /* - Restore the SystemInit flash configuration */
+    FLASH->ACR = initial_acr;
+    while ((FLASH->ACR & FLASH_ACR_LATENCY_Msk) != (initial_acr & FLASH_ACR_LATENCY_Msk))
+        ;
+
+    if (error_count != 0) {
+        printf("\n\r  - Compare ERROR (%lu mismatches)", (unsigned long)error_count);
+    }
+    printf("\n\r");
+}
+
+void apps_crypto_benchmark_ecc_verify_batch(void) {
+    static uint8_t priv_key[APPS_BENCHMARK_KEY_MAX_SIZE];
+    static uint8_t pub_key[APPS_CRYPTO_BENCHMARK_BATCH_SIZE][APPS_BENCHMARK_KEY_MAX_SIZE];
+    static uint8_t digest[APPS_CRYPTO_BENCHMARK_BATCH_SIZE][32];
+    static uint8_t signature[APPS_CRYPTO_BENCHMARK_BATCH_SIZE][APPS_BENCHMARK_KEY_MAX_SIZE];
+    static stse_platform_ecc_verify_item_t items[APPS_CRYPTO_BENCHMARK_BATCH_SIZE];
+    stse_ecc_key_type_t key_type = STSE_ECC_KT_INVALID;
+    const char *name = NULL;
+    uint16_t failed_count = 0;
+    uint32_t single_cycles;
+    uint32_t batch_cycles;
+    uint32_t start;
+    stse_ReturnCode_t ret = STSE_OK;
+
+    /* - First enabled signature curve */
+    for (uint8_t c = 0; c < APPS_BENCHMARK_CURVE_COUNT; c++) {
+#ifdef STSE_CONF_ECC_CURVE_25519
+        if (apps_benchmark_curves[c].key_type == STSE_ECC_KT_CURVE25519) {
+            continue;
+        }
+#endif
+        key_type = apps_benchmark_curves[c].key_type;
+        name = apps_benchmark_curves[c].name;
+        break;
+    }
+    if (key_type == STSE_ECC_KT_INVALID) {
+        return;
+    }
+
+    /* - One key pair and signature per accessory */
+    for (uint8_t i = 0; (i < APPS_CRYPTO_BENCHMARK_BATCH_SIZE) && (ret == STSE_OK); i++) {
+        memset(digest[i], i, sizeof(digest[i]));
+        ret = stse_platform_ecc_generate_key_pair(key_type, priv_key, pub_key[i]);
+        if (ret == STSE_OK) {
+            ret = stse_platform_ecc_sign(key_type, priv_key, digest[i], sizeof(digest[i]), signature[i]);
+        }
+        items[i].pPubKey = pub_key[i];
+        items[i].pDigest = digest[i];
+        items[i].digestLen = sizeof(digest[i]);
+        items[i].pSignature = signature[i];
+    }
+    memset(priv_key, 0, sizeof(priv_key));
+    if (ret != STSE_OK) {
+        printf("\n\r ## Batch verify benchmark : signature ERROR 0x%04X", ret);
+        return;
+    }
+
+    /* - One-at-a-time loop */
+    start = cycle_counter_get();
+    for (uint8_t i = 0; i < APPS_CRYPTO_BENCHMARK_BATCH_SIZE; i++) {
+        if (stse_platform_ecc_verify(key_type, items[i].pPubKey, items[i].pDigest, items[i].digestLen, items[i].pSignature) != STSE_OK) {
+            failed_count++;
+        }
+    }
+    single_cycles = cycle_counter_get() - start;
+
+    /* - Batch API */
+#if (STSE_CONF_ECC_VERIFY_CACHE_BUDGET > 0)
+    stse_platform_ecc_verify_cache_invalidate(key_type, NULL);
+#endif
+    start = cycle_counter_get();
+    stse_platform_ecc_verify_batch(key_type, items, APPS_CRYPTO_BENCHMARK_BATCH_SIZE, &failed_count);
+    batch_cycles = cycle_counter_get() - start;
+
+    printf("\n\r ## ECDSA batch verify (%s, %u signatures)", name, APPS_CRYPTO_BENCHMARK_BATCH_SIZE);
+    printf("\n\r  - One at a time : %lu cycles/verify, %lu verify/s",
+           (unsigned long)(single_cycles / APPS_CRYPTO_BENCHMARK_BATCH_SIZE),
+           (unsigned long)(((uint64_t)APPS_CRYPTO_BENCHMARK_BATCH_SIZE * SystemCoreClock) / single_cycles));
+    printf("\n\r  - Batch         : %lu cycles/verify, %lu verify/s, %u failed",
+           (unsigned long)(batch_cycles / APPS_CRYPTO_BENCHMARK_BATCH_SIZE),
+           (unsigned long)(((uint64_t)APPS_CRYPTO_BENCHMARK_BATCH_SIZE * SystemCoreClock) / batch_cycles),
+           failed_count);
+
+#if (STSE_CONF_ECC_VERIFY_CACHE_BUDGET > 0)
+    /* - Same signatures again : answered by the verification cache */
+    {
+        stse_platform_ecc_verify_cache_stats_t cache_stats;
+        uint32_t cached_cycles;
+
+        start = cycle_counter_get();
+        stse_platform_ecc_verify_batch(key_type, items, APPS_CRYPTO_BENCHMARK_BATCH_SIZE, &failed_count);
+        cached_cycles = cycle_counter_get() - start;
+        stse_platform_ecc_get_verify_cache_stats(&cache_stats);
+        printf("\n\r  - Cached        : %lu cycles/verify, %u failed (cache hit %lu miss %lu eviction %lu)",
+               (unsigned long)(cached_cycles / APPS_CRYPTO_BENCHMARK_BATCH_SIZE),
+               failed_count,
+               (unsigned long)cache_stats.hit_count,
+               (unsigned long)cache_stats.miss_count,
+               (unsigned long)cache_stats.eviction_count);
+    }
+#endif /* STSE_CONF_ECC_VERIFY_CACHE_BUDGET > 0 */
+
+    /* - Per-item results : a corrupted signature is reported alone */
+    signature[APPS_CRYPTO_BENCHMARK_BATCH_SIZE - 1][0] ^= 0x01;
+    stse_platform_ecc_verify_batch(key_type, items, APPS_CRYPTO_BENCHMARK_BATCH_SIZE, &failed_count);
+    printf("\n\r  - Corrupted last signature : %u failed, last item %s",
+           failed_count, (items[APPS_CRYPTO_BENCHMARK_BATCH_SIZE - 1].result != STSE_OK) ? "rejected" : "ACCEPTED");
+    printf("\n\r");
+}
+
+void apps_crypto_benchmark_hash_stream(void) {
+    static uint8_t message[APPS_CRYPTO_BENCHMARK_HASH_MESSAGE_SIZE];
+    stse_platform_hash_ctx_t hash_ctx;
+    uint8_t one_shot[CMOX_SHA512_SIZE];
+    uint8_t streamed[CMOX_SHA512_SIZE];
+    uint16_t one_shot_length;
+    uint16_t streamed_length;
+
+    printf("\n\r ## Streaming hash equivalence (%u random chunkings per algorithm)", APPS_CRYPTO_BENCHMARK_HASH_TRIALS);
+
+    for (uint16_t i = 0; i < sizeof(message); i += 4) {
+        uint32_t random = stse_platform_generate_random();
+        memcpy(&message[i], &random, ((sizeof(message) - i) < 4) ? (sizeof(message) - i) : 4);
+    }
+
+    for (uint8_t a = 0; a < APPS_BENCHMARK_HASH_COUNT; a++) {
+        uint16_t failed_count = 0;
+
+        for (uint16_t trial = 0; trial < APPS_CRYPTO_BENCHMARK_HASH_TRIALS; trial++) {
+            uint16_t length = (uint16_t)(stse_platform_generate_random() % (sizeof(message) + 1U));
+            uint16_t offset = 0;
+            stse_ReturnCode_t ret;
+
+            /* - Reference : one-shot digest */
+            one_shot_length = apps_benchmark_hashes[a].digest_size;
+            ret = stse_platform_hash_compute(apps_benchmark_hashes[a].hash_algo, message, length, one_shot, &one_shot_length);
+
+            /* - Same message fed in random chunks (empty chunks included) */
+            if (ret == STSE_OK) {
+                ret = stse_platform_hash_init(&hash_ctx, apps_benchmark_hashes[a].hash_algo);
+            }
+            while ((ret == STSE_OK) && (offset < length)) {
+                uint16_t chunk = (uint16_t)(stse_platform_generate_random() % (APPS_CRYPTO_BENCHMARK_HASH_MAX_CHUNK + 1U));
+
+                if (chunk > (length - offset)) {
+                    chunk = length - offset;
+                }
+                ret = stse_platform_hash_update(&hash_ctx, &message[offset], chunk);
+                offset += chunk;
+            }
+            streamed_length = sizeof(streamed);
+            if (ret == STSE_OK) {
+                ret = stse_platform_hash_final(&hash_ctx, streamed, &streamed_length);
+            }
+
+            if ((ret != STSE_OK) ||
+                (streamed_length != one_shot_length) ||
+                (memcmp(streamed, one_shot, one_shot_length) != 0)) {
+                failed_count++;
+            }
+        }
+
+        printf("\n\r  - %-8s : %s (%u/%u)",
+               apps_benchmark_hashes[a].name,
+               (failed_count == 0) ? "PASS" : "FAIL",
+               (unsigned)(APPS_CRYPTO_BENCHMARK_HASH_TRIALS - failed_count),
+               APPS_CRYPTO_BENCHMARK_HASH_TRIALS);
+    }
+    printf("\n\r");
+}
+
+/**
+ * @brief  HKDF expand as previously implemented : HMAC key set up again for each block.
+ */
+static stse_ReturnCode_t apps_benchmark_hkdf_expand_reference(uint8_t *pPrk, uint8_t *pInfo, uint16_t info_length,
+                                                              uint8_t *pOkm, uint16_t okm_length) {
+    cmox_hmac_handle_t hmac_handle;
+    cmox_mac_handle_t *pMac_handle = cmox_hmac_construct(&hmac_handle, CMOX_HMAC_SHA256);
+    cmox_mac_retval_t retval = cmox_mac_init(pMac_handle);
+    uint8_t block[CMOX_SHA256_SIZE];
+    uint16_t block_length = 0;
+    uint8_t n = 1;
+
+    for (uint16_t offset = 0; (offset < okm_length) && (retval == CMOX_MAC_SUCCESS); n++) {
+        uint16_t left = okm_length - offset;
+
+        retval = cmox_mac_setKey(pMac_handle, pPrk, CMOX_SHA256_SIZE);
+        if (retval == CMOX_MAC_SUCCESS) {
+            retval = cmox_mac_append(pMac_handle, block, block_length);
+        }
+        if (retval == CMOX_MAC_SUCCESS) {
+            retval = cmox_mac_append(pMac_handle, pInfo, info_length);
+        }
+        if (retval == CMOX_MAC_SUCCESS) {
+            retval = cmox_mac_append(pMac_handle, &n, 1);
+        }
+        if (retval == CMOX_MAC_SUCCESS) {
+            retval = cmox_mac_generateTag(pMac_handle, block, NULL);
+        }
+        left = (left < CMOX_SHA256_SIZE) ? left : CMOX_SHA256_SIZE;
+        memcpy(&pOkm[offset], block, left);
+        block_length = CMOX_SHA256_SIZE;
+        offset += left;
+    }
+    cmox_mac_cleanup(pMac_handle);
+
+    return (retval == CMOX_MAC_SUCCESS) ? STSE_OK : STSE_PLATFORM_HKDF_ERROR;
+}
+
+void apps_crypto_benchmark_hkdf(void) {
+    static const uint16_t okm_lengths[] = {16, 32, 64, 128, 256, 1024, 4096, STSE_PLATFORM_HKDF_SHA256_MAX_OUTPUT_SIZE};
+    static uint8_t okm[STSE_PLATFORM_HKDF_SHA256_MAX_OUTPUT_SIZE];
+    static uint8_t okm_reference[STSE_PLATFORM_HKDF_SHA256_MAX_OUTPUT_SIZE];
+    uint8_t ikm[32];
+    uint8_t salt[32];
+    uint8_t info[16];
+    uint8_t prk[CMOX_SHA256_SIZE];
+    uint32_t reference_cycles;
+    uint32_t expand_cycles;
+    uint32_t fused_cycles;
+    uint32_t start;
+    stse_ReturnCode_t ret;
+
+    memset(ikm, 0x0B, sizeof(ikm));
+    memset(salt, 0x5A, sizeof(salt));
+    memset(info, 0xF0, sizeof(info));
+
+    printf("\n\r ## HKDF-SHA256 (cycles : per-block key setup / prepared pads / fused extract+expand)");
+
+    /* - Cloned prepared states against the one-shot CMOX HMAC */
+    ret = stse_platform_hmac_sha256_check();
+    printf("\n\r  - Prepared HMAC known-answer check : %s", (ret == STSE_OK) ? "OK" : "ERROR");
+
+    for (uint8_t i = 0; i < (sizeof(okm_lengths) / sizeof(okm_lengths[0])); i++) {
+        uint16_t okm_length = okm_lengths[i];
+
+        ret = stse_platform_hmac_sha256_extract(salt, sizeof(salt), ikm, sizeof(ikm), prk, sizeof(prk));
+        if (ret == STSE_OK) {
+            start = cycle_counter_get();
+            ret = apps_benchmark_hkdf_expand_reference(prk, info, sizeof(info), okm_reference, okm_length);
+            reference_cycles = cycle_counter_get() - start;
+        }
+        if (ret == STSE_OK) {
+            start = cycle_counter_get();
+            ret = stse_platform_hmac_sha256_expand(prk, sizeof(prk), info, sizeof(info), okm, okm_length);
+            expand_cycles = cycle_counter_get() - start;
+        }
+        if ((ret == STSE_OK) && (memcmp(okm, okm_reference, okm_length) != 0)) {
+            ret = STSE_PLATFORM_HKDF_ERROR;
+        }
+        if (ret == STSE_OK) {
+            start = cycle_counter_get();
+            ret = stse_platform_hkdf_sha256(salt, sizeof(salt), ikm, sizeof(ikm), info, sizeof(info), okm, okm_length);
+            fused_cycles = cycle_counter_get() - start;
+        }
+        if ((ret == STSE_OK) && (memcmp(okm, okm_reference, okm_length) != 0)) {
+            ret = STSE_PLATFORM_HKDF_ERROR;
+        }
+
+        if (ret != STSE_OK) {
+            printf("\n\r  - %4u bytes : ERROR 0x%04X", okm_length, ret);
+            continue;
+        }
+        printf("\n\r  - %4u bytes : %8lu / %8lu / %8lu",
+               okm_length,
+               (unsigned long)reference_cycles,
+               (unsigned long)expand_cycles,
+               (unsigned long)fused_cycles);
+    }
+    memset(prk, 0, sizeof(prk));
+    printf("\n\r");
+}
+
+/**
+ * @brief  Print a cycles per byte figure with one decimal.
+ */
+static void apps_benchmark_print_cycles_per_byte(uint32_t cycles, uint16_t length) {
+    uint32_t tenths = (uint32_t)(((uint64_t)cycles * 10U) / length);
+
+    printf(" %5lu.%lu", (unsigned long)(tenths / 10U), (unsigned long)(tenths % 10U));
+}
+
+void apps_crypto_benchmark_aes(void) {
+    static const uint16_t payload_lengths[] = {16, 32, 64, 128, 256, 512, 752};
+    const struct {
+        const char *name;
+        cmox_cipher_algo_t cbc_enc;
+        cmox_cipher_algo_t cbc_dec;
+        cmox_cipher_algo_t ecb_enc;
+        cmox_mac_algo_t cmac;
+    } backends[] = {
+        {"AESSMALL", CMOX_AESSMALL_CBC_ENC_ALGO, CMOX_AESSMALL_CBC_DEC_ALGO, CMOX_AESSMALL_ECB_ENC_ALGO, CMOX_CMAC_AESSMALL_ALGO},
+        {"AESFAST", CMOX_AESFAST_CBC_ENC_ALGO, CMOX_AESFAST_CBC_DEC_ALGO, CMOX_AESFAST_ECB_ENC_ALGO, CMOX_CMAC_AESFAST_ALGO},
+    };
+    static uint8_t plaintext[APPS_CRYPTO_BENCHMARK_AES_MAX_PAYLOAD];
+    static uint8_t ciphertext[APPS_CRYPTO_BENCHMARK_AES_MAX_PAYLOAD];
+    uint8_t key[16];
+    uint8_t iv[16];
+    uint8_t tag[16];
+    size_t output_length;
+    uint32_t cycles[4];
+    uint32_t start;
+
+    memset(key, 0x2B, sizeof(key));
+    memset(iv, 0x00, sizeof(iv));
+    memset(plaintext, 0xA5, sizeof(plaintext));
+
+    printf("\n\r ## AES-128 cycles/byte (platform backend : %s)", STSE_PLATFORM_AES_BACKEND_NAME);
+    for (uint8_t b = 0; b < (sizeof(backends) / sizeof(backends[0])); b++) {
+        printf("\n\r  - %s     bytes  CBC enc  CBC dec  ECB enc     CMAC", backends[b].name);
+        for (uint8_t i = 0; i < (sizeof(payload_lengths) / sizeof(payload_lengths[0])); i++) {
+            uint16_t length = payload_lengths[i];
+
+            start = cycle_counter_get();
+            output_length = sizeof(ciphertext);
+            cmox_cipher_encrypt(backends[b].cbc_enc, plaintext, length, key, sizeof(key), iv, sizeof(iv), ciphertext, &output_length);
+            cycles[0] = cycle_counter_get() - start;
+
+            start = cycle_counter_get();
+            output_length = sizeof(plaintext);
+            cmox_cipher_decrypt(backends[b].cbc_dec, ciphertext, length, key, sizeof(key), iv, sizeof(iv), plaintext, &output_length);
+            cycles[1] = cycle_counter_get() - start;
+
+            start = cycle_counter_get();
+            output_length = sizeof(ciphertext);
+            cmox_cipher_encrypt(backends[b].ecb_enc, plaintext, length, key, sizeof(key), iv, sizeof(iv), ciphertext, &output_length);
+            cycles[2] = cycle_counter_get() - start;
+
+            start = cycle_counter_get();
+            cmox_mac_compute(backends[b].cmac, plaintext, length, key, sizeof(key), NULL, 0, tag, sizeof(tag), &output_length);
+            cycles[3] = cycle_counter_get() - start;
+
+            printf("\n\r              %5u", length);
+            for (uint8_t m = 0; m < 4; m++) {
+                apps_benchmark_print_cycles_per_byte(cycles[m], length);
+            }
+        }
+    }
+    printf("\n\r");
+}
+
+#if defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_HOST_SESSION)
+void apps_crypto_benchmark_aes_pipeline(void) {
+    static uint8_t plaintext[APPS_CRYPTO_BENCHMARK_AES_MAX_PAYLOAD];
+    static uint8_t ciphertext[APPS_CRYPTO_BENCHMARK_AES_MAX_PAYLOAD];
+    static uint8_t ciphertext_pipeline[APPS_CRYPTO_BENCHMARK_AES_MAX_PAYLOAD];
+    uint8_t cipher_key[16];
+    uint8_t mac_key[16];
+    uint8_t iv[16];
+    uint8_t tag[16];
+    uint8_t tag_pipeline[16];
+    uint8_t tag_reference[16];
+    size_t tag_reference_length;
+    uint8_t tag_length = sizeof(tag);
+    uint16_t length = sizeof(ciphertext);
+    uint32_t two_pass_cycles;
+    uint32_t pipeline_cycles;
+    uint32_t decrypt_cycles;
+    uint32_t start;
+    stse_ReturnCode_t ret;
+
+    memset(cipher_key, 0x2B, sizeof(cipher_key));
+    memset(mac_key, 0x7E, sizeof(mac_key));
+    memset(plaintext, 0xA5, sizeof(plaintext));
+
+    /* - Two passes : CBC encrypt, then CMAC over the ciphertext */
+    memset(iv, 0x00, sizeof(iv));
+    start = cycle_counter_get();
+    ret = stse_platform_aes_cmac_init(mac_key, sizeof(mac_key), sizeof(tag));
+    if (ret == STSE_OK) {
+        ret = stse_platform_aes_cbc_enc(plaintext, sizeof(plaintext), iv, cipher_key, sizeof(cipher_key), ciphertext, &length);
+    }
+    if (ret == STSE_OK) {
+        ret = stse_platform_aes_cmac_append(ciphertext, length);
+    }
+    if (ret == STSE_OK) {
+        ret = stse_platform_aes_cmac_compute_finish(tag, &tag_length);
+    }
+    two_pass_cycles = cycle_counter_get() - start;
+
+    /* - Single pass pipeline */
+    memset(iv, 0x00, sizeof(iv));
+    length = sizeof(ciphertext_pipeline);
+    tag_length = sizeof(tag_pipeline);
+    start = cycle_counter_get();
+    if (ret == STSE_OK) {
+        ret = stse_platform_aes_cmac_init(mac_key, sizeof(mac_key), sizeof(tag_pipeline));
+    }
+    if (ret == STSE_OK) {
+        ret = stse_platform_aes_cbc_enc_cmac_append(plaintext, sizeof(plaintext), iv, cipher_key, sizeof(cipher_key), ciphertext_pipeline, &length);
+    }
+    if (ret == STSE_OK) {
+        ret = stse_platform_aes_cmac_compute_finish(tag_pipeline, &tag_length);
+    }
+    pipeline_cycles = cycle_counter_get() - start;
+
+    /* - Response path : verify then decrypt */
+    memset(iv, 0x00, sizeof(iv));
+    length = sizeof(plaintext);
+    start = cycle_counter_get();
+    if (ret == STSE_OK) {
+        ret = stse_platform_aes_cmac_init(mac_key, sizeof(mac_key), sizeof(tag_pipeline));
+    }
+    if (ret == STSE_OK) {
+        ret = stse_platform_aes_cmac_verify_cbc_dec(ciphertext_pipeline, sizeof(ciphertext_pipeline), iv, cipher_key, sizeof(cipher_key), tag_pipeline, plaintext, &length);
+    }
+    decrypt_cycles = cycle_counter_get() - start;
+
+    /* - Cached session tag against the one-shot CMOX CMAC (cloned handle check) */
+    if ((ret == STSE_OK) &&
+        (cmox_mac_compute(STSE_PLATFORM_AES_CMAC_ALGO, ciphertext, sizeof(ciphertext), mac_key, sizeof(mac_key), NULL, 0,
+                          tag_reference, sizeof(tag_reference), &tag_reference_length) != CMOX_MAC_SUCCESS)) {
+        ret = STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
+    }
+    stse_platform_aes_cmac_key_session_end();
+
+    printf("\n\r ## Encrypt-then-MAC pipeline (%u bytes)", APPS_CRYPTO_BENCHMARK_AES_MAX_PAYLOAD);
+    if (ret != STSE_OK) {
+        printf("\n\r  - ERROR 0x%04X\n\r", ret);
+        return;
+    }
+    printf("\n\r  - Session tag vs one-shot CMAC : %s, session known-answer check : %s",
+           (memcmp(tag, tag_reference, sizeof(tag)) == 0) ? "identical" : "MISMATCH",
+           (stse_platform_aes_cmac_check() == STSE_OK) ? "OK" : "ERROR");
+    printf("\n\r  - CBC then CMAC       : %lu cycles", (unsigned long)two_pass_cycles);
+    printf("\n\r  - Single pass         : %lu cycles, output %s",
+           (unsigned long)pipeline_cycles,
+           ((memcmp(ciphertext, ciphertext_pipeline, sizeof(ciphertext)) == 0) && (memcmp(tag, tag_pipeline, sizeof(tag)) == 0)) ? "identical" : "MISMATCH");
+    printf("\n\r  - Verify then decrypt : %lu cycles, plaintext %s",
+           (unsigned long)decrypt_cycles,
+           (plaintext[0] == 0xA5 && plaintext[sizeof(plaintext) - 1] == 0xA5) ? "restored" : "MISMATCH");
+    printf("\n\r");
+}
+#endif /* STSE_CONF_USE_HOST_KEY_ESTABLISHMENT || STSE_CONF_USE_HOST_SESSION */
+
+#if defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED) ||               \
+    defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED) || \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED) ||          \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED)
+void apps_crypto_benchmark_keywrap(void) {
+    static const uint8_t kw_iv[STSE_PLATFORM_NIST_KW_SEMIBLOCK_SIZE] = {0xA6, 0xA6, 0xA6, 0xA6, 0xA6, 0xA6, 0xA6, 0xA6};
+    static uint8_t keys[APPS_CRYPTO_BENCHMARK_KW_KEY_COUNT][32];
+    static uint8_t wrapped[APPS_CRYPTO_BENCHMARK_KW_KEY_COUNT][32 + STSE_PLATFORM_NIST_KW_SEMIBLOCK_SIZE];
+    static uint8_t unwrapped[APPS_CRYPTO_BENCHMARK_KW_KEY_COUNT][32];
+    static stse_platform_nist_kw_item_t items[APPS_CRYPTO_BENCHMARK_KW_KEY_COUNT];
+    stse_platform_nist_kw_session_t session;
+    uint8_t kek[16];
+    uint8_t reference[32 + STSE_PLATFORM_NIST_KW_SEMIBLOCK_SIZE];
+    size_t reference_length;
+    uint16_t failed_count = 0;
+    uint16_t mismatch_count = 0;
+    uint32_t bytes = 0;
+    uint32_t one_shot_cycles = 0;
+    uint32_t wrap_cycles;
+    uint32_t unwrap_cycles;
+    uint32_t start;
+    stse_ReturnCode_t ret;
+
+    /* - Provisioning workload : AES-128 and AES-256 / HMAC keys under one KEK */
+    memset(kek, 0x3C, sizeof(kek));
+    for (uint16_t i = 0; i < APPS_CRYPTO_BENCHMARK_KW_KEY_COUNT; i++) {
+        uint8_t key_length = ((i & 1U) == 0) ? 16U : 32U;
+
+        for (uint8_t j = 0; j < key_length; j++) {
+            keys[i][j] = (uint8_t)(i * 31U + j);
+        }
+        items[i].pInput = keys[i];
+        items[i].input_length = key_length;
+        items[i].pOutput = wrapped[i];
+        items[i].output_length = sizeof(wrapped[i]);
+        bytes += key_length;
+    }
+
+    /* - Reference : one shot wrap per key (KEK expanded for each key) */
+    for (uint16_t i = 0; i < APPS_CRYPTO_BENCHMARK_KW_KEY_COUNT; i++) {
+        reference_length = sizeof(reference);
+        start = cycle_counter_get();
+        cmox_cipher_encrypt(STSE_PLATFORM_AES_KEYWRAP_ENC_ALGO, keys[i], items[i].input_length, kek, sizeof(kek),
+                            kw_iv, sizeof(kw_iv), reference, &reference_length);
+        one_shot_cycles += cycle_counter_get() - start;
+    }
+
+    /* - Session : KEK expanded once, batch wrap */
+    start = cycle_counter_get();
+    ret = stse_platform_nist_kw_session_init(&session, kek, sizeof(kek));
+    if (ret == STSE_OK) {
+        ret = stse_platform_nist_kw_wrap_batch(&session, items, APPS_CRYPTO_BENCHMARK_KW_KEY_COUNT, &failed_count);
+    }
+    wrap_cycles = cycle_counter_get() - start;
+
+    /* - Round trip : batch unwrap of the wrapped keys */
+    for (uint16_t i = 0; i < APPS_CRYPTO_BENCHMARK_KW_KEY_COUNT; i++) {
+        items[i].pInput = wrapped[i];
+        items[i].input_length = items[i].output_length;
+        items[i].pOutput = unwrapped[i];
+        items[i].output_length = sizeof(unwrapped[i]);
+    }
+    start = cycle_counter_get();
+    if (ret == STSE_OK) {
+        ret = stse_platform_nist_kw_unwrap_batch(&session, items, APPS_CRYPTO_BENCHMARK_KW_KEY_COUNT, &failed_count);
+    }
+    unwrap_cycles = cycle_counter_get() - start;
+
+    printf("\n\r ## NIST key wrap (%u keys, %lu bytes, %s)", APPS_CRYPTO_BENCHMARK_KW_KEY_COUNT, (unsigned long)bytes,
+           STSE_PLATFORM_AES_BACKEND_NAME);
+    if (ret != STSE_OK) {
+        printf("\n\r  - ERROR 0x%04X (%u keys failed)\n\r", ret, failed_count);
+        stse_platform_nist_kw_session_clear(&session);
+        return;
+    }
+    for (uint16_t i = 0; i < APPS_CRYPTO_BENCHMARK_KW_KEY_COUNT; i++) {
+        if ((items[i].output_length != (items[i].input_length - STSE_PLATFORM_NIST_KW_SEMIBLOCK_SIZE)) ||
+            (memcmp(unwrapped[i], keys[i], items[i].output_length) != 0)) {
+            mismatch_count++;
+        }
+    }
+
+    /* - A corrupted wrapped key must fail the integrity check */
+    wrapped[0][0] ^= 0x01;
+    items[0].output_length = sizeof(unwrapped[0]);
+    ret = stse_platform_nist_kw_session_unwrap(&session, wrapped[0], items[0].input_length, unwrapped[0], &items[0].output_length);
+    stse_platform_nist_kw_session_clear(&session);
+
+    printf("\n\r  - One shot per key  : %lu cycles", (unsigned long)one_shot_cycles);
+    printf("\n\r  - Session batch     : %lu cycles", (unsigned long)wrap_cycles);
+    printf("\n\r  - Batch unwrap      : %lu cycles, round trip %s", (unsigned long)unwrap_cycles,
+           (mismatch_count == 0) ? "identical" : "MISMATCH");
+    printf("\n\r  - Corrupted key     : %s", (ret == STSE_PLATFORM_KEYWRAP_ERROR) ? "rejected" : "ACCEPTED");
+    printf("\n\r");
+}
+#endif /* STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED || STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED ||
+          STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED || STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED */
+
+void apps_crypto_benchmark_run(void) {
+    cycle_counter_init();
+    if ((stse_platform_crypto_init() != STSE_OK) || (stse_platform_generate_random_init() != STSE_OK)) {
+        printf("\n\r ## Crypto benchmark : platform initialization ERROR");
+        return;
+    }
+
+    apps_crypto_benchmark_ecc();
+    apps_crypto_benchmark_ecc_context();
+    apps_crypto_benchmark_ecc_verify_batch();
+    apps_crypto_benchmark_hash_stream();
+    apps_crypto_benchmark_hkdf();
+    apps_crypto_benchmark_aes();
+    apps_crypto_benchmark_scratch();
+    apps_crypto_benchmark_hot_path();
+#ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
+    apps_crypto_benchmark_frame_pool();
+#endif
+#if defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_HOST_SESSION)
+    apps_crypto_benchmark_aes_pipeline();
+#endif
+#if defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED) ||               \
+    defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED) || \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED) ||          \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED)
+    apps_crypto_benchmark_keywrap();
+#endif
+}
+
+#endif /* STSE_CONF_CRYPTO_BENCHMARK */
@@ -0,0 +1,106 @@
+/**
+ ******************************************************************************
+ * @file    apps_crypto_benchmark.h
+ * @author  CS application team
+ * @brief   Host cryptographic platform benchmark
+ ******************************************************************************
+ * @copyright 2022 STMicroelectronics
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************/
+
+#ifndef APPS_CRYPTO_BENCHMARK_H
+#define APPS_CRYPTO_BENCHMARK_H
+
+#include "stse_platform_i2c.h"
+#include "stselib.h"
+#include <stdint.h>
+
+#define APPS_CRYPTO_BENCHMARK_ITERATIONS 4U          /* Runs averaged per measurement */
+#define APPS_CRYPTO_BENCHMARK_BATCH_SIZE 8U          /* Signatures per verification batch */
+#define APPS_CRYPTO_BENCHMARK_HASH_MESSAGE_SIZE 755U /* Largest streamed message (STSAFE frame size) */
+#define APPS_CRYPTO_BENCHMARK_HASH_MAX_CHUNK 96U     /* Largest random chunk fed to the streaming hash */
+#define APPS_CRYPTO_BENCHMARK_HASH_TRIALS 16U        /* Random chunkings checked per algorithm */
+#define APPS_CRYPTO_BENCHMARK_AES_MAX_PAYLOAD 752U   /* Largest encrypted STSAFE command/response */
+#define APPS_CRYPTO_BENCHMARK_KW_KEY_COUNT 32U       /* Keys wrapped per provisioning run */
+#define APPS_CRYPTO_BENCHMARK_FRAME_SIZE 755U        /* Echo hot path frame (STSAFE frame size) */
+
+/**
+ * @brief  Run all crypto benchmarks and print the results on the terminal.
+ * @details Enabled with STSE_CONF_CRYPTO_BENCHMARK in stse_conf.h.
+ */
+void apps_crypto_benchmark_run(void);
+
+/**
+ * @brief  Benchmark ECC verify, sign, key generation and ECDH for each enabled
+ *         curve and each available ECC profile.
+ */
+void apps_crypto_benchmark_ecc(void);
+
+/**
+ * @brief  Report the ECC context setup cost removed by the context pool and
+ *         the pool usage statistics.
+ */
+void apps_crypto_benchmark_ecc_context(void);
+
+/**
+ * @brief  Compare the high-water mark wipe of the crypto scratch memory with
+ *         a memset of the whole ECC math buffer, and report the arena usage.
+ */
+void apps_crypto_benchmark_scratch(void);
+
+/**
+ * @brief  Measure the echo hot path (frame CRC16 and echoed frame compare) with
+ *         the previous flash configuration (4 wait states, no prefetch) and the
+ *         current one, and report where the CRC16 kernels execute from.
+ */
+void apps_crypto_benchmark_hot_path(void);
+
+#ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
+/**
+ * @brief  Compare the I2C frame pool block take and release with malloc/free
+ *         for each block size, and report the frame pool statistics.
+ */
+void apps_crypto_benchmark_frame_pool(void);
+#endif
+
+/**
+ * @brief  Compare batch signature verification with the one-at-a-time loop.
+ */
+void apps_crypto_benchmark_ecc_verify_batch(void);
+
+/**
+ * @brief  Check that the streaming hash API gives the one-shot digest for
+ *         random message lengths and random chunkings, for each enabled hash.
+ */
+void apps_crypto_benchmark_hash_stream(void);
+
+/**
+ * @brief  Compare HKDF-SHA256 expand with per-block HMAC key setup against the
+ *         prepared pad states, and the fused extract+expand, from 16 bytes to
+ *         255 output blocks.
+ */
+void apps_crypto_benchmark_hkdf(void);
+
+/**
+ * @brief  Report AES-128 CBC, ECB and CMAC cycles per byte for the CMOX
+ *         AESSMALL and AESFAST backends, from 16 to 752-byte payloads.
+ */
+void apps_crypto_benchmark_aes(void);
+
+/**
+ * @brief  Compare CBC encryption followed by CMAC with the single pass
+ *         encrypt-then-MAC pipeline, and run the verify-then-decrypt path.
+ */
+void apps_crypto_benchmark_aes_pipeline(void);
+
+/**
+ * @brief  Compare one shot key wraps with the KEK session batch wrap on a
+ *         provisioning workload, and check the batch unwrap round trip.
+ */
+void apps_crypto_benchmark_keywrap(void);
+
+#endif /* APPS_CRYPTO_BENCHMARK_H */
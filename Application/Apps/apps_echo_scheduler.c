@@ -0,0 +1,305 @@
+/**
+ ******************************************************************************
+ * @file    apps_echo_scheduler.c
+ * @author  CS application team
+ * @brief   Multi-device echo scheduler
+ ******************************************************************************
+ * @copyright 2022 STMicroelectronics
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "Apps/apps_echo_scheduler.h"
+#include "Drivers/cycle_counter/cycle_counter.h"
+#include "Drivers/rng/rng.h"
+#include "stse_platform_delay.h"
+#include <stdio.h>
+#include <string.h>
+
+#define APPS_ECHO_NO_DEVICE 0xFFU
+
+/* Scheduler lending its devices processing time through the delay idle hook */
+static apps_echo_scheduler_t *pActive_scheduler = NULL;
+/* Cycles consumed by nested echoes during the current outer echo */
+static uint32_t lent_cycles;
+
+/* --- Static Function Definitions --- */
+
+/**
+ * @brief  Fill a message with random content and random length (1..500).
+ * @param  pMessage: Message buffer
+ * @retval Message length
+ */
+static uint16_t apps_echo_scheduler_prepare_message(uint8_t *pMessage) {
+    uint16_t length = (uint16_t)(rng_generate_random_number() & 0x1FF);
+
+    if ((length > APPS_ECHO_MESSAGE_MAX_LENGTH) || (length == 0)) {
+        length = 1;
+    }
+    for (uint16_t i = 0; i < length; i++) {
+        pMessage[i] = (uint8_t)(rng_generate_random_number() & 0xFF);
+    }
+
+    return length;
+}
+
+/**
+ * @brief  Get the next device still pending in the current round.
+ * @param  pScheduler: Scheduler context
+ * @retval Device index, APPS_ECHO_NO_DEVICE if the round is complete
+ */
+static uint8_t apps_echo_scheduler_next_pending(apps_echo_scheduler_t *pScheduler) {
+    for (uint8_t i = 0; i < pScheduler->device_count; i++) {
+        uint8_t index = (uint8_t)((pScheduler->cursor + i) % pScheduler->device_count);
+        if (pScheduler->pending_mask & (1UL << index)) {
+            return index;
+        }
+    }
+    return APPS_ECHO_NO_DEVICE;
+}
+
+/**
+ * @brief  Perform one echo transaction on a device and update its statistics.
+ * @param  pScheduler: Scheduler context
+ * @param  index: Device index
+ */
+static void apps_echo_scheduler_echo(apps_echo_scheduler_t *pScheduler, uint8_t index) {
+    apps_echo_device_t *pDevice = &pScheduler->devices[index];
+    uint8_t slot = pScheduler->nesting;
+    uint8_t *pMessage = pScheduler->message[slot];
+    uint8_t *pEchoed_message = pScheduler->echoed_message[slot];
+    apps_echo_result_t result;
+    uint32_t start;
+
+    pScheduler->pending_mask &= ~(1UL << index);
+
+    result.length = apps_echo_scheduler_prepare_message(pMessage);
+    memset(pEchoed_message, 0, result.length);
+
+    /* - Perform echo (nested echoes may run during the target processing time) */
+    if (slot == 0) {
+        lent_cycles = 0;
+    }
+    pScheduler->nesting++;
+    start = cycle_counter_get();
+    result.status = stse_device_echo(&pDevice->handler, pMessage, pEchoed_message, result.length);
+    result.cycles = cycle_counter_get() - start;
+    pScheduler->nesting--;
+    if (slot == 0) {
+        result.cycles -= lent_cycles;
+    }
+
+    result.pMessage = pMessage;
+    result.pEchoed_message = pEchoed_message;
+    result.compare_error = (result.status == STSE_OK) && (memcmp(pMessage, pEchoed_message, result.length) != 0);
+
+    /* - Update device statistics */
+    pDevice->last_status = result.status;
+    pDevice->busy_cycles += result.cycles;
+    if (result.status != STSE_OK) {
+        pDevice->error_count++;
+        pDevice->enabled = 0;
+        pDevice->recovery_pending = pScheduler->recovery_enabled;
+    } else if (result.compare_error) {
+        pDevice->compare_error_count++;
+        pDevice->enabled = 0;
+        pDevice->recovery_pending = pScheduler->recovery_enabled;
+    } else {
+        pDevice->echo_count++;
+        pDevice->byte_count += result.length;
+    }
+
+    if (pScheduler->result_cb != NULL) {
+        pScheduler->result_cb(pDevice, &result);
+    }
+}
+
+/**
+ * @brief  Delay idle hook : run the next pending echo while the current target is processing.
+ * @note   Called from the processing delay and from the response polling loop. The bus
+ *         transfers themselves are CPU polled and are not interleaved.
+ * @param  delay_val: Requested delay in milliseconds
+ */
+static void apps_echo_scheduler_idle_hook(PLAT_UI32 delay_val) {
+    apps_echo_scheduler_t *pScheduler = pActive_scheduler;
+    uint8_t index;
+    uint32_t start;
+
+    (void)delay_val;
+
+    if ((pScheduler == NULL) || (pScheduler->nesting != 1)) {
+        return;
+    }
+
+    index = apps_echo_scheduler_next_pending(pScheduler);
+    if (index == APPS_ECHO_NO_DEVICE) {
+        return;
+    }
+
+    start = cycle_counter_get();
+    apps_echo_scheduler_echo(pScheduler, index);
+    lent_cycles += cycle_counter_get() - start;
+}
+
+/* --- Public Function Definitions --- */
+
+void apps_echo_scheduler_init(apps_echo_scheduler_t *pScheduler, apps_echo_mode_t mode, apps_echo_result_cb_t result_cb) {
+    memset(pScheduler, 0, sizeof(apps_echo_scheduler_t));
+    pScheduler->mode = mode;
+    pScheduler->result_cb = result_cb;
+}
+
+apps_echo_device_t *apps_echo_scheduler_add_device(apps_echo_scheduler_t *pScheduler, stse_device_t device_type, uint8_t busID, uint8_t devAddr) {
+    apps_echo_device_t *pDevice;
+
+    if (pScheduler->device_count >= APPS_ECHO_SCHEDULER_MAX_DEVICES) {
+        return NULL;
+    }
+
+    pDevice = &pScheduler->devices[pScheduler->device_count];
+    memset(pDevice, 0, sizeof(apps_echo_device_t));
+    if (stse_set_default_handler_value(&pDevice->handler) != STSE_OK) {
+        return NULL;
+    }
+    pDevice->handler.device_type = device_type;
+    pDevice->handler.io.busID = busID;
+    pDevice->handler.io.Devaddr = devAddr;
+    pDevice->index = pScheduler->device_count;
+    pScheduler->device_count++;
+
+    return pDevice;
+}
+
+stse_ReturnCode_t apps_echo_scheduler_start(apps_echo_scheduler_t *pScheduler) {
+    stse_ReturnCode_t ret = STSE_API_INVALID_PARAMETER;
+    uint8_t ready_count = 0;
+
+    for (uint8_t i = 0; i < pScheduler->device_count; i++) {
+        apps_echo_device_t *pDevice = &pScheduler->devices[i];
+
+        pDevice->last_status = stse_init(&pDevice->handler);
+        pDevice->enabled = (pDevice->last_status == STSE_OK);
+        if (pDevice->enabled) {
+            ready_count++;
+        } else {
+            ret = pDevice->last_status;
+        }
+    }
+
+    /* - Make sure the cycle counter runs even if no device could be initialized */
+    cycle_counter_init();
+
+    return (ready_count != 0) ? STSE_OK : ret;
+}
+
+uint8_t apps_echo_scheduler_run_round(apps_echo_scheduler_t *pScheduler) {
+    uint8_t echo_count = 0;
+    uint8_t index;
+    uint32_t start;
+
+    /* - Mark all enabled devices as pending */
+    pScheduler->pending_mask = 0;
+    for (uint8_t i = 0; i < pScheduler->device_count; i++) {
+        if (pScheduler->devices[i].enabled) {
+            pScheduler->pending_mask |= (1UL << i);
+            echo_count++;
+        }
+    }
+
+    if (pScheduler->mode == APPS_ECHO_MODE_INTERLEAVED) {
+        pActive_scheduler = pScheduler;
+        stse_platform_delay_set_idle_hook(apps_echo_scheduler_idle_hook);
+    }
+
+    start = cycle_counter_get();
+    while ((index = apps_echo_scheduler_next_pending(pScheduler)) != APPS_ECHO_NO_DEVICE) {
+        apps_echo_scheduler_echo(pScheduler, index);
+    }
+    pScheduler->round_cycles += cycle_counter_get() - start;
+
+    if (pScheduler->mode == APPS_ECHO_MODE_INTERLEAVED) {
+        stse_platform_delay_set_idle_hook(NULL);
+        pActive_scheduler = NULL;
+    }
+
+    /* - Recover failing devices once no other transaction is in flight */
+    for (uint8_t i = 0; i < pScheduler->device_count; i++) {
+        apps_echo_device_t *pDevice = &pScheduler->devices[i];
+
+        if (!pDevice->recovery_pending) {
+            continue;
+        }
+        if (pDevice->recovery_wait != 0) {
+            pDevice->recovery_wait--;
+            continue;
+        }
+
+        pDevice->last_status = apps_slot_recovery_run(&pDevice->handler, &pDevice->recovery);
+        pDevice->enabled = (pDevice->last_status == STSE_OK);
+        if (pDevice->enabled) {
+            pDevice->recovery_pending = 0;
+            pDevice->recovery_backoff = 0;
+        } else {
+            /* - Retry on an exponential back-off instead of leaving the slot disabled */
+            pDevice->recovery_backoff = (pDevice->recovery_backoff == 0) ? 1U : (uint8_t)(pDevice->recovery_backoff * 2U);
+            if (pDevice->recovery_backoff > APPS_SLOT_RECOVERY_MAX_BACKOFF_ROUNDS) {
+                pDevice->recovery_backoff = APPS_SLOT_RECOVERY_MAX_BACKOFF_ROUNDS;
+            }
+            pDevice->recovery_wait = pDevice->recovery_backoff;
+        }
+    }
+
+    /* - Rotate the first device of the next round for fairness */
+    if (pScheduler->device_count != 0) {
+        pScheduler->cursor = (uint8_t)((pScheduler->cursor + 1) % pScheduler->device_count);
+    }
+    pScheduler->round_count++;
+
+    return echo_count;
+}
+
+void apps_echo_scheduler_report(apps_echo_scheduler_t *pScheduler) {
+    uint32_t total_bytes = 0;
+
+    printf("\n\r ## Echo scheduler report (%s, %lu rounds)",
+           (pScheduler->mode == APPS_ECHO_MODE_INTERLEAVED) ? "interleaved" : "round-robin",
+           (unsigned long)pScheduler->round_count);
+
+    for (uint8_t i = 0; i < pScheduler->device_count; i++) {
+        apps_echo_device_t *pDevice = &pScheduler->devices[i];
+        uint32_t throughput = 0;
+        uint32_t average_us = 0;
+
+        if (pDevice->busy_cycles != 0) {
+            throughput = (uint32_t)(((uint64_t)pDevice->byte_count * SystemCoreClock) / pDevice->busy_cycles);
+        }
+        if (pDevice->echo_count != 0) {
+            average_us = (uint32_t)((pDevice->busy_cycles * 1000000U) / SystemCoreClock / pDevice->echo_count);
+        }
+        total_bytes += pDevice->byte_count;
+
+        printf("\n\r  - Device %u (bus %u, addr 0x%02X) %s : %lu echo, %lu error, %lu compare error, %lu bytes, %lu B/s, %lu us/echo",
+               i, pDevice->handler.io.busID, pDevice->handler.io.Devaddr,
+               pDevice->enabled ? "ON " : "OFF",
+               (unsigned long)pDevice->echo_count,
+               (unsigned long)pDevice->error_count,
+               (unsigned long)pDevice->compare_error_count,
+               (unsigned long)pDevice->byte_count,
+               (unsigned long)throughput,
+               (unsigned long)average_us);
+        if ((pDevice->recovery.recovery_count + pDevice->recovery.failure_count) != 0) {
+            printf("\n\r   ");
+            apps_slot_recovery_report(&pDevice->recovery);
+        }
+    }
+
+    if (pScheduler->round_cycles != 0) {
+        printf("\n\r  - Aggregated : %lu B/s",
+               (unsigned long)(((uint64_t)total_bytes * SystemCoreClock) / pScheduler->round_cycles));
+    }
+}
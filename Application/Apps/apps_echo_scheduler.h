@@ -0,0 +1,118 @@
+/**
+ ******************************************************************************
+ * @file    apps_echo_scheduler.h
+ * @author  CS application team
+ * @brief   Multi-device echo scheduler
+ ******************************************************************************
+ * @copyright 2022 STMicroelectronics
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************/
+
+#ifndef APPS_ECHO_SCHEDULER_H
+#define APPS_ECHO_SCHEDULER_H
+
+#include "Apps/apps_slot_recovery.h"
+#include "stselib.h"
+#include <stdint.h>
+
+#define APPS_ECHO_SCHEDULER_MAX_DEVICES 8U  /* Up to 32 (pending mask width) */
+#define APPS_ECHO_MESSAGE_MAX_LENGTH 500U
+
+/* Scheduling mode */
+typedef enum {
+    APPS_ECHO_MODE_ROUND_ROBIN = 0, /* One echo after the other */
+    APPS_ECHO_MODE_INTERLEAVED      /* Next device echo runs during current device processing time */
+} apps_echo_mode_t;
+
+/* Per-device context and statistics */
+typedef struct {
+    stse_Handler_t handler;
+    uint8_t index;
+    uint8_t enabled;
+    stse_ReturnCode_t last_status;
+    uint32_t echo_count;
+    uint32_t error_count;
+    uint32_t compare_error_count;
+    uint32_t byte_count;
+    uint64_t busy_cycles; /* Cycles spent in this device own transactions */
+    uint8_t recovery_pending;
+    uint8_t recovery_backoff; /* Rounds between recovery attempts after a failed recovery */
+    uint8_t recovery_wait;    /* Rounds left before the next recovery attempt */
+    apps_slot_recovery_stats_t recovery;
+} apps_echo_device_t;
+
+/* Result of a single echo transaction */
+typedef struct {
+    const uint8_t *pMessage;
+    const uint8_t *pEchoed_message;
+    uint16_t length;
+    stse_ReturnCode_t status;
+    uint8_t compare_error;
+    uint32_t cycles;
+} apps_echo_result_t;
+
+typedef void (*apps_echo_result_cb_t)(apps_echo_device_t *pDevice, const apps_echo_result_t *pResult);
+
+/* Scheduler context */
+typedef struct {
+    apps_echo_device_t devices[APPS_ECHO_SCHEDULER_MAX_DEVICES];
+    uint8_t device_count;
+    apps_echo_mode_t mode;
+    apps_echo_result_cb_t result_cb;
+    uint8_t recovery_enabled; /* Power-cycle failing devices at the end of the round */
+    uint32_t round_count;
+    uint64_t round_cycles; /* Wall-clock cycles spent in rounds */
+    /* - Private */
+    uint8_t cursor;
+    uint8_t nesting;
+    uint32_t pending_mask;
+    uint8_t message[2][APPS_ECHO_MESSAGE_MAX_LENGTH];
+    uint8_t echoed_message[2][APPS_ECHO_MESSAGE_MAX_LENGTH];
+} apps_echo_scheduler_t;
+
+/**
+ * @brief  Initialize the scheduler context.
+ * @param  pScheduler: Scheduler context
+ * @param  mode: Scheduling mode
+ * @param  result_cb: Optional callback invoked after each echo transaction
+ */
+void apps_echo_scheduler_init(apps_echo_scheduler_t *pScheduler, apps_echo_mode_t mode, apps_echo_result_cb_t result_cb);
+
+/**
+ * @brief  Register a target device.
+ * @param  pScheduler: Scheduler context
+ * @param  device_type: STSE device type
+ * @param  busID: Bus identifier of the device
+ * @param  devAddr: 7-bit I2C address of the device
+ * @retval Registered device context, NULL if the scheduler is full
+ */
+apps_echo_device_t *apps_echo_scheduler_add_device(apps_echo_scheduler_t *pScheduler, stse_device_t device_type, uint8_t busID, uint8_t devAddr);
+
+/**
+ * @brief  Initialize all registered devices (stse_init).
+ * @param  pScheduler: Scheduler context
+ * @retval STSE_OK if at least one device is ready, last error otherwise
+ */
+stse_ReturnCode_t apps_echo_scheduler_start(apps_echo_scheduler_t *pScheduler);
+
+/**
+ * @brief  Run one echo on every enabled device.
+ * @details Devices failing during the round are disabled, or power-cycled and
+ *          re-initialized at the end of the round when recovery is enabled. A failed
+ *          recovery is retried after 1, 2, 4 ... rounds (APPS_SLOT_RECOVERY_MAX_BACKOFF_ROUNDS).
+ * @param  pScheduler: Scheduler context
+ * @retval Number of echo transactions performed
+ */
+uint8_t apps_echo_scheduler_run_round(apps_echo_scheduler_t *pScheduler);
+
+/**
+ * @brief  Print per-device and aggregated throughput on the terminal.
+ * @param  pScheduler: Scheduler context
+ */
+void apps_echo_scheduler_report(apps_echo_scheduler_t *pScheduler);
+
+#endif /* APPS_ECHO_SCHEDULER_H */
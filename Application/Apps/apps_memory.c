@@ -0,0 +1,182 @@
+/**
+ ******************************************************************************
+ * @file    apps_memory.c
+ * @author  CS application team
+ * @brief   Stack and heap high-water-mark instrumentation
+ ******************************************************************************
+ * @copyright 2022 STMicroelectronics
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "Apps/apps_memory.h"
+#include "stm32l4xx.h"
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Symbols defined in the linker script */
+extern uint32_t _estack;
+extern uint32_t _Min_Stack_Size;
+extern uint32_t _Min_Heap_Size;
+
+/* Heap accounting of _sbrk() (sysmem.c) */
+extern void sysmem_get_sbrk_stats(uint32_t *pHeap_size, uint32_t *pHeap_limit, uint32_t *pCall_count, uint32_t *pFail_count);
+
+#define APPS_MEMORY_STACK_LIMIT ((uint32_t)&_estack - (uint32_t)&_Min_Stack_Size)
+
+static uint32_t apps_memory_stack_painted; /* Painted words at init */
+static uint32_t apps_memory_stack_free;    /* Lowest count of untouched painted words */
+static uint8_t apps_memory_stack_overflow;
+static uint32_t apps_memory_heap_peak;
+#if APPS_MEMORY_MALLOC_WRAP
+static uint32_t apps_memory_alloc_count;
+static uint32_t apps_memory_free_count;
+static uint32_t apps_memory_alloc_fail_count;
+#endif
+
+/* --- Static Function Definitions --- */
+
+/**
+ * @brief  Sample the allocated heap bytes and update the heap peak.
+ * @param  pInfo: mallinfo() output
+ */
+static void apps_memory_heap_sample(struct mallinfo *pInfo) {
+    *pInfo = mallinfo();
+    if ((uint32_t)pInfo->uordblks > apps_memory_heap_peak) {
+        apps_memory_heap_peak = (uint32_t)pInfo->uordblks;
+    }
+}
+
+#if APPS_MEMORY_MALLOC_WRAP
+void *__real_malloc(size_t size);
+void __real_free(void *ptr);
+
+/**
+ * @brief  malloc() wrapper (-Wl,--wrap=malloc) : allocation counters and heap peak.
+ * @param  size: Requested size
+ * @return Allocated block, NULL on failure
+ */
+void *__wrap_malloc(size_t size) {
+    struct mallinfo info;
+    void *ptr = __real_malloc(size);
+
+    if (ptr == NULL) {
+        apps_memory_alloc_fail_count++;
+    } else {
+        apps_memory_alloc_count++;
+        apps_memory_heap_sample(&info);
+    }
+
+    return ptr;
+}
+
+/**
+ * @brief  free() wrapper (-Wl,--wrap=free) : release counter.
+ * @param  ptr: Block to release
+ */
+void __wrap_free(void *ptr) {
+    if (ptr != NULL) {
+        apps_memory_free_count++;
+    }
+    __real_free(ptr);
+}
+#endif /* APPS_MEMORY_MALLOC_WRAP */
+
+/* --- Public Function Definitions --- */
+
+void apps_memory_init(void) {
+    volatile uint32_t *pWord = (volatile uint32_t *)APPS_MEMORY_STACK_LIMIT;
+    uint32_t sp = __get_MSP() - APPS_MEMORY_STACK_MARGIN;
+
+    /* - Paint from the bottom of the reservation up to the current frame */
+    apps_memory_stack_painted = 0;
+    while ((uint32_t)pWord < sp) {
+        *pWord++ = APPS_MEMORY_STACK_PAINT;
+        apps_memory_stack_painted++;
+    }
+    apps_memory_stack_free = apps_memory_stack_painted;
+    apps_memory_stack_overflow = 0;
+}
+
+void apps_memory_scan(void) {
+    const volatile uint32_t *pWord = (const volatile uint32_t *)APPS_MEMORY_STACK_LIMIT;
+    uint32_t free_words = 0;
+    struct mallinfo info;
+
+    if (apps_memory_stack_painted == 0) {
+        return;
+    }
+
+    /* - Untouched words only shrink : the scan stops at the previous watermark */
+    while ((free_words < apps_memory_stack_free) && (pWord[free_words] == APPS_MEMORY_STACK_PAINT)) {
+        free_words++;
+    }
+    apps_memory_stack_free = free_words;
+    if (free_words == 0) {
+        apps_memory_stack_overflow = 1;
+    }
+
+    apps_memory_heap_sample(&info);
+}
+
+void apps_memory_get_stats(apps_memory_stats_t *pStats) {
+    struct mallinfo info;
+
+    apps_memory_scan();
+    info = mallinfo();
+
+    pStats->stack_size = (uint32_t)&_Min_Stack_Size;
+    pStats->stack_peak = pStats->stack_size - (apps_memory_stack_free * sizeof(uint32_t));
+    pStats->stack_overflow = apps_memory_stack_overflow;
+    pStats->heap_size = (uint32_t)&_Min_Heap_Size;
+    sysmem_get_sbrk_stats(&pStats->heap_arena, &pStats->heap_limit, &pStats->sbrk_count, &pStats->sbrk_fail_count);
+    pStats->heap_current = (uint32_t)info.uordblks;
+    pStats->heap_peak = apps_memory_heap_peak;
+    pStats->heap_free = (uint32_t)info.fordblks;
+#if APPS_MEMORY_MALLOC_WRAP
+    pStats->alloc_count = apps_memory_alloc_count;
+    pStats->free_count = apps_memory_free_count;
+    pStats->alloc_fail_count = apps_memory_alloc_fail_count;
+#else
+    pStats->alloc_count = 0;
+    pStats->free_count = 0;
+    pStats->alloc_fail_count = 0;
+#endif
+}
+
+void apps_memory_report(void) {
+    apps_memory_stats_t stats;
+
+    apps_memory_get_stats(&stats);
+    printf("\n\r ## Memory report");
+    printf("\n\r  - Stack : %lu bytes reserved, %lu used at most (%lu%%)%s",
+           (unsigned long)stats.stack_size,
+           (unsigned long)stats.stack_peak,
+           (unsigned long)((stats.stack_peak * 100U) / stats.stack_size),
+           stats.stack_overflow ? " - OVERFLOW" : "");
+    printf("\n\r  - Heap  : %lu bytes reserved (%lu available), arena %lu bytes (%lu increments, %lu rejected)",
+           (unsigned long)stats.heap_size,
+           (unsigned long)stats.heap_limit,
+           (unsigned long)stats.heap_arena,
+           (unsigned long)stats.sbrk_count,
+           (unsigned long)stats.sbrk_fail_count);
+    /* - Free bytes left inside the arena while blocks are allocated are fragmentation */
+    printf("\n\r            %lu allocated (peak %lu), %lu free in arena (%lu%%)",
+           (unsigned long)stats.heap_current,
+           (unsigned long)stats.heap_peak,
+           (unsigned long)stats.heap_free,
+           (unsigned long)((stats.heap_arena != 0) ? ((stats.heap_free * 100U) / stats.heap_arena) : 0U));
+#if APPS_MEMORY_MALLOC_WRAP
+    printf("\n\r            %lu malloc, %lu free, %lu failed, %lu outstanding",
+           (unsigned long)stats.alloc_count,
+           (unsigned long)stats.free_count,
+           (unsigned long)stats.alloc_fail_count,
+           (unsigned long)(stats.alloc_count - stats.free_count));
+#endif
+}
@@ -0,0 +1,78 @@
+/**
+ ******************************************************************************
+ * @file    apps_memory.h
+ * @author  CS application team
+ * @brief   Stack and heap high-water-mark instrumentation
+ ******************************************************************************
+ * @copyright 2022 STMicroelectronics
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************/
+
+#ifndef APPS_MEMORY_H
+#define APPS_MEMORY_H
+
+#include <stdint.h>
+
+/* Stack painting */
+#define APPS_MEMORY_STACK_PAINT 0xA5A5A5A5U /* Pattern of the unused stack words */
+#define APPS_MEMORY_STACK_MARGIN 64U        /* Bytes left unpainted below the stack pointer at paint time */
+
+/* malloc()/free() wrappers : define together with the "-Wl,--wrap=malloc,--wrap=free" linker flags
+ * to count allocations, otherwise heap usage is only sampled from mallinfo() by apps_memory_scan() */
+#ifndef APPS_MEMORY_MALLOC_WRAP
+#define APPS_MEMORY_MALLOC_WRAP 0
+#endif
+
+/* Stack and heap statistics */
+typedef struct {
+    /* - Stack */
+    uint32_t stack_size;   /* Reserved stack (_Min_Stack_Size) */
+    uint32_t stack_peak;   /* Deepest stack usage seen by the watermark scans */
+    uint8_t stack_overflow; /* Last reserved word overwritten : the stack reached or exceeded its reservation */
+    /* - Heap arena (_sbrk) */
+    uint32_t heap_size;       /* Reserved heap (_Min_Heap_Size) */
+    uint32_t heap_limit;      /* Heap room up to the stack reservation */
+    uint32_t heap_arena;      /* Bytes handed to the heap by _sbrk() */
+    uint32_t sbrk_count;      /* Heap increments */
+    uint32_t sbrk_fail_count; /* Heap increments rejected */
+    /* - Heap allocations */
+    uint32_t heap_current; /* Bytes allocated */
+    uint32_t heap_peak;    /* Highest allocated bytes */
+    uint32_t heap_free;    /* Free bytes held in the arena */
+    uint32_t alloc_count;  /* malloc() calls (APPS_MEMORY_MALLOC_WRAP) */
+    uint32_t free_count;   /* free() calls (APPS_MEMORY_MALLOC_WRAP) */
+    uint32_t alloc_fail_count; /* malloc() calls returning NULL (APPS_MEMORY_MALLOC_WRAP) */
+} apps_memory_stats_t;
+
+/**
+ * @brief  Paint the unused part of the stack reservation.
+ * @details To be called first thing in main() : the words between the bottom of
+ *          the reservation and the current stack pointer are set to
+ *          APPS_MEMORY_STACK_PAINT.
+ */
+void apps_memory_init(void);
+
+/**
+ * @brief  Update the stack and heap high-water marks.
+ * @details The stack watermark is the lowest overwritten painted word, scanned
+ *          up from the bottom of the reservation (stops at the first used word).
+ *          To be called periodically from the main loop.
+ */
+void apps_memory_scan(void);
+
+/**
+ * @brief  Get the stack and heap statistics (scans first).
+ * @param  pStats: Statistics output
+ */
+void apps_memory_get_stats(apps_memory_stats_t *pStats);
+
+/**
+ * @brief  Print the stack and heap statistics on the terminal.
+ */
+void apps_memory_report(void);
+
+#endif /* APPS_MEMORY_H */
@@ -0,0 +1,195 @@
+/**
+ ******************************************************************************
+ * @file    apps_presence.c
+ * @author  CS application team
+ * @brief   Accessory hot-plug / presence detection service
+ ******************************************************************************
+ * @copyright 2022 STMicroelectronics
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "Apps/apps_presence.h"
+#include "Drivers/cycle_counter/cycle_counter.h"
+#include "stse_platform_i2c.h"
+#include <stdio.h>
+#include <string.h>
+
+/* --- Static Function Definitions --- */
+
+/**
+ * @brief  Schedule the next probe within the latency and bus load budgets.
+ * @param  pSlot: Presence context
+ * @param  interval_ms: Interval requested by the current state
+ * @param  duration_us: Duration of the last transaction
+ */
+static void apps_presence_schedule(apps_presence_slot_t *pSlot, uint32_t interval_ms, uint32_t duration_us) {
+    uint32_t debounce = (pSlot->state == APPS_PRESENCE_ABSENT) ? APPS_PRESENCE_ATTACH_DEBOUNCE : APPS_PRESENCE_DETACH_DEBOUNCE;
+    /* - Detection latency = first interval + confirmation probes at fast interval */
+    uint32_t ceiling = APPS_PRESENCE_MAX_DETECTION_LATENCY_MS - ((debounce - 1U) * APPS_PRESENCE_FAST_INTERVAL_MS);
+    /* - Bus load = probe duration / interval */
+    uint32_t floor = duration_us / (10U * APPS_PRESENCE_MAX_BUS_LOAD_PERCENT);
+
+    if (interval_ms > ceiling) {
+        interval_ms = ceiling;
+    }
+    if (interval_ms < floor) {
+        if (floor > ceiling) {
+            pSlot->budget_conflict_count++;
+        }
+        interval_ms = floor;
+    }
+
+    pSlot->interval_ms = interval_ms;
+    pSlot->next_probe_ms = cycle_counter_get_ms() + interval_ms;
+}
+
+/**
+ * @brief  Update the presence state machine with a transaction outcome.
+ * @param  pSlot: Presence context
+ * @param  success: Transaction succeeded
+ * @param  initialized: Device is known to be initialized (applicative traffic)
+ * @param  duration_us: Transaction duration
+ */
+static void apps_presence_update(apps_presence_slot_t *pSlot, uint8_t success, uint8_t initialized, uint32_t duration_us) {
+    uint32_t interval_ms = APPS_PRESENCE_FAST_INTERVAL_MS;
+
+    switch (pSlot->state) {
+    case APPS_PRESENCE_ABSENT:
+        if (!success) {
+            /* - Back-off while absent */
+            pSlot->success_count = 0;
+            interval_ms = pSlot->interval_ms * 2U;
+            if (interval_ms < APPS_PRESENCE_ABSENT_MIN_INTERVAL_MS) {
+                interval_ms = APPS_PRESENCE_ABSENT_MIN_INTERVAL_MS;
+            }
+            if (interval_ms > APPS_PRESENCE_ABSENT_MAX_INTERVAL_MS) {
+                interval_ms = APPS_PRESENCE_ABSENT_MAX_INTERVAL_MS;
+            }
+            break;
+        }
+        pSlot->success_count++;
+        if ((pSlot->success_count < APPS_PRESENCE_ATTACH_DEBOUNCE) && !initialized) {
+            break;
+        }
+        /* - Attach : re-initialize the device */
+        pSlot->success_count = 0;
+        if (!initialized && (stse_init(pSlot->pHandler) != STSE_OK)) {
+            interval_ms = APPS_PRESENCE_ABSENT_MIN_INTERVAL_MS;
+            break;
+        }
+        pSlot->state = APPS_PRESENCE_UNSTABLE;
+        pSlot->failure_count = 0;
+        pSlot->attach_count++;
+        if (pSlot->event_cb != NULL) {
+            pSlot->event_cb(pSlot, APPS_PRESENCE_EVENT_ATTACH);
+        }
+        break;
+
+    case APPS_PRESENCE_UNSTABLE:
+    case APPS_PRESENCE_STABLE:
+        if (success) {
+            pSlot->failure_count = 0;
+            if (pSlot->state == APPS_PRESENCE_UNSTABLE) {
+                pSlot->success_count++;
+                if (pSlot->success_count >= APPS_PRESENCE_STABLE_COUNT) {
+                    pSlot->state = APPS_PRESENCE_STABLE;
+                    if (pSlot->event_cb != NULL) {
+                        pSlot->event_cb(pSlot, APPS_PRESENCE_EVENT_STABLE);
+                    }
+                }
+            }
+            if (pSlot->state == APPS_PRESENCE_STABLE) {
+                interval_ms = APPS_PRESENCE_SLOW_INTERVAL_MS;
+            }
+            break;
+        }
+        /* - Confirm failures at fast rate before detach */
+        pSlot->state = APPS_PRESENCE_UNSTABLE;
+        pSlot->success_count = 0;
+        pSlot->failure_count++;
+        if (pSlot->failure_count >= APPS_PRESENCE_DETACH_DEBOUNCE) {
+            pSlot->state = APPS_PRESENCE_ABSENT;
+            pSlot->failure_count = 0;
+            pSlot->detach_count++;
+            interval_ms = APPS_PRESENCE_ABSENT_MIN_INTERVAL_MS;
+            if (pSlot->event_cb != NULL) {
+                pSlot->event_cb(pSlot, APPS_PRESENCE_EVENT_DETACH);
+            }
+        }
+        break;
+    }
+
+    apps_presence_schedule(pSlot, interval_ms, duration_us);
+}
+
+/* --- Public Function Definitions --- */
+
+void apps_presence_init(apps_presence_slot_t *pSlot, stse_Handler_t *pHandler, uint8_t index, uint8_t present, apps_presence_event_cb_t event_cb) {
+    memset(pSlot, 0, sizeof(apps_presence_slot_t));
+    pSlot->pHandler = pHandler;
+    pSlot->index = index;
+    pSlot->event_cb = event_cb;
+    pSlot->state = present ? APPS_PRESENCE_UNSTABLE : APPS_PRESENCE_ABSENT;
+
+    cycle_counter_init();
+    pSlot->start_ms = cycle_counter_get_ms();
+    apps_presence_schedule(pSlot, present ? APPS_PRESENCE_FAST_INTERVAL_MS : APPS_PRESENCE_ABSENT_MIN_INTERVAL_MS, 0);
+}
+
+void apps_presence_notify(apps_presence_slot_t *pSlot, stse_ReturnCode_t status, uint32_t duration_us) {
+    apps_presence_update(pSlot, (status == STSE_OK), 1, duration_us);
+}
+
+void apps_presence_process(apps_presence_slot_t *pSlot) {
+    uint8_t probe = 0x5A;
+    uint8_t echoed_probe = 0;
+    stse_ReturnCode_t ret;
+    uint32_t start;
+    uint32_t duration_us;
+
+    if ((int32_t)(cycle_counter_get_ms() - pSlot->next_probe_ms) < 0) {
+        return;
+    }
+
+    /* - Absent : address acknowledge only, present : minimal echo */
+    start = cycle_counter_get();
+    if (pSlot->state == APPS_PRESENCE_ABSENT) {
+        ret = stse_platform_i2c_probe(pSlot->pHandler->io.busID, pSlot->pHandler->io.Devaddr);
+    } else {
+        ret = stse_device_echo(pSlot->pHandler, &probe, &echoed_probe, 1);
+        if ((ret == STSE_OK) && (echoed_probe != probe)) {
+            ret = STSE_PLATFORM_BUS_ACK_ERROR;
+        }
+    }
+    duration_us = cycle_counter_to_us(cycle_counter_get() - start);
+
+    pSlot->probe_count++;
+    pSlot->busy_us += duration_us;
+
+    apps_presence_update(pSlot, (ret == STSE_OK), 0, duration_us);
+}
+
+void apps_presence_report(const apps_presence_slot_t *pSlot) {
+    static const char *state_names[] = {"absent", "present/unstable", "present/stable"};
+    uint32_t elapsed_ms = cycle_counter_get_ms() - pSlot->start_ms;
+    uint32_t load_permille = 0;
+
+    if (elapsed_ms != 0) {
+        load_permille = (uint32_t)(pSlot->busy_us / elapsed_ms);
+    }
+
+    printf(" %s, probe every %lu ms, %lu probes (bus load %lu.%lu%%), %lu attach, %lu detach, %lu budget conflicts",
+           state_names[pSlot->state],
+           (unsigned long)pSlot->interval_ms,
+           (unsigned long)pSlot->probe_count,
+           (unsigned long)(load_permille / 10U), (unsigned long)(load_permille % 10U),
+           (unsigned long)pSlot->attach_count,
+           (unsigned long)pSlot->detach_count,
+           (unsigned long)pSlot->budget_conflict_count);
+}
@@ -0,0 +1,105 @@
+/**
+ ******************************************************************************
+ * @file    apps_presence.h
+ * @author  CS application team
+ * @brief   Accessory hot-plug / presence detection service
+ ******************************************************************************
+ * @copyright 2022 STMicroelectronics
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************/
+
+#ifndef APPS_PRESENCE_H
+#define APPS_PRESENCE_H
+
+#include "stselib.h"
+#include <stdint.h>
+
+/* Probe schedule */
+#define APPS_PRESENCE_FAST_INTERVAL_MS 20U          /* Present and unstable (or attach debouncing) */
+#define APPS_PRESENCE_SLOW_INTERVAL_MS 1000U        /* Present and stable */
+#define APPS_PRESENCE_ABSENT_MIN_INTERVAL_MS 50U    /* First probe after detach */
+#define APPS_PRESENCE_ABSENT_MAX_INTERVAL_MS 2000U  /* Absent back-off ceiling */
+#define APPS_PRESENCE_ATTACH_DEBOUNCE 3U            /* Consecutive acknowledges before attach */
+#define APPS_PRESENCE_DETACH_DEBOUNCE 2U            /* Consecutive failures before detach */
+#define APPS_PRESENCE_STABLE_COUNT 10U              /* Consecutive echoes before stable */
+
+/* Budgets */
+#define APPS_PRESENCE_MAX_DETECTION_LATENCY_MS 2000U /* Worst case attach/detach detection time */
+#define APPS_PRESENCE_MAX_BUS_LOAD_PERCENT 5U        /* Maximum share of bus time used by probes */
+
+typedef enum {
+    APPS_PRESENCE_ABSENT = 0,
+    APPS_PRESENCE_UNSTABLE,
+    APPS_PRESENCE_STABLE
+} apps_presence_state_t;
+
+typedef enum {
+    APPS_PRESENCE_EVENT_ATTACH = 0,
+    APPS_PRESENCE_EVENT_DETACH,
+    APPS_PRESENCE_EVENT_STABLE /* APPS_PRESENCE_STABLE_COUNT consecutive successful echoes since the last failure */
+} apps_presence_event_t;
+
+typedef struct apps_presence_slot_t apps_presence_slot_t;
+
+typedef void (*apps_presence_event_cb_t)(apps_presence_slot_t *pSlot, apps_presence_event_t event);
+
+/* Presence detection context of one device */
+struct apps_presence_slot_t {
+    stse_Handler_t *pHandler;
+    uint8_t index;
+    apps_presence_event_cb_t event_cb;
+    apps_presence_state_t state;
+    uint8_t success_count;
+    uint8_t failure_count;
+    uint32_t interval_ms;
+    uint32_t next_probe_ms;
+    uint32_t start_ms;
+    /* - Statistics */
+    uint32_t probe_count;
+    uint32_t attach_count;
+    uint32_t detach_count;
+    uint32_t budget_conflict_count; /* Bus load floor above detection latency ceiling */
+    uint64_t busy_us;               /* Bus time spent in probes */
+};
+
+/**
+ * @brief  Initialize the presence detection context of a device.
+ * @param  pSlot: Presence context
+ * @param  pHandler: STSE handler of the device
+ * @param  index: Application index of the device
+ * @param  present: Initial state (device initialized or not)
+ * @param  event_cb: Attach/detach event callback
+ */
+void apps_presence_init(apps_presence_slot_t *pSlot, stse_Handler_t *pHandler, uint8_t index, uint8_t present, apps_presence_event_cb_t event_cb);
+
+/**
+ * @brief  Report the outcome of an applicative transaction with the device.
+ * @details Successful transactions postpone the next probe, so that an active
+ *          device is not probed on top of its regular traffic. A failure drops a
+ *          present device back to unstable : the stable event is sent again once
+ *          the device answers a streak of probes.
+ * @param  pSlot: Presence context
+ * @param  status: Transaction status
+ * @param  duration_us: Transaction duration
+ */
+void apps_presence_notify(apps_presence_slot_t *pSlot, stse_ReturnCode_t status, uint32_t duration_us);
+
+/**
+ * @brief  Probe the device if its probe is due.
+ * @details Absent devices are probed with an address acknowledge, present ones
+ *          with a 1-byte echo. stse_init() is re-run on attach.
+ * @param  pSlot: Presence context
+ */
+void apps_presence_process(apps_presence_slot_t *pSlot);
+
+/**
+ * @brief  Print presence statistics on the terminal.
+ * @param  pSlot: Presence context
+ */
+void apps_presence_report(const apps_presence_slot_t *pSlot);
+
+#endif /* APPS_PRESENCE_H */
@@ -0,0 +1,69 @@
+/**
+ ******************************************************************************
+ * @file    apps_slot_recovery.c
+ * @author  CS application team
+ * @brief   Single STSAFE slot power-cycle recovery
+ ******************************************************************************
+ * @copyright 2022 STMicroelectronics
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "Apps/apps_slot_recovery.h"
+#include "Drivers/cycle_counter/cycle_counter.h"
+#include "stse_platform_power.h"
+#include <stdio.h>
+
+/* --- Public Function Definitions --- */
+
+stse_ReturnCode_t apps_slot_recovery_run(stse_Handler_t *pHandler, apps_slot_recovery_stats_t *pStats) {
+    stse_ReturnCode_t ret;
+    uint32_t boot_us = 0;
+    uint32_t start;
+
+    cycle_counter_init();
+    start = cycle_counter_get();
+
+    /* - Power-cycle only the failing slot and poll for readiness */
+    ret = stse_platform_power_cycle(pHandler->io.busID, pHandler->io.Devaddr,
+                                    APPS_SLOT_RECOVERY_OFF_TIME_MS,
+                                    APPS_SLOT_RECOVERY_READY_TIMEOUT_MS,
+                                    &boot_us);
+
+    /* - Re-initialize the device */
+    if (ret == STSE_OK) {
+        ret = stse_init(pHandler);
+    }
+
+    pStats->last_boot_us = boot_us;
+    if (boot_us > pStats->max_boot_us) {
+        pStats->max_boot_us = boot_us;
+    }
+    pStats->last_recovery_us = cycle_counter_to_us(cycle_counter_get() - start);
+    if (pStats->last_recovery_us > pStats->max_recovery_us) {
+        pStats->max_recovery_us = pStats->last_recovery_us;
+    }
+
+    if (ret == STSE_OK) {
+        pStats->recovery_count++;
+    } else {
+        pStats->failure_count++;
+    }
+
+    return ret;
+}
+
+void apps_slot_recovery_report(const apps_slot_recovery_stats_t *pStats) {
+    printf(" recovery %lu/%lu, boot %lu us (max %lu), recovery %lu us (max %lu)",
+           (unsigned long)pStats->recovery_count,
+           (unsigned long)(pStats->recovery_count + pStats->failure_count),
+           (unsigned long)pStats->last_boot_us,
+           (unsigned long)pStats->max_boot_us,
+           (unsigned long)pStats->last_recovery_us,
+           (unsigned long)pStats->max_recovery_us);
+}
@@ -0,0 +1,49 @@
+/**
+ ******************************************************************************
+ * @file    apps_slot_recovery.h
+ * @author  CS application team
+ * @brief   Single STSAFE slot power-cycle recovery
+ ******************************************************************************
+ * @copyright 2022 STMicroelectronics
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************/
+
+#ifndef APPS_SLOT_RECOVERY_H
+#define APPS_SLOT_RECOVERY_H
+
+#include "stselib.h"
+#include <stdint.h>
+
+#define APPS_SLOT_RECOVERY_OFF_TIME_MS 2U        /* Supply discharge time */
+#define APPS_SLOT_RECOVERY_READY_TIMEOUT_MS 100U /* Maximum power-on to first ACK time */
+#define APPS_SLOT_RECOVERY_MAX_BACKOFF_ROUNDS 32U /* Failed recoveries are retried after 1, 2, 4 ... rounds up to this ceiling */
+
+/* Per-slot recovery statistics */
+typedef struct {
+    uint32_t recovery_count;   /* Successful recoveries */
+    uint32_t failure_count;    /* Failed recoveries */
+    uint32_t last_boot_us;     /* Last power-on to first ACK time */
+    uint32_t max_boot_us;      /* Worst power-on to first ACK time */
+    uint32_t last_recovery_us; /* Last full recovery time (power-cycle + stse_init) */
+    uint32_t max_recovery_us;  /* Worst full recovery time */
+} apps_slot_recovery_stats_t;
+
+/**
+ * @brief  Power-cycle the slot of a single device and re-initialize it.
+ * @param  pHandler: STSE handler of the device to recover
+ * @param  pStats: Slot recovery statistics to update
+ * @retval STSE_OK if the device is operational again, error code otherwise
+ */
+stse_ReturnCode_t apps_slot_recovery_run(stse_Handler_t *pHandler, apps_slot_recovery_stats_t *pStats);
+
+/**
+ * @brief  Print slot recovery statistics on the terminal.
+ * @param  pStats: Slot recovery statistics
+ */
+void apps_slot_recovery_report(const apps_slot_recovery_stats_t *pStats);
+
+#endif /* APPS_SLOT_RECOVERY_H */
@@ -0,0 +1,156 @@
+/**
+ ******************************************************************************
+ * @file    apps_telemetry.c
+ * @author  CS application team
+ * @brief   Binary telemetry stream (COBS framed records over USART2)
+ ******************************************************************************
+ * @copyright 2022 STMicroelectronics
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "Apps/apps_telemetry.h"
+#include "Drivers/crc16/crc16.h"
+#include "Drivers/uart/uart.h"
+
+#define APPS_TELEMETRY_HEADER_SIZE 3U
+#define APPS_TELEMETRY_CRC_SIZE 2U
+#define APPS_TELEMETRY_FRAME_SIZE (APPS_TELEMETRY_HEADER_SIZE + APPS_TELEMETRY_MAX_PAYLOAD + APPS_TELEMETRY_CRC_SIZE)
+
+static uint16_t telemetry_sequence;
+static uint8_t telemetry_text[APPS_TELEMETRY_TEXT_BUFFER_SIZE];
+static uint8_t telemetry_text_length;
+
+/* --- Static Function Definitions --- */
+
+static uint8_t *apps_telemetry_put16(uint8_t *p, uint16_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    return p + 2;
+}
+
+static uint8_t *apps_telemetry_put32(uint8_t *p, uint32_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+    return p + 4;
+}
+
+/**
+ * @brief  COBS encode a frame on the UART and terminate it with a 0x00 delimiter.
+ * @param  pFrame: Frame to encode
+ * @param  length: Frame length (< 254 : a single code block run per zero)
+ */
+static void apps_telemetry_write_cobs(const uint8_t *pFrame, uint8_t length) {
+    uint8_t run_start = 0;
+
+    for (uint8_t i = 0; i <= length; i++) {
+        /* - A zero byte (or the end of the frame) closes the current run */
+        if ((i == length) || (pFrame[i] == 0x00)) {
+            uart_putc((uint8_t)(i - run_start + 1U));
+            for (uint8_t j = run_start; j < i; j++) {
+                uart_putc(pFrame[j]);
+            }
+            run_start = (uint8_t)(i + 1U);
+        }
+    }
+    uart_putc(0x00);
+}
+
+/* --- Public Function Definitions --- */
+
+void apps_telemetry_init(void) {
+    uint8_t payload[5];
+
+    telemetry_sequence = 0;
+    telemetry_text_length = 0;
+    crc16_Init();
+
+    /* - Delimiter first so that the host resynchronizes on the boot record */
+    uart_putc(0x00);
+    payload[0] = APPS_TELEMETRY_VERSION;
+    apps_telemetry_put32(&payload[1], SystemCoreClock);
+    apps_telemetry_send(APPS_TELEMETRY_RECORD_BOOT, payload, sizeof(payload));
+}
+
+void apps_telemetry_send(uint8_t type, const uint8_t *pPayload, uint8_t length) {
+    uint8_t frame[APPS_TELEMETRY_FRAME_SIZE];
+    uint8_t *p = frame;
+
+    if (length > APPS_TELEMETRY_MAX_PAYLOAD) {
+        length = APPS_TELEMETRY_MAX_PAYLOAD;
+    }
+
+    /* - Keep console text ordered with binary records */
+    if ((type != APPS_TELEMETRY_RECORD_TEXT) && (telemetry_text_length != 0)) {
+        apps_telemetry_flush();
+    }
+
+    *p++ = type;
+    p = apps_telemetry_put16(p, telemetry_sequence++);
+    for (uint8_t i = 0; i < length; i++) {
+        *p++ = pPayload[i];
+    }
+    p = apps_telemetry_put16(p, crc16_Calculate(frame, (uint16_t)(p - frame)));
+
+    apps_telemetry_write_cobs(frame, (uint8_t)(p - frame));
+}
+
+void apps_telemetry_send_echo(const apps_telemetry_echo_t *pEcho) {
+    uint8_t payload[13];
+    uint8_t *p = payload;
+
+    *p++ = pEcho->device;
+    p = apps_telemetry_put16(p, pEcho->status);
+    p = apps_telemetry_put16(p, pEcho->length);
+    p = apps_telemetry_put16(p, pEcho->message_crc);
+    p = apps_telemetry_put16(p, pEcho->mismatch);
+    apps_telemetry_put32(p, pEcho->duration_us);
+
+    apps_telemetry_send(APPS_TELEMETRY_RECORD_ECHO, payload, sizeof(payload));
+}
+
+void apps_telemetry_send_presence(uint8_t device, uint8_t event) {
+    uint8_t payload[2] = {device, event};
+
+    apps_telemetry_send(APPS_TELEMETRY_RECORD_PRESENCE, payload, sizeof(payload));
+}
+
+void apps_telemetry_send_stats(const apps_telemetry_stats_t *pStats) {
+    uint8_t payload[26];
+    uint8_t *p = payload;
+
+    *p++ = pStats->device;
+    *p++ = pStats->enabled;
+    p = apps_telemetry_put32(p, pStats->echo_count);
+    p = apps_telemetry_put32(p, pStats->error_count);
+    p = apps_telemetry_put32(p, pStats->compare_error_count);
+    p = apps_telemetry_put32(p, pStats->byte_count);
+    p = apps_telemetry_put32(p, pStats->busy_us);
+    apps_telemetry_put32(p, pStats->recovery_count);
+
+    apps_telemetry_send(APPS_TELEMETRY_RECORD_STATS, payload, sizeof(payload));
+}
+
+void apps_telemetry_putc(uint8_t c) {
+    telemetry_text[telemetry_text_length++] = c;
+    if (telemetry_text_length == APPS_TELEMETRY_TEXT_BUFFER_SIZE) {
+        apps_telemetry_flush();
+    }
+}
+
+void apps_telemetry_flush(void) {
+    uint8_t length = telemetry_text_length;
+
+    if (length == 0) {
+        return;
+    }
+    telemetry_text_length = 0;
+    apps_telemetry_send(APPS_TELEMETRY_RECORD_TEXT, telemetry_text, length);
+}
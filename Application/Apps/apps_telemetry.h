@@ -0,0 +1,106 @@
+/**
+ ******************************************************************************
+ * @file    apps_telemetry.h
+ * @author  CS application team
+ * @brief   Binary telemetry stream (COBS framed records over USART2)
+ ******************************************************************************
+ * @copyright 2022 STMicroelectronics
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ *
+ * Frame layout (before COBS encoding, multi-byte fields little-endian) :
+ *
+ *   | type (1) | sequence (2) | payload (0..APPS_TELEMETRY_MAX_PAYLOAD) | CRC16 (2) |
+ *
+ * The CRC16 (X.25, same as the STSAFE frame CRC) covers type, sequence and
+ * payload. Each frame is COBS encoded and terminated by a 0x00 delimiter.
+ * Frames are decoded on the host by Utilities/telemetry_decoder.
+ *
+ ******************************************************************************/
+
+#ifndef APPS_TELEMETRY_H
+#define APPS_TELEMETRY_H
+
+#include <stdint.h>
+
+#define APPS_TELEMETRY_VERSION 1U
+#define APPS_TELEMETRY_MAX_PAYLOAD 64U
+#define APPS_TELEMETRY_TEXT_BUFFER_SIZE APPS_TELEMETRY_MAX_PAYLOAD
+
+/* Record types */
+#define APPS_TELEMETRY_RECORD_BOOT 0x01U     /* version (1), core clock Hz (4) */
+#define APPS_TELEMETRY_RECORD_TEXT 0x02U     /* ASCII console output */
+#define APPS_TELEMETRY_RECORD_ECHO 0x03U     /* apps_telemetry_echo_t */
+#define APPS_TELEMETRY_RECORD_PRESENCE 0x04U /* device (1), event (1) */
+#define APPS_TELEMETRY_RECORD_STATS 0x05U    /* apps_telemetry_stats_t */
+
+/* Echo transaction record */
+typedef struct {
+    uint8_t device;
+    uint16_t status;       /* stse_ReturnCode_t */
+    uint16_t length;       /* Message length */
+    uint16_t message_crc;  /* CRC16 of the message sent */
+    uint16_t mismatch;     /* Offset of first echo mismatch, 0xFFFF if none */
+    uint32_t duration_us;  /* Transaction duration */
+} apps_telemetry_echo_t;
+
+/* Device statistics record */
+typedef struct {
+    uint8_t device;
+    uint8_t enabled;
+    uint32_t echo_count;
+    uint32_t error_count;
+    uint32_t compare_error_count;
+    uint32_t byte_count;
+    uint32_t busy_us;
+    uint32_t recovery_count;
+} apps_telemetry_stats_t;
+
+/**
+ * @brief  Initialize the telemetry stream and send the boot record.
+ */
+void apps_telemetry_init(void);
+
+/**
+ * @brief  Send a raw record.
+ * @param  type: Record type
+ * @param  pPayload: Record payload
+ * @param  length: Payload length (up to APPS_TELEMETRY_MAX_PAYLOAD)
+ */
+void apps_telemetry_send(uint8_t type, const uint8_t *pPayload, uint8_t length);
+
+/**
+ * @brief  Send an echo transaction record.
+ * @param  pEcho: Echo transaction summary
+ */
+void apps_telemetry_send_echo(const apps_telemetry_echo_t *pEcho);
+
+/**
+ * @brief  Send a presence event record.
+ * @param  device: Device index
+ * @param  event: Presence event (apps_presence_event_t)
+ */
+void apps_telemetry_send_presence(uint8_t device, uint8_t event);
+
+/**
+ * @brief  Send a device statistics record.
+ * @param  pStats: Device statistics
+ */
+void apps_telemetry_send_stats(const apps_telemetry_stats_t *pStats);
+
+/**
+ * @brief  Buffer one console character into text records (stdout redirect).
+ * @param  c: Character
+ */
+void apps_telemetry_putc(uint8_t c);
+
+/**
+ * @brief  Send pending console characters as a text record.
+ */
+void apps_telemetry_flush(void);
+
+#endif /* APPS_TELEMETRY_H */
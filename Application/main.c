@@ -14,9 +14,24 @@
 
 /* Includes ------------------------------------------------------------------*/
 
+#include "Apps/apps_crypto_benchmark.h"
+#include "Apps/apps_echo_scheduler.h"
+#include "Apps/apps_memory.h"
+#include "Apps/apps_presence.h"
+#include "Apps/apps_telemetry.h"
+#include "Drivers/clock/clock.h"
+#include "Drivers/crc16/crc16.h"
+#include "Drivers/cycle_counter/cycle_counter.h"
 #include "Drivers/delay_ms/delay_ms.h"
-#include "Drivers/rng/rng.h"
+#include "Drivers/ram_arena/ram_arena.h"
 #include "Drivers/uart/uart.h"
+#include "stse_platform_aes.h"
+#include "stse_platform_ecc.h"
+#include "stse_platform_frame_pool.h"
+#include "stse_platform_hash.h"
+#include "stse_platform_i2c.h"
+#include "stse_platform_power.h"
+#include "stse_platform_profiler.h"
 #include "stselib.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -26,6 +41,60 @@
 #define PRINT_CLEAR_SCREEN "\x1B[1;1H\x1B[2J"
 #define PRINT_RESET "\x1B[0m"
 
+/* Echo scheduling configuration */
+#define APPS_ECHO_MODE APPS_ECHO_MODE_INTERLEAVED
+#define APPS_ECHO_REPORT_PERIOD 10      /* Throughput report every N rounds */
+#define APPS_ECHO_ROUND_PERIOD_MS 1000U /* Echo round period */
+
+#define APPS_ECHO_RECOVERY_ENABLED 1 /* Power-cycle and re-initialize failing slots */
+
+/* Terminal command : memory report on key press */
+#define APPS_MEMORY_REPORT_KEY 'm'
+
+/* Clock scaling : 1 = 80 MHz boost during echo rounds and crypto, low-power MSI clock when idle */
+#define APPS_CLOCK_SCALING_ENABLED 1
+
+#if APPS_CLOCK_SCALING_ENABLED
+#define APPS_CLOCK_BOOST() clock_boost_request()
+#define APPS_CLOCK_IDLE() clock_boost_release()
+#else
+#define APPS_CLOCK_BOOST()
+#define APPS_CLOCK_IDLE()
+#endif
+
+/* Console output : 1 = binary telemetry records (decode with Utilities/telemetry_decoder), 0 = plain text terminal */
+#define APPS_TELEMETRY_ENABLED 0
+
+/* Ephemeral key pairs pregenerated at boot and between echo rounds (key establishment services) */
+#if (STSE_CONF_ECC_KEY_POOL_SIZE > 0) &&                                   \
+    (defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) ||                      \
+     defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED) ||               \
+     defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED) || \
+     defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT) ||                 \
+     defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT_AUTHENTICATED) ||   \
+     defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED) ||          \
+     defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED))
+#define APPS_KEY_POOL_ENABLED
+#define APPS_KEY_POOL_KEY_TYPE STSE_ECC_KT_NIST_P_256
+#endif
+
+/* STSAFE slots under test (bus ID, 7-bit I2C address, power line) : add one entry per accessory of the rack.
+ * Bus ID 1 = I2C1 (PB8/PB9), 2 = I2C2 (PB10/PB11), 3 = I2C3 (PA7/PB4)
+ * Power line 0 = PC0, 1 = PC1, 2 = PB0, APPS_POWER_SLOT_ALL = all lines switched together */
+#define APPS_POWER_SLOT_ALL 0xFF
+static const struct {
+    uint8_t busID;
+    uint8_t devAddr;
+    uint8_t power_slot;
+} apps_echo_slots[] = {
+    {1, 0x20, APPS_POWER_SLOT_ALL},
+};
+
+#define APPS_ECHO_SLOT_COUNT (sizeof(apps_echo_slots) / sizeof(apps_echo_slots[0]))
+
+static apps_echo_scheduler_t echo_scheduler RAM_FAST_IO; /* Echo message buffers */
+static apps_presence_slot_t presence_slots[APPS_ECHO_SLOT_COUNT];
+
 /* STDIO redirect for UART output/input */
 #if defined(__GNUC__) && !defined(__ARMCC_VERSION)
 #define PUTCHAR_PROTOTYPE int __io_putchar(int ch)
@@ -36,7 +105,11 @@
 #endif /* __GNUC__ */
 
 PUTCHAR_PROTOTYPE {
+#if APPS_TELEMETRY_ENABLED
+    apps_telemetry_putc(ch);
+#else
     uart_putc(ch);
+#endif
     return ch;
 }
 
@@ -46,10 +119,18 @@ GETCHAR_PROTOTYPE {
 
 /* --- Static Function Prototypes --- */
 static void apps_terminal_init(uint32_t baudrate);
+#if !APPS_TELEMETRY_ENABLED
 static void apps_print_hex_buffer(const uint8_t *buffer, uint16_t buffer_size);
-static uint32_t apps_generate_random_number(void);
-static void apps_randomize_buffer(uint8_t *pBuffer, uint16_t buffer_length);
-static uint8_t apps_compare_buffers(const uint8_t *pBuffer1, const uint8_t *pBuffer2, uint16_t buffers_length);
+#endif
+static void apps_echo_result_callback(apps_echo_device_t *pDevice, const apps_echo_result_t *pResult);
+static void apps_presence_event_callback(apps_presence_slot_t *pSlot, apps_presence_event_t event);
+static void apps_report(void);
+#ifdef STSE_CONF_CRYPTO_PROFILER
+static void apps_profiler_report(void);
+#endif
+#if APPS_CLOCK_SCALING_ENABLED
+static void apps_clock_report(void);
+#endif
 static void apps_delay_ms(uint16_t ms);
 
 /* --- Static Function Definitions --- */
@@ -61,10 +142,14 @@ static void apps_delay_ms(uint16_t ms);
 static void apps_terminal_init(uint32_t baudrate) {
     (void)baudrate;
     uart_init(115200);
+#if APPS_TELEMETRY_ENABLED
+    apps_telemetry_init();
+#endif
     setvbuf(stdout, NULL, _IONBF, 0); /* Disable buffering for stdout */
     printf(PRINT_RESET PRINT_CLEAR_SCREEN);
 }
 
+#if !APPS_TELEMETRY_ENABLED
 /**
  * @brief  Print a buffer as hex values, 16 bytes per line.
  * @param  buffer: Pointer to buffer
@@ -78,41 +163,197 @@ static void apps_print_hex_buffer(const uint8_t *buffer, uint16_t buffer_size) {
         printf(" 0x%02X", buffer[i]);
     }
 }
+#endif
 
 /**
- * @brief  Generate a random 32-bit number using hardware RNG.
- * @retval Random 32-bit value
+ * @brief  Print the outcome of an echo transaction.
+ * @param  pDevice: Device context
+ * @param  pResult: Echo transaction result
  */
-static uint32_t apps_generate_random_number(void) {
-    return rng_generate_random_number();
+static void apps_echo_result_callback(apps_echo_device_t *pDevice, const apps_echo_result_t *pResult) {
+    /* Echo traffic doubles as presence probe (a compare error disables the device as a failure does) */
+    apps_presence_notify(&presence_slots[pDevice->index],
+                         pResult->compare_error ? STSE_PLATFORM_BUS_ACK_ERROR : pResult->status,
+                         cycle_counter_to_us(pResult->cycles));
+
+#if APPS_TELEMETRY_ENABLED
+    apps_telemetry_echo_t record;
+
+    record.device = pDevice->index;
+    record.status = (uint16_t)pResult->status;
+    record.length = pResult->length;
+    record.message_crc = crc16_Calculate((uint8_t *)pResult->pMessage, pResult->length);
+    record.mismatch = 0xFFFF;
+    if (pResult->compare_error) {
+        for (uint16_t i = 0; i < pResult->length; i++) {
+            if (pResult->pMessage[i] != pResult->pEchoed_message[i]) {
+                record.mismatch = i;
+                break;
+            }
+        }
+    }
+    record.duration_us = cycle_counter_to_us(pResult->cycles);
+    apps_telemetry_send_echo(&record);
+#else
+    /* Print message */
+    printf("\n\r ## Device %u Message :\n\r", pDevice->index);
+    apps_print_hex_buffer(pResult->pMessage, pResult->length);
+
+    if (pResult->status != STSE_OK) {
+        printf("\n\r## stse_device_echo ERROR : 0x%04X (device %u)\n\r", pResult->status, pDevice->index);
+        return;
+    }
+
+    if (pResult->compare_error) {
+        printf("\n\n \r ## ECHO MESSAGES COMPARE ERROR (%d)", pResult->length);
+        printf("\n\r\t Echoed Message :\n\r");
+        apps_print_hex_buffer(pResult->pEchoed_message, pResult->length);
+        return;
+    }
+
+    printf("\n\n \r ## Echoed Message :\n\r");
+    apps_print_hex_buffer(pResult->pEchoed_message, pResult->length);
+#endif
 }
 
 /**
- * @brief  Fill a buffer with random bytes.
- * @param  pBuffer: Pointer to buffer
- * @param  buffer_length: Number of bytes to fill
+ * @brief  Enable or disable a device in the echo loop on hot-plug events, and
+ *         re-enable a present device disabled after errors once it is stable again.
+ * @param  pSlot: Presence context of the device
+ * @param  event: Attach, detach or stable event
  */
-static void apps_randomize_buffer(uint8_t *pBuffer, uint16_t buffer_length) {
-    for (uint16_t i = 0; i < buffer_length; i++) {
-        pBuffer[i] = (uint8_t)(rng_generate_random_number() & 0xFF);
+static void apps_presence_event_callback(apps_presence_slot_t *pSlot, apps_presence_event_t event) {
+    apps_echo_device_t *pDevice = &echo_scheduler.devices[pSlot->index];
+
+    /* - Stable streak of a device still in the echo loop : nothing to do */
+    if ((event == APPS_PRESENCE_EVENT_STABLE) && pDevice->enabled) {
+        return;
     }
+
+#if APPS_TELEMETRY_ENABLED
+    apps_telemetry_send_presence(pSlot->index, (uint8_t)event);
+#else
+    static const char *event_names[] = {"ATTACHED", "DETACHED", "STABLE"};
+
+    printf("\n\r ## Device %u %s", pSlot->index, event_names[event]);
+#endif
+    /* - Attach re-ran stse_init, stable answered a streak of echo probes, detach leaves nothing to recover */
+    pDevice->enabled = (event != APPS_PRESENCE_EVENT_DETACH);
+    pDevice->recovery_pending = 0;
+    pDevice->recovery_backoff = 0;
+    pDevice->recovery_wait = 0;
 }
 
 /**
- * @brief  Compare two buffers for equality.
- * @param  pBuffer1: Pointer to first buffer
- * @param  pBuffer2: Pointer to second buffer
- * @param  buffers_length: Number of bytes to compare
- * @retval 0 if equal, 1 if different
+ * @brief  Print echo throughput and presence statistics.
  */
-static uint8_t apps_compare_buffers(const uint8_t *pBuffer1, const uint8_t *pBuffer2, uint16_t buffers_length) {
-    for (uint16_t i = 0; i < buffers_length; i++) {
-        if (pBuffer1[i] != pBuffer2[i]) {
-            return 1;
+static void apps_report(void) {
+    apps_echo_scheduler_report(&echo_scheduler);
+    printf("\n\r ## Presence report");
+    for (uint8_t i = 0; i < echo_scheduler.device_count; i++) {
+        printf("\n\r  - Device %u :", i);
+        apps_presence_report(&presence_slots[i]);
+    }
+
+#ifdef APPS_KEY_POOL_ENABLED
+    stse_platform_ecc_key_pool_stats_t key_pool_stats;
+
+    stse_platform_ecc_get_key_pool_stats(&key_pool_stats);
+    printf("\n\r ## Ephemeral key pool : %u ready, %lu pregenerated, %lu handed out, %lu generated inline",
+           stse_platform_ecc_key_pool_count(APPS_KEY_POOL_KEY_TYPE),
+           (unsigned long)key_pool_stats.generated_count,
+           (unsigned long)key_pool_stats.hit_count,
+           (unsigned long)key_pool_stats.miss_count);
+#endif
+
+#ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
+    stse_platform_frame_pool_stats_t frame_pool_stats;
+
+    stse_platform_frame_pool_get_stats(&frame_pool_stats);
+    printf("\n\r ## I2C frame pool : %u/%u/%u blocks in use (max %u/%u/%u), %lu spilled, %lu exhausted, %lu reclaimed",
+           frame_pool_stats.in_use[STSE_PLATFORM_FRAME_POOL_SMALL],
+           frame_pool_stats.in_use[STSE_PLATFORM_FRAME_POOL_MEDIUM],
+           frame_pool_stats.in_use[STSE_PLATFORM_FRAME_POOL_LARGE],
+           frame_pool_stats.max_in_use[STSE_PLATFORM_FRAME_POOL_SMALL],
+           frame_pool_stats.max_in_use[STSE_PLATFORM_FRAME_POOL_MEDIUM],
+           frame_pool_stats.max_in_use[STSE_PLATFORM_FRAME_POOL_LARGE],
+           (unsigned long)frame_pool_stats.spill_count,
+           (unsigned long)frame_pool_stats.exhausted_count,
+           (unsigned long)frame_pool_stats.reclaim_count);
+#endif
+
+#ifdef STSE_CONF_CRYPTO_PROFILER
+    apps_profiler_report();
+#endif
+
+#if APPS_CLOCK_SCALING_ENABLED
+    apps_clock_report();
+#endif
+
+    apps_memory_report();
+
+#if APPS_TELEMETRY_ENABLED
+    for (uint8_t i = 0; i < echo_scheduler.device_count; i++) {
+        apps_echo_device_t *pDevice = &echo_scheduler.devices[i];
+        apps_telemetry_stats_t stats = {
+            .device = i,
+            .enabled = pDevice->enabled,
+            .echo_count = pDevice->echo_count,
+            .error_count = pDevice->error_count,
+            .compare_error_count = pDevice->compare_error_count,
+            .byte_count = pDevice->byte_count,
+            .busy_us = (uint32_t)((pDevice->busy_cycles * 1000000U) / SystemCoreClock),
+            .recovery_count = pDevice->recovery.recovery_count,
+        };
+        apps_telemetry_send_stats(&stats);
+    }
+#endif
+}
+
+#ifdef STSE_CONF_CRYPTO_PROFILER
+/**
+ * @brief  Dump the crypto platform profiler table (entry points called at least once).
+ */
+static void apps_profiler_report(void) {
+    stse_platform_profiler_entry_t entry;
+
+    printf("\n\r ## Crypto profiler        calls      bytes   avg cycles   max cycles   total us");
+    for (uint8_t id = 0; id < STSE_PLATFORM_PROFILER_ENTRY_COUNT; id++) {
+        stse_platform_profiler_get((stse_platform_profiler_id_t)id, &entry);
+        if (entry.call_count == 0) {
+            continue;
         }
+        printf("\n\r  - %-18s %8lu %10lu %12lu %12lu %10lu",
+               stse_platform_profiler_get_name((stse_platform_profiler_id_t)id),
+               (unsigned long)entry.call_count,
+               (unsigned long)entry.byte_count,
+               (unsigned long)(entry.total_cycles / entry.call_count),
+               (unsigned long)entry.max_cycles,
+               (unsigned long)((entry.total_cycles * 1000000U) / SystemCoreClock));
+    }
+}
+#endif
+
+#if APPS_CLOCK_SCALING_ENABLED
+/**
+ * @brief  Print the clock profile switch counts and latencies.
+ */
+static void apps_clock_report(void) {
+    static const char *profile_names[CLOCK_PROFILE_COUNT] = {"nominal", "boost", "low power"};
+    clock_switch_stats_t stats;
+
+    printf("\n\r ## Clock profiles          switches   last us    max us");
+    for (uint8_t profile = 0; profile < CLOCK_PROFILE_COUNT; profile++) {
+        clock_get_switch_stats((clock_profile_t)profile, &stats);
+        printf("\n\r  - %-9s (%2lu MHz) %10lu %9lu %9lu",
+               profile_names[profile],
+               (unsigned long)(clock_get_profile_hz((clock_profile_t)profile) / 1000000U),
+               (unsigned long)stats.switch_count,
+               (unsigned long)stats.last_us,
+               (unsigned long)stats.max_us);
     }
-    return 0;
 }
+#endif
 
 /**
  * @brief  Delay for a specified number of milliseconds.
@@ -125,76 +366,133 @@ static void apps_delay_ms(uint16_t ms) {
 /* --- Main application entry point --- */
 int main(void) {
     stse_ReturnCode_t stse_ret = STSE_API_INVALID_PARAMETER;
-    stse_Handler_t stse_handler;
-    uint16_t message_length = 0;
+    uint32_t math_buffer_used;
+    uint32_t last_round_ms;
+
+    /* Paint the unused stack for the watermark scans */
+    apps_memory_init();
 
     /* Initialize Terminal */
     apps_terminal_init(115200);
 
+#if APPS_CLOCK_SCALING_ENABLED
+    /* Boot, benchmark and device initialization at the boost clock */
+    clock_init();
+#endif
+    APPS_CLOCK_BOOST();
+
     /* Print Example instruction on terminal */
     printf(PRINT_CLEAR_SCREEN);
     printf("----------------------------------------------------------------------------------------------------------------");
     printf("\n\r-                                    STSAFE-A Echo loop example                                                -");
     printf("\n\r----------------------------------------------------------------------------------------------------------------");
 
-    /* Initialize STSAFE-A1xx device handler */
-    stse_ret = stse_set_default_handler_value(&stse_handler);
+#ifdef STSE_CONF_CRYPTO_PROFILER
+    /* Start crypto profiling (benchmark calls included) */
+    stse_platform_profiler_reset();
+#endif
+
+#ifdef STSE_CONF_CRYPTO_BENCHMARK
+    /* Host crypto benchmark */
+    apps_crypto_benchmark_run();
+#endif
+
+    /* Initialize STSAFE-A1xx device handlers */
+    apps_echo_scheduler_init(&echo_scheduler, APPS_ECHO_MODE, apps_echo_result_callback);
+    echo_scheduler.recovery_enabled = APPS_ECHO_RECOVERY_ENABLED;
+    for (uint8_t i = 0; i < APPS_ECHO_SLOT_COUNT; i++) {
+        if (apps_echo_scheduler_add_device(&echo_scheduler, STSAFE_A120, apps_echo_slots[i].busID, apps_echo_slots[i].devAddr) == NULL) {
+            printf("\n\r ## apps_echo_scheduler_add_device ERROR (slot %u)\n\r", i);
+            while (1)
+                ;
+        }
+        if (apps_echo_slots[i].power_slot != APPS_POWER_SLOT_ALL) {
+            stse_platform_power_map_slot(apps_echo_slots[i].power_slot, apps_echo_slots[i].busID, apps_echo_slots[i].devAddr);
+        }
+    }
+
+    printf("\n\r - Initialize target STSAFE-A120 (%u slot(s))", echo_scheduler.device_count);
+    stse_ret = apps_echo_scheduler_start(&echo_scheduler);
+    if (stse_ret != STSE_OK) {
+        printf("\n\r ## stse_init ERROR : 0x%04X (waiting for accessory attach)\n\r", stse_ret);
+    }
+
+    /* Start presence detection (devices absent at start-up are attached on hot-plug) */
+    for (uint8_t i = 0; i < echo_scheduler.device_count; i++) {
+        apps_presence_init(&presence_slots[i], &echo_scheduler.devices[i].handler, i,
+                           echo_scheduler.devices[i].enabled, apps_presence_event_callback);
+    }
+    last_round_ms = cycle_counter_get_ms();
+
+    /* Check the ECC math buffer size against the enabled curves (CMOX reports it per operation only) */
+    stse_ret = stse_platform_ecc_check_math_buffer(&math_buffer_used);
+    if (stse_ret != STSE_OK) {
+        printf("\n\r ## ECC math buffer check ERROR : 0x%04X (%lu / %u bytes used)\n\r", stse_ret,
+               (unsigned long)math_buffer_used, STSE_PLATFORM_ECC_MATH_BUFFER_SIZE);
+    }
+
+    /* Check the cloned HMAC states of HKDF against the one-shot CMOX HMAC */
+    stse_ret = stse_platform_hmac_sha256_check();
     if (stse_ret != STSE_OK) {
-        printf("\n\r ## stse_set_default_handler_value ERROR : 0x%04X\n\r", stse_ret);
-        while (1)
-            ;
+        printf("\n\r ## HMAC-SHA256 known-answer check ERROR : 0x%04X\n\r", stse_ret);
     }
-    stse_handler.device_type = STSAFE_A120;
-    stse_handler.io.busID = 1;
 
-    printf("\n\r - Initialize target STSAFE-A120");
-    stse_ret = stse_init(&stse_handler);
+#if defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_HOST_SESSION)
+    /* Check the cloned CMAC session contexts against the one-shot CMOX CMAC */
+    stse_ret = stse_platform_aes_cmac_check();
     if (stse_ret != STSE_OK) {
-        printf("\n\r ## stse_init ERROR : 0x%04X\n\r", stse_ret);
-        while (1)
-            ;
+        printf("\n\r ## AES-CMAC known-answer check ERROR : 0x%04X\n\r", stse_ret);
     }
+#endif
+
+#ifdef APPS_KEY_POOL_ENABLED
+    /* Fill the ephemeral key pool before the first key establishment */
+    stse_platform_ecc_key_pool_fill(APPS_KEY_POOL_KEY_TYPE, STSE_CONF_ECC_KEY_POOL_SIZE);
+#endif
+    APPS_CLOCK_IDLE();
 
     while (1) {
-        /* Generate random message length (1..500) */
-        message_length = (uint16_t)(apps_generate_random_number() & 0x1FF);
-        if ((message_length > 500) || (message_length == 0)) {
-            message_length = 1;
-        }
+        /* Perform one echo on each enabled device every round period */
+        if ((cycle_counter_get_ms() - last_round_ms) >= APPS_ECHO_ROUND_PERIOD_MS) {
+            last_round_ms = cycle_counter_get_ms();
 
-        /* Create message and echo buffers (max 500 bytes) */
-        uint8_t message[500] = {0};
-        uint8_t echoed_message[500] = {0};
+            APPS_CLOCK_BOOST();
+            if (apps_echo_scheduler_run_round(&echo_scheduler) != 0) {
+                printf("\n\r\n\r*#*# STMICROELECTRONICS #*#*\n\r");
+            }
 
-        /* Fill message with random content */
-        apps_randomize_buffer(message, message_length);
+            /* - Stack and heap watermarks after the deepest call chains */
+            apps_memory_scan();
 
-        /* Print message */
-        printf("\n\r ## Message :\n\r");
-        apps_print_hex_buffer(message, message_length);
+            /* - Cycle based statistics are reported at the clock they were measured with */
+            if ((echo_scheduler.round_count % APPS_ECHO_REPORT_PERIOD) == 0) {
+                apps_report();
+            }
+            APPS_CLOCK_IDLE();
+        }
 
-        /* Perform echo operation */
-        stse_ret = stse_device_echo(&stse_handler, message, echoed_message, message_length);
-        if (stse_ret != STSE_OK) {
-            printf("\n\r## stse_device_echo ERROR : 0x%04X\n\r", stse_ret);
-            while (1)
-                ;
+        /* Probe devices on their adaptive schedule */
+        for (uint8_t i = 0; i < echo_scheduler.device_count; i++) {
+            apps_presence_process(&presence_slots[i]);
         }
 
-        /* Compare message and echoed message */
-        if (apps_compare_buffers(message, echoed_message, message_length)) {
-            printf("\n\n \r ## ECHO MESSAGES COMPARE ERROR (%d)", message_length);
-            printf("\n\r\t Echoed Message :\n\r");
-            apps_print_hex_buffer(echoed_message, message_length);
-            while (1)
-                ;
+#ifdef APPS_KEY_POOL_ENABLED
+        /* Refill consumed ephemeral keys during idle time (one key pair per iteration) */
+        if (stse_platform_ecc_key_pool_count(APPS_KEY_POOL_KEY_TYPE) < STSE_CONF_ECC_KEY_POOL_SIZE) {
+            APPS_CLOCK_BOOST();
+            stse_platform_ecc_key_pool_fill(APPS_KEY_POOL_KEY_TYPE, 1);
+            APPS_CLOCK_IDLE();
         }
-        printf("\n\n \r ## Echoed Message :\n\r");
-        apps_print_hex_buffer(echoed_message, message_length);
+#endif
 
-        printf("\n\r\n\r*#*# STMICROELECTRONICS #*#*\n\r");
+        /* Terminal commands */
+        if (uart_rx_ready() && (uart_getc() == APPS_MEMORY_REPORT_KEY)) {
+            apps_memory_report();
+        }
 
-        /* Wait for 1s */
-        apps_delay_ms(1000);
+#if APPS_TELEMETRY_ENABLED
+        apps_telemetry_flush();
+#endif
+        apps_delay_ms(1);
     }
 }
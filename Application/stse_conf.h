@@ -105,6 +105,40 @@ extern "C" {
 #define STSAFE_I2C_STATIC
 //#define STSAFE_I2C_DYNAMIC
 
+/*********************************************************
+ *                PLATFORM CRYPTO SETTINGS
+ *********************************************************/
+
+/* ECC profile : FAST = HIGHMEM curves + fast math (larger math buffer),
+ * comment for SMALL = LOWMEM curves + small math */
+#define STSE_CONF_ECC_PROFILE_FAST
+/* Link both profiles and select them per curve at runtime (stse_platform_ecc_set_profile) */
+//#define STSE_CONF_ECC_PROFILE_RUNTIME
+
+/* Number of preconstructed ECC contexts, each with its own math buffer (concurrent ECC operations) */
+#define STSE_CONF_ECC_CONTEXT_POOL_SIZE 2
+
+/* Number of pregenerated ephemeral key pairs (filled at boot / idle time, 0 to disable) */
+#define STSE_CONF_ECC_KEY_POOL_SIZE 4
+
+/* RAM budget (bytes) of the successful signature verification cache (44 bytes per entry, 0 to disable) */
+#define STSE_CONF_ECC_VERIFY_CACHE_BUDGET 704
+
+/* Crypto scratch arena size (bytes) : per operation temporaries, wiped up to their high-water mark on release */
+#define STSE_CONF_CRYPTO_SCRATCH_SIZE 512
+
+/* I2C frames in flight at the same time, one per (bus, device) pair (755-byte frame buffer each without dynamic buffer allocation) */
+#define STSE_CONF_I2C_FRAME_CONTEXT_COUNT 1
+
+/* AES backend : FAST = CMOX AESFAST (T-tables), comment for SMALL = CMOX AESSMALL (code size) */
+#define STSE_CONF_AES_BACKEND_FAST
+
+/* Crypto platform profiler : calls, bytes and DWT cycles per crypto entry point, dumped with the echo report */
+//#define STSE_CONF_CRYPTO_PROFILER
+
+/* Crypto benchmark run at start-up (cycles per operation reported on the terminal) */
+//#define STSE_CONF_CRYPTO_BENCHMARK
+
 #ifdef __cplusplus
 }
 #endif
@@ -29,6 +29,12 @@
  */
 static uint8_t *__sbrk_heap_end = NULL;
 
+/**
+ * Heap accounting : successful heap increments and rejected requests
+ */
+static uint32_t __sbrk_call_count = 0;
+static uint32_t __sbrk_fail_count = 0;
+
 /**
  * @brief _sbrk() allocates memory to the newlib heap and is used by malloc
  *        and others from the C library
@@ -68,12 +74,38 @@ void *_sbrk(ptrdiff_t incr)
   /* Protect heap from growing into the reserved MSP stack */
   if (__sbrk_heap_end + incr > max_heap)
   {
+    __sbrk_fail_count++;
     errno = ENOMEM;
     return (void *)-1;
   }
 
   prev_heap_end = __sbrk_heap_end;
   __sbrk_heap_end += incr;
+  if (incr > 0)
+  {
+    __sbrk_call_count++;
+  }
 
   return (void *)prev_heap_end;
 }
+
+/**
+ * @brief sysmem_get_sbrk_stats() reports the heap accounting of _sbrk()
+ *
+ * @param pHeap_size Bytes handed to the newlib heap
+ * @param pHeap_limit Bytes available to the heap up to the reserved MSP stack
+ * @param pCall_count Heap increments
+ * @param pFail_count Increments rejected (heap full)
+ */
+void sysmem_get_sbrk_stats(uint32_t *pHeap_size, uint32_t *pHeap_limit, uint32_t *pCall_count, uint32_t *pFail_count)
+{
+  extern uint8_t _end; /* Symbol defined in the linker script */
+  extern uint8_t _estack; /* Symbol defined in the linker script */
+  extern uint32_t _Min_Stack_Size; /* Symbol defined in the linker script */
+  const uint32_t stack_limit = (uint32_t)&_estack - (uint32_t)&_Min_Stack_Size;
+
+  *pHeap_size = (NULL == __sbrk_heap_end) ? 0 : (uint32_t)(__sbrk_heap_end - &_end);
+  *pHeap_limit = stack_limit - (uint32_t)&_end;
+  *pCall_count = __sbrk_call_count;
+  *pFail_count = __sbrk_fail_count;
+}
@@ -191,8 +191,13 @@ void SystemInit(void)
   SCB->VTOR = FLASH_BASE | VECT_TAB_OFFSET; /* Vector Table Relocation in Internal FLASH */
 #endif
 
-  /* Set system Flash Wait state to Two wait states  */
-  FLASH->ACR |= (4<<FLASH_ACR_LATENCY_Pos);
+  /* Set system Flash Wait states (3 wait states up to 64 MHz in range 1), enable ART prefetch and caches */
+  FLASH->ACR = (FLASH->ACR & ~FLASH_ACR_LATENCY_Msk) |
+               FLASH_ACR_LATENCY_3WS |
+               FLASH_ACR_PRFTEN |
+               FLASH_ACR_ICEN |
+               FLASH_ACR_DCEN;
+  while((FLASH->ACR & FLASH_ACR_LATENCY_Msk) != FLASH_ACR_LATENCY_3WS);
 
   /* Enable HSI16 */
   RCC->CR |= RCC_CR_HSION;
@@ -215,6 +220,7 @@ void SystemInit(void)
   /* - Configure MSI to 48MHz for RNG */
   RCC->CR &= ~(RCC_CR_MSION|RCC_CR_MSIRANGE);
   RCC->CR |=  (RCC_CR_MSIRANGE_11 |
+		  	   RCC_CR_MSIRGSEL |
 		  	   RCC_CR_MSION);
   RCC->CCIPR |= (3<<RCC_CCIPR_CLK48SEL_Pos);
   while(!(RCC->CR & RCC_CR_MSIRDY));
@@ -0,0 +1,195 @@
+/******************************************************************************
+ * \file	clock.c
+ * \brief   System clock profiles driver for STM32L452
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include "Drivers/clock/clock.h"
+#include "Drivers/cycle_counter/cycle_counter.h"
+#include "Drivers/delay_ms/delay_ms.h"
+#include "Drivers/delay_us/delay_us.h"
+#include "Drivers/i2c/I2C.h"
+#include "Drivers/uart/uart.h"
+
+#define CLOCK_SW_MSI (0U << RCC_CFGR_SW_Pos)
+#define CLOCK_SW_HSI (1U << RCC_CFGR_SW_Pos)
+#define CLOCK_SW_PLL (3U << RCC_CFGR_SW_Pos)
+
+typedef struct {
+    uint32_t sysclk_hz;
+    uint32_t pll_n;     /* PLL multiplier (HSI16 x N / 2), 0 = MSI system clock */
+    uint32_t msi_range; /* MSI range : system clock, or 48 MHz RNG clock with the PLL */
+    uint32_t latency;   /* Flash wait states */
+    uint32_t vos;       /* Voltage range (range 2 up to 26 MHz) */
+} clock_profile_desc_t;
+
+static const clock_profile_desc_t clock_profiles[CLOCK_PROFILE_COUNT] = {
+    [CLOCK_PROFILE_NOMINAL] = {64000000U, 8U, RCC_CR_MSIRANGE_11, FLASH_ACR_LATENCY_3WS, PWR_CR1_VOS_0},
+    [CLOCK_PROFILE_BOOST] = {80000000U, 10U, RCC_CR_MSIRANGE_11, FLASH_ACR_LATENCY_4WS, PWR_CR1_VOS_0},
+    [CLOCK_PROFILE_LOW_POWER] = {4000000U, 0U, RCC_CR_MSIRANGE_6, FLASH_ACR_LATENCY_0WS, PWR_CR1_VOS_1},
+};
+
+static clock_profile_t clock_profile = CLOCK_PROFILE_NOMINAL;
+static uint8_t clock_boost_count;
+static clock_switch_stats_t clock_stats[CLOCK_PROFILE_COUNT];
+
+static void clock_set_latency(uint32_t latency) {
+    FLASH->ACR = (FLASH->ACR & ~FLASH_ACR_LATENCY_Msk) | latency;
+    while ((FLASH->ACR & FLASH_ACR_LATENCY_Msk) != latency)
+        ;
+}
+
+static void clock_set_voltage_range(uint32_t vos) {
+    PWR->CR1 = (PWR->CR1 & ~PWR_CR1_VOS_Msk) | vos;
+    while (PWR->SR2 & PWR_SR2_VOSF)
+        ;
+}
+
+static void clock_select(uint32_t sw) {
+    RCC->CFGR = (RCC->CFGR & ~RCC_CFGR_SW_Msk) | sw;
+    while ((RCC->CFGR & RCC_CFGR_SWS_Msk) != (sw << (RCC_CFGR_SWS_Pos - RCC_CFGR_SW_Pos)))
+        ;
+}
+
+void clock_init(void) {
+    /* - Enable PWR clock (voltage scaling) */
+    RCC->APB1ENR1 |= RCC_APB1ENR1_PWREN;
+
+    clock_profile = CLOCK_PROFILE_NOMINAL;
+    clock_boost_count = 0;
+    cycle_counter_init();
+}
+
+int8_t clock_set_profile(clock_profile_t profile) {
+    const clock_profile_desc_t *pTarget;
+    uint32_t previous_hz = SystemCoreClock;
+    uint32_t primask;
+    uint32_t start;
+    uint32_t switched;
+    uint32_t latency_us;
+
+    if (profile >= CLOCK_PROFILE_COUNT) {
+        return -1;
+    }
+    if (profile == clock_profile) {
+        return 0;
+    }
+    pTarget = &clock_profiles[profile];
+
+    /* - Send the pending character at the current baudrate */
+    uart_flush();
+
+    start = cycle_counter_get();
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    /* - Voltage range and wait states raised before the clock */
+    if (pTarget->vos == PWR_CR1_VOS_0) {
+        clock_set_voltage_range(PWR_CR1_VOS_0);
+    }
+    if (pTarget->latency > (FLASH->ACR & FLASH_ACR_LATENCY_Msk)) {
+        clock_set_latency(pTarget->latency);
+    }
+
+    /* - Run from HSI16 while the PLL and the MSI are reconfigured */
+    RCC->CR |= RCC_CR_HSION;
+    while (!(RCC->CR & RCC_CR_HSIRDY))
+        ;
+    clock_select(CLOCK_SW_HSI);
+    RCC->CR &= ~(RCC_CR_PLLON);
+    while (RCC->CR & RCC_CR_PLLRDY)
+        ;
+
+    /* - MSI range (only changed when the MSI is ready) */
+    while (!(RCC->CR & RCC_CR_MSIRDY))
+        ;
+    RCC->CR = (RCC->CR & ~RCC_CR_MSIRANGE) | pTarget->msi_range | RCC_CR_MSIRGSEL;
+    while (!(RCC->CR & RCC_CR_MSIRDY))
+        ;
+
+    if (pTarget->pll_n != 0) {
+        RCC->PLLCFGR = (0 << RCC_PLLCFGR_PLLR_Pos |
+                        pTarget->pll_n << RCC_PLLCFGR_PLLN_Pos |
+                        2 << RCC_PLLCFGR_PLLSRC_Pos);
+        RCC->CR |= RCC_CR_PLLON;
+        RCC->PLLCFGR |= RCC_PLLCFGR_PLLREN;
+        while (!(RCC->CR & RCC_CR_PLLRDY))
+            ;
+        clock_select(CLOCK_SW_PLL);
+    } else {
+        clock_select(CLOCK_SW_MSI);
+        RCC->CR &= ~(RCC_CR_HSION);
+    }
+
+    /* - Time base folded at the previous frequency */
+    switched = cycle_counter_get();
+    cycle_counter_rebase();
+    SystemCoreClock = pTarget->sysclk_hz;
+
+    /* - Wait states and voltage range lowered after the clock */
+    if (pTarget->latency < (FLASH->ACR & FLASH_ACR_LATENCY_Msk)) {
+        clock_set_latency(pTarget->latency);
+    }
+    if (pTarget->vos == PWR_CR1_VOS_1) {
+        clock_set_voltage_range(PWR_CR1_VOS_1);
+    }
+    __set_PRIMASK(primask);
+
+    /* - Clock dependent peripherals */
+    uart_clock_update();
+    delay_ms_init();
+    delay_us_init();
+    i2c_init(I2C1);
+    if (RCC->APB1ENR1 & RCC_APB1ENR1_I2C2EN) {
+        i2c_init(I2C2);
+    }
+    if (RCC->APB1ENR1 & RCC_APB1ENR1_I2C3EN) {
+        i2c_init(I2C3);
+    }
+
+    clock_profile = profile;
+    latency_us = cycle_counter_to_us(cycle_counter_get() - switched) +
+                 (uint32_t)(((uint64_t)(switched - start) * 1000000U) / previous_hz);
+    clock_stats[profile].switch_count++;
+    clock_stats[profile].last_us = latency_us;
+    if (latency_us > clock_stats[profile].max_us) {
+        clock_stats[profile].max_us = latency_us;
+    }
+
+    return 0;
+}
+
+clock_profile_t clock_get_profile(void) {
+    return clock_profile;
+}
+
+uint32_t clock_get_profile_hz(clock_profile_t profile) {
+    return (profile < CLOCK_PROFILE_COUNT) ? clock_profiles[profile].sysclk_hz : 0;
+}
+
+void clock_boost_request(void) {
+    if (clock_boost_count++ == 0) {
+        clock_set_profile(CLOCK_PROFILE_BOOST);
+    }
+}
+
+void clock_boost_release(void) {
+    if ((clock_boost_count != 0) && (--clock_boost_count == 0)) {
+        clock_set_profile(CLOCK_IDLE_PROFILE);
+    }
+}
+
+void clock_get_switch_stats(clock_profile_t profile, clock_switch_stats_t *pStats) {
+    *pStats = clock_stats[profile];
+}
@@ -0,0 +1,51 @@
+/******************************************************************************
+ * \file	clock.h
+ * \brief   System clock profiles driver for STM32L452
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef CLOCK_H_
+#define CLOCK_H_
+
+#include "stm32l4xx.h"
+
+typedef enum {
+    CLOCK_PROFILE_NOMINAL = 0, /* PLL 64 MHz (SystemInit configuration) */
+    CLOCK_PROFILE_BOOST,       /* PLL 80 MHz : crypto and bus bursts */
+    CLOCK_PROFILE_LOW_POWER,   /* MSI 4 MHz, voltage range 2 : idle */
+    CLOCK_PROFILE_COUNT
+} clock_profile_t;
+
+/* Profile used when no boost is requested */
+#ifndef CLOCK_IDLE_PROFILE
+#define CLOCK_IDLE_PROFILE CLOCK_PROFILE_LOW_POWER
+#endif
+
+typedef struct {
+    uint32_t switch_count; /* Switches to the profile */
+    uint32_t last_us;      /* Latency of the last switch (peripheral reconfiguration included) */
+    uint32_t max_us;       /* Worst switch latency */
+} clock_switch_stats_t;
+
+void clock_init(void);
+/* Switch the system clock, then recompute the UART baudrate, the I2C timings and the delay prescalers */
+int8_t clock_set_profile(clock_profile_t profile);
+clock_profile_t clock_get_profile(void);
+uint32_t clock_get_profile_hz(clock_profile_t profile);
+/* Boost requests are nested : the idle profile is restored when the last one is released */
+void clock_boost_request(void);
+void clock_boost_release(void);
+void clock_get_switch_stats(clock_profile_t profile, clock_switch_stats_t *pStats);
+
+#endif /* CLOCK_H_ */
@@ -16,6 +16,7 @@
  */
 
 #include "Drivers/crc16/crc16.h"
+#include "Drivers/ram_arena/ram_arena.h"
 
 #ifdef CRC16_HW_IMP
 
@@ -27,7 +28,7 @@ void crc16_Init(void) {
     CRC->INIT = CRC_INITVALUE;
 }
 
-uint16_t crc16_Calculate(uint8_t *address, uint16_t length) {
+RAM2_FUNC uint16_t crc16_Calculate(uint8_t *address, uint16_t length) {
     volatile uint16_t i;
     volatile uint16_t *p16_crc_dr_reg = (uint16_t *)&CRC->DR;
     volatile uint8_t *p8_crc_dr_reg = (uint8_t *)&CRC->DR;
@@ -41,7 +42,7 @@ uint16_t crc16_Calculate(uint8_t *address, uint16_t length) {
     return ~(*p16_crc_dr_reg);
 }
 
-uint16_t crc16_Accumulate(uint8_t *address, uint16_t length) {
+RAM2_FUNC uint16_t crc16_Accumulate(uint8_t *address, uint16_t length) {
     uint16_t i;
     uint16_t *p16_crc_dr_reg = (uint16_t *)&CRC->DR;
     uint8_t *p8_crc_dr_reg = (uint8_t *)&CRC->DR;
@@ -54,10 +55,24 @@ uint16_t crc16_Accumulate(uint8_t *address, uint16_t length) {
     return ~(*p16_crc_dr_reg);
 }
 
+uint16_t crc16_Calculate_flash(uint8_t *address, uint16_t length) {
+    volatile uint16_t i;
+    volatile uint16_t *p16_crc_dr_reg = (uint16_t *)&CRC->DR;
+    volatile uint8_t *p8_crc_dr_reg = (uint8_t *)&CRC->DR;
+
+    CRC->CR |= CRC_CR_RESET;
+    for (i = 0; i < length; i++) {
+        *p8_crc_dr_reg = (uint8_t)*address;
+        address++;
+    }
+
+    return ~(*p16_crc_dr_reg);
+}
+
 #else
 
 /* ---------------------- SW CRC16 Implementation --------------------- */
-static uint16_t crc16_tab[] = {
+static uint16_t crc16_tab[] RAM2_TABLE = {
     0x0000, 0x1189, 0x2312, 0x329b, 0x4624, 0x57ad, 0x6536, 0x74bf,
     0x8c48, 0x9dc1, 0xaf5a, 0xbed3, 0xca6c, 0xdbe5, 0xe97e, 0xf8f7,
     0x1081, 0x0108, 0x3393, 0x221a, 0x56a5, 0x472c, 0x75b7, 0x643e,
@@ -97,7 +112,7 @@ void crc16_Init(void) {
     //__NOP();
 }
 
-uint16_t crc16_Calculate(uint8_t *address, uint16_t length) {
+RAM2_FUNC uint16_t crc16_Calculate(uint8_t *address, uint16_t length) {
     uint16_t i = 0;
     crc16_val = 0xffff;
 
@@ -108,7 +123,7 @@ uint16_t crc16_Calculate(uint8_t *address, uint16_t length) {
     return ~crc16_val;
 }
 
-uint16_t crc16_Accumulate(uint8_t *address, uint16_t length) {
+RAM2_FUNC uint16_t crc16_Accumulate(uint8_t *address, uint16_t length) {
     uint16_t i = 0;
 
     for (i = 0; i < length; i++) {
@@ -118,4 +133,15 @@ uint16_t crc16_Accumulate(uint8_t *address, uint16_t length) {
     return ~crc16_val;
 }
 
+uint16_t crc16_Calculate_flash(uint8_t *address, uint16_t length) {
+    uint16_t i = 0;
+    crc16_val = 0xffff;
+
+    for (i = 0; i < length; i++) {
+        crc16_val = ((crc16_val >> 8) ^ crc16_tab[(crc16_val ^ address[i]) & 0x00ff]);
+    }
+
+    return ~crc16_val;
+}
+
 #endif
@@ -31,4 +31,8 @@ void crc16_Init(void);
 uint16_t crc16_Calculate(uint8_t *address, uint16_t length);
 uint16_t crc16_Accumulate(uint8_t *address, uint16_t length);
 
+/* Flash-resident copy of crc16_Calculate() (never placed in .ramfunc) : reference of the
+ * hot path benchmark, removed by the linker when unused */
+uint16_t crc16_Calculate_flash(uint8_t *address, uint16_t length);
+
 #endif /* CRC16_H_ */
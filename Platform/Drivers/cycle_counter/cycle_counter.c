@@ -0,0 +1,71 @@
+/******************************************************************************
+ * \file	cycle_counter.c
+ * \brief   DWT cycle counter driver for STM32L452
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include "Drivers/cycle_counter/cycle_counter.h"
+
+static uint32_t cycle_counter_last;
+static uint32_t cycle_counter_wraps;
+static uint64_t cycle_counter_base_cycles; /* Cycles folded into the microsecond time base */
+static uint64_t cycle_counter_base_us;
+
+void cycle_counter_init(void) {
+    /* - Enable trace unit (required by DWT) */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+
+    /* - Reset and start the cycle counter (only once, running measurements are kept) */
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0) {
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+}
+
+uint32_t cycle_counter_get(void) {
+    return DWT->CYCCNT;
+}
+
+uint64_t cycle_counter_get64(void) {
+    uint32_t cycles = DWT->CYCCNT;
+
+    /* - Count counter wraps since last call */
+    if (cycles < cycle_counter_last) {
+        cycle_counter_wraps++;
+    }
+    cycle_counter_last = cycles;
+
+    return ((uint64_t)cycle_counter_wraps << 32) | cycles;
+}
+
+void cycle_counter_rebase(void) {
+    uint64_t elapsed_us = ((cycle_counter_get64() - cycle_counter_base_cycles) * 1000000U) / SystemCoreClock;
+
+    /* - Fold the elapsed cycles at the current frequency, sub-microsecond remainder carried */
+    cycle_counter_base_us += elapsed_us;
+    cycle_counter_base_cycles += (elapsed_us * SystemCoreClock) / 1000000U;
+}
+
+uint32_t cycle_counter_get_ms(void) {
+    cycle_counter_rebase();
+    return (uint32_t)(cycle_counter_base_us / 1000U);
+}
+
+uint32_t cycle_counter_to_us(uint32_t cycles) {
+    return (uint32_t)(((uint64_t)cycles * 1000000U) / SystemCoreClock);
+}
+
+uint32_t cycle_counter_to_ms(uint32_t cycles) {
+    return (uint32_t)(((uint64_t)cycles * 1000U) / SystemCoreClock);
+}
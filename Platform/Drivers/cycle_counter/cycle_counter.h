@@ -0,0 +1,34 @@
+/******************************************************************************
+ * \file	cycle_counter.h
+ * \brief   DWT cycle counter driver for STM32L452
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef CYCLE_COUNTER_H_
+#define CYCLE_COUNTER_H_
+
+#include "stm32l4xx.h"
+
+void cycle_counter_init(void);
+uint32_t cycle_counter_get(void);
+/* Extended counter : shall be called at least once per counter wrap (2^32 cycles) */
+uint64_t cycle_counter_get64(void);
+/* Milliseconds time base, kept across SystemCoreClock changes */
+uint32_t cycle_counter_get_ms(void);
+/* Fold the elapsed cycles into the time base : shall be called before each SystemCoreClock change */
+void cycle_counter_rebase(void);
+uint32_t cycle_counter_to_us(uint32_t cycles);
+uint32_t cycle_counter_to_ms(uint32_t cycles);
+
+#endif /* CYCLE_COUNTER_H_ */
@@ -18,6 +18,7 @@
 #include "Drivers/delay_ms/delay_ms.h"
 
 volatile uint16_t delay_ms_timer_prescaler;
+static uint8_t delay_ms_tick_shift; /* Timer ticks per millisecond = 2^shift */
 
 void delay_ms_init(void) {
     /* - Disable TIM6 */
@@ -25,11 +26,23 @@ void delay_ms_init(void) {
 
     TIM6->CR1 |= (TIM_CR1_OPM);
 
-    /* - Configure TIM6 prescaler */
-    delay_ms_timer_prescaler = SystemCoreClock / 1000;
+    /* - Configure TIM6 prescaler (1 kHz tick, 2^n kHz above 65.5 MHz : 16-bit prescaler) */
+    delay_ms_tick_shift = 0;
+    while ((SystemCoreClock / (1000U << delay_ms_tick_shift)) > 0x10000U) {
+        delay_ms_tick_shift++;
+    }
+    delay_ms_timer_prescaler = (SystemCoreClock / (1000U << delay_ms_tick_shift)) - 1;
 }
 
 void delay_ms(uint16_t ms) {
+    uint16_t max_ms = 0xFFFFU >> delay_ms_tick_shift;
+
+    /* - Delays beyond the 16-bit reload value in chunks */
+    while (ms > max_ms) {
+        delay_ms(max_ms);
+        ms -= max_ms;
+    }
+
     /* - Disable TIM6 */
     TIM6->CR1 &= ~(TIM_CR1_CEN);
 
@@ -45,7 +58,7 @@ void delay_ms(uint16_t ms) {
     TIM6->CNT = 0x0000;
 
     /* - Set reload value */
-    TIM6->ARR = ms;
+    TIM6->ARR = (uint16_t)(ms << delay_ms_tick_shift);
 
     /* - Enable TIM6 */
     TIM6->CR1 |= TIM_CR1_CEN;
@@ -77,7 +90,7 @@ void timeout_ms_start(uint16_t ms) {
     TIM6->CNT = 0x0000;
 
     /* - Set reload value */
-    TIM6->ARR = ms;
+    TIM6->ARR = (ms > (0xFFFFU >> delay_ms_tick_shift)) ? 0xFFFFU : (uint16_t)(ms << delay_ms_tick_shift);
 
     /* - Enable TIM6 */
     TIM6->CR1 |= TIM_CR1_CEN;
@@ -25,7 +25,7 @@ void delay_us_init(void) {
     TIM6->CR1 |= (TIM_CR1_OPM);
 
     /* - Configure TIM6 prescaler */
-    delay_us_timer_prescaler = SystemCoreClock / 1000000;
+    delay_us_timer_prescaler = (SystemCoreClock / 1000000) - 1;
 }
 
 void delay_us(uint16_t us) {
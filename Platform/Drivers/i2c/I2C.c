@@ -17,14 +17,130 @@
 
 #include "Drivers/i2c/i2c.h"
 #include "Drivers/delay_ms/delay_ms.h"
+#include "Drivers/ram_arena/ram_arena.h"
 
 static uint16_t i2c_speed = 100;
+static uint32_t i2c_timing_clock; /* I2C kernel clock and speed of the cached TIMINGR */
+static uint16_t i2c_timing_speed;
+static uint32_t i2c_timingr;
+
+/* I2C specification limits in ns (tLOW min, tHIGH min, tSU;DAT min), board rise time budget and SCL low share */
+typedef struct {
+    uint16_t low_min;
+    uint16_t high_min;
+    uint16_t su_dat_min;
+    uint16_t rise;
+    uint8_t low_percent;
+} i2c_timing_spec_t;
+
+static const i2c_timing_spec_t i2c_standard_mode = {4700, 4000, 250, 300, 53};
+static const i2c_timing_spec_t i2c_fast_mode = {1300, 600, 100, 300, 60};
+
+#define I2C_SYNC_CYCLES 6U /* SCL synchronization, kernel clock cycles (filters disabled) */
+#define I2C_PROBE_TIMEOUT_MS 2U /* Address-only frame budget (~100 us at 100 kHz), bus held low beyond */
+#define I2C_XFER_TIMEOUT_MS 2U  /* Per byte (or start) flag budget (~90 us at 100 kHz), bus held low beyond */
+
+/**
+ * \brief  Wait for an ISR flag during a transfer
+ * \details Polling loop iterations take more than one core cycle : the bound is an upper limit.
+ *          On timeout the peripheral is disabled, the next transfer re-initializes it.
+ * \return 0 = flag set, -1 = not acknowledged, -2 = bus stuck
+ */
+static RAM2_FUNC int8_t i2c_wait_flag(I2C_TypeDef *pI2C, uint32_t flag) {
+    uint32_t timeout = (SystemCoreClock / 1000U) * I2C_XFER_TIMEOUT_MS;
+
+    while (!(pI2C->ISR & flag)) {
+        if (pI2C->ISR & I2C_ISR_NACKF) {
+            return -1;
+        }
+        if (timeout-- == 0) {
+            pI2C->CR1 &= ~(I2C_CR1_PE);
+            return -2;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief  Compute TIMINGR for a kernel clock and a bus speed
+ * \details Below about 9 MHz the fast mode limits cannot be met at 400 kHz : the SCL
+ *          low and high times are then kept at their minimum and the bus runs slower.
+ */
+static uint32_t i2c_timing_compute(uint32_t clock_hz, uint16_t speed_khz) {
+    const i2c_timing_spec_t *pSpec = (speed_khz >= 400) ? &i2c_fast_mode : &i2c_standard_mode;
+    uint32_t period_ps = 1000000000U / speed_khz;
+    uint32_t sync_ps = (uint32_t)(((uint64_t)I2C_SYNC_CYCLES * 1000000000000ULL) / clock_hz);
+    uint32_t scl_ps = (period_ps > sync_ps) ? (period_ps - sync_ps) : 0;
+    uint32_t presc, low, high, scldel;
+
+    for (presc = 0; presc < 16; presc++) {
+        uint32_t tick_ps = (uint32_t)(((uint64_t)(presc + 1) * 1000000000000ULL) / clock_hz);
+        uint32_t low_ps = (scl_ps / 100U) * pSpec->low_percent;
+        uint32_t high_ps;
+
+        if (low_ps < (pSpec->low_min * 1000U)) {
+            low_ps = pSpec->low_min * 1000U;
+        }
+        low = (low_ps + tick_ps - 1) / tick_ps;
+        high_ps = (scl_ps > (low * tick_ps)) ? (scl_ps - (low * tick_ps)) : 0;
+        if (high_ps < (pSpec->high_min * 1000U)) {
+            high_ps = pSpec->high_min * 1000U;
+        }
+        high = (high_ps + tick_ps - 1) / tick_ps;
+        scldel = (((pSpec->rise + pSpec->su_dat_min) * 1000U) + tick_ps - 1) / tick_ps;
+        if (scldel == 0) {
+            scldel = 1;
+        }
+        if ((low <= 256) && (high <= 256) && (scldel <= 16)) {
+            break;
+        }
+    }
+    if (presc == 16) {
+        presc = 15;
+        low = (low > 256) ? 256 : low;
+        high = (high > 256) ? 256 : high;
+        scldel = (scldel > 16) ? 16 : scldel;
+    }
+
+    return (presc << I2C_TIMINGR_PRESC_Pos) |
+           ((low - 1) << I2C_TIMINGR_SCLL_Pos) |
+           ((high - 1) << I2C_TIMINGR_SCLH_Pos) |
+           (0x01 << I2C_TIMINGR_SDADEL_Pos) |
+           ((scldel - 1) << I2C_TIMINGR_SCLDEL_Pos);
+}
 
 void i2c_deinit(I2C_TypeDef *pI2C) {
     // Do nothing
     (void)pI2C;
 }
 
+void i2c_io_init(I2C_TypeDef *pI2C) {
+    if (pI2C == I2C2) {
+        /* - System clock as kernel clock */
+        RCC->CCIPR = (RCC->CCIPR & ~RCC_CCIPR_I2C2SEL_Msk) | (1 << RCC_CCIPR_I2C2SEL_Pos);
+        RCC->APB1ENR1 |= RCC_APB1ENR1_I2C2EN;
+
+        /* - PB10-SCL, PB11-SDA : AF4, open drain */
+        GPIOB->AFR[1] = (GPIOB->AFR[1] & ~(GPIO_AFRH_AFSEL10_Msk | GPIO_AFRH_AFSEL11_Msk)) |
+                        (0x4 << GPIO_AFRH_AFSEL10_Pos | 0x4 << GPIO_AFRH_AFSEL11_Pos);
+        GPIOB->OTYPER |= (GPIO_OTYPER_OT10 | GPIO_OTYPER_OT11);
+        GPIOB->MODER = (GPIOB->MODER & ~(GPIO_MODER_MODE10_Msk | GPIO_MODER_MODE11_Msk)) |
+                       (GPIO_MODER_MODE10_1 | GPIO_MODER_MODE11_1);
+    } else if (pI2C == I2C3) {
+        /* - System clock as kernel clock */
+        RCC->CCIPR = (RCC->CCIPR & ~RCC_CCIPR_I2C3SEL_Msk) | (1 << RCC_CCIPR_I2C3SEL_Pos);
+        RCC->APB1ENR1 |= RCC_APB1ENR1_I2C3EN;
+
+        /* - PA7-SCL, PB4-SDA : AF4, open drain (PC0/PC1 are used as power lines) */
+        GPIOA->AFR[0] = (GPIOA->AFR[0] & ~GPIO_AFRL_AFSEL7_Msk) | (0x4 << GPIO_AFRL_AFSEL7_Pos);
+        GPIOA->OTYPER |= GPIO_OTYPER_OT7;
+        GPIOA->MODER = (GPIOA->MODER & ~GPIO_MODER_MODE7_Msk) | GPIO_MODER_MODE7_1;
+        GPIOB->AFR[0] = (GPIOB->AFR[0] & ~GPIO_AFRL_AFSEL4_Msk) | (0x4 << GPIO_AFRL_AFSEL4_Pos);
+        GPIOB->OTYPER |= GPIO_OTYPER_OT4;
+        GPIOB->MODER = (GPIOB->MODER & ~GPIO_MODER_MODE4_Msk) | GPIO_MODER_MODE4_1;
+    }
+}
+
 uint8_t i2c_init(I2C_TypeDef *pI2C) {
     /* - Clear PE bit */
     pI2C->CR1 &= ~(I2C_CR1_PE);
@@ -34,21 +150,13 @@ uint8_t i2c_init(I2C_TypeDef *pI2C) {
                  (0x0 << I2C_CR1_DNF_Pos) |      // Digital Noise Filtering disabled
                  (0b1 << I2C_CR1_NOSTRETCH_Pos); // Clock stretching disabled
 
-    if (i2c_speed == 400) {
-        /* - Set I2C1 Timings for 400kHz (Fast mode) */
-        pI2C->TIMINGR = (0x01 << I2C_TIMINGR_PRESC_Pos) |
-                        (0x26 << I2C_TIMINGR_SCLL_Pos) |
-                        (0x1D << I2C_TIMINGR_SCLH_Pos) |
-                        (0x01 << I2C_TIMINGR_SDADEL_Pos) |
-                        (0x0A << I2C_TIMINGR_SCLDEL_Pos);
-    } else {
-        /* - Set I2C1 Timings for 100kHz (Standard mode) */
-        pI2C->TIMINGR = (0x03 << I2C_TIMINGR_PRESC_Pos) |
-                        (0x50 << I2C_TIMINGR_SCLL_Pos) |
-                        (0x47 << I2C_TIMINGR_SCLH_Pos) |
-                        (0x01 << I2C_TIMINGR_SDADEL_Pos) |
-                        (0x09 << I2C_TIMINGR_SCLDEL_Pos);
+    /* - Set I2C Timings for 400kHz (Fast mode) or 100kHz (Standard mode), recomputed on kernel clock change */
+    if ((i2c_timing_clock != SystemCoreClock) || (i2c_timing_speed != i2c_speed)) {
+        i2c_timingr = i2c_timing_compute(SystemCoreClock, (i2c_speed == 400) ? 400 : 100);
+        i2c_timing_clock = SystemCoreClock;
+        i2c_timing_speed = i2c_speed;
     }
+    pI2C->TIMINGR = i2c_timingr;
 
     /* - Enable pI2C */
     pI2C->CR1 |= I2C_CR1_PE;
@@ -56,12 +164,14 @@ uint8_t i2c_init(I2C_TypeDef *pI2C) {
     return 0;
 }
 
-int8_t i2c_write(I2C_TypeDef *pI2C, uint8_t slave_address, uint16_t speed, uint8_t *pbuffer, uint16_t size) {
+RAM2_FUNC int8_t i2c_write(I2C_TypeDef *pI2C, uint8_t slave_address, uint16_t speed, uint8_t *pbuffer, uint16_t size) {
     uint16_t i = 0;
     uint16_t offset = 0;
 
     uint16_t xfer_length = size;
     uint8_t xfer_size;
+    uint32_t timeout = (SystemCoreClock / 1000U) * I2C_XFER_TIMEOUT_MS;
+    int8_t ret;
 
     i2c_speed = speed;
     i2c_init(pI2C);
@@ -93,24 +203,28 @@ int8_t i2c_write(I2C_TypeDef *pI2C, uint8_t slave_address, uint16_t speed, uint8
         if (xfer_length > 0xFF) {
             pI2C->CR2 |= I2C_CR2_RELOAD;
         }
+        if (timeout-- == 0) {
+            pI2C->CR1 &= ~(I2C_CR1_PE);
+            return -2;
+        }
     }
 
     while (xfer_length > 0) {
         /* - Send data */
         for (i = 0; i < xfer_size; i++) {
-            /* - Wait for previous data to be sent */
-            while ((pI2C->ISR & I2C_ISR_TXE) != 1) {
-                /* - Return error in case of NACK */
-                if (pI2C->ISR & I2C_ISR_NACKF) {
-                    return -1;
-                }
+            /* - Wait for previous data to be sent (error in case of NACK or stuck bus) */
+            ret = i2c_wait_flag(pI2C, I2C_ISR_TXE);
+            if (ret != 0) {
+                return ret;
             }
             pI2C->TXDR = (uint8_t)*(pbuffer + (i + offset));
         }
         xfer_length = (xfer_length - xfer_size);
         if (xfer_length > 0) {
-            while (!(pI2C->ISR & I2C_ISR_TCR))
-                ;
+            ret = i2c_wait_flag(pI2C, I2C_ISR_TCR);
+            if (ret != 0) {
+                return ret;
+            }
             if (xfer_length > 0xFF) {
                 offset += 0xFF;
                 xfer_size = 0xFF;
@@ -129,13 +243,20 @@ int8_t i2c_write(I2C_TypeDef *pI2C, uint8_t slave_address, uint16_t speed, uint8
     return 0;
 }
 
-int8_t i2c_read(I2C_TypeDef *pI2C, uint8_t slave_address, uint16_t speed, uint8_t *pbuffer, uint16_t size) {
+RAM2_FUNC int8_t i2c_read(I2C_TypeDef *pI2C, uint8_t slave_address, uint16_t speed, uint8_t *pbuffer, uint16_t size) {
     uint32_t i = 0;
     uint16_t xfer_length;
     uint16_t xfer_size;
+    uint32_t timeout = (SystemCoreClock / 1000U) * I2C_XFER_TIMEOUT_MS;
+    int8_t ret;
 
     (void)(speed);
 
+    /* - Re-enable the peripheral after an aborted transfer */
+    if (!(pI2C->CR1 & I2C_CR1_PE)) {
+        i2c_init(pI2C);
+    }
+
     xfer_length = size;
     if (xfer_length > 0xFF) {
         xfer_size = 0xFF;
@@ -161,21 +282,29 @@ int8_t i2c_read(I2C_TypeDef *pI2C, uint8_t slave_address, uint16_t speed, uint8_
             pI2C->ICR |= I2C_ICR_NACKCF | I2C_ICR_STOPCF;
             return -1;
         }
+        if (timeout-- == 0) {
+            pI2C->CR1 &= ~(I2C_CR1_PE);
+            return -2;
+        }
     }
 
     while (xfer_length > 0) {
         /* - Read data */
         for (i = 0; i < xfer_size; i++) {
             /*- Wait for data reception */
-            while (!(pI2C->ISR & I2C_ISR_RXNE))
-                ;
+            ret = i2c_wait_flag(pI2C, I2C_ISR_RXNE);
+            if (ret != 0) {
+                return ret;
+            }
             /*- Store data  */
             *(pbuffer++) = (uint8_t)pI2C->RXDR;
         }
         xfer_length = (xfer_length - xfer_size);
         if (xfer_length > 0) {
-            while (!(pI2C->ISR & I2C_ISR_TCR))
-                ;
+            ret = i2c_wait_flag(pI2C, I2C_ISR_TCR);
+            if (ret != 0) {
+                return ret;
+            }
             if (xfer_length > 0xFF) {
                 xfer_size = 0xFF;
                 pI2C->CR2 |= I2C_CR2_RELOAD;
@@ -204,3 +333,36 @@ void i2c_wake(I2C_TypeDef *pI2C, uint8_t slave_address) {
     /* - Start Xfer */
     pI2C->CR2 |= I2C_CR2_START;
 }
+
+int8_t i2c_probe(I2C_TypeDef *pI2C, uint8_t slave_address) {
+    /* - Polling loop iterations take more than one core cycle : the bound is an upper limit */
+    uint32_t timeout = (SystemCoreClock / 1000U) * I2C_PROBE_TIMEOUT_MS;
+    int8_t ret = 0;
+
+    /* - Clear pending flags */
+    pI2C->ICR |= I2C_ICR_NACKCF | I2C_ICR_STOPCF;
+
+    /* - Xfer Configuration (address only) */
+    pI2C->CR2 = (0x00 << I2C_CR2_ADD10_Pos) |
+                (0x00 << I2C_CR2_RD_WRN_Pos) |
+                (0x00 << I2C_CR2_NBYTES_Pos) |
+                (0x01 << I2C_CR2_AUTOEND_Pos) |
+                (slave_address << (I2C_CR2_SADD_Pos + 1));
+    /* - Start Xfer */
+    pI2C->CR2 |= I2C_CR2_START;
+
+    /* - Wait for end of Xfer and check address acknowledge */
+    while (!(pI2C->ISR & I2C_ISR_STOPF)) {
+        if (timeout-- == 0) {
+            /* - SDA/SCL held low (e.g. back-powered device) : abort, re-initialized by the next probe */
+            pI2C->CR1 &= ~(I2C_CR1_PE);
+            return -2;
+        }
+    }
+    if (pI2C->ISR & I2C_ISR_NACKF) {
+        ret = -1;
+    }
+    pI2C->ICR |= I2C_ICR_NACKCF | I2C_ICR_STOPCF;
+
+    return ret;
+}
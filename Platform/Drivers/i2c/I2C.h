@@ -19,10 +19,14 @@
 
 #include "stm32l4xx.h"
 
+/* Enable the clock and pins of I2C2 (PB10-SCL, PB11-SDA) or I2C3 (PA7-SCL, PB4-SDA), I2C1 is set up by SystemInit */
+void i2c_io_init(I2C_TypeDef *pI2C);
 uint8_t i2c_init(I2C_TypeDef *pI2C);
 void i2c_deinit(I2C_TypeDef *pI2C);
+/* i2c_write, i2c_read and i2c_probe return 0 = done, -1 = not acknowledged, -2 = bus stuck (peripheral disabled until re-initialized) */
 int8_t i2c_write(I2C_TypeDef *pI2C, uint8_t slave_address, uint16_t speed, uint8_t *pbuffer, uint16_t size);
 int8_t i2c_read(I2C_TypeDef *pI2C, uint8_t slave_address, uint16_t speed, uint8_t *pbuffer, uint16_t size);
 void i2c_wake(I2C_TypeDef *pI2C, uint8_t slave_address);
+int8_t i2c_probe(I2C_TypeDef *pI2C, uint8_t slave_address);
 
 #endif /* DRIVERS_I2C_I2C_H_ */
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * \file	ram_arena.c
+ * \brief   RAM placement sections and static RAM2 arena for STM32L452
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include "Drivers/ram_arena/ram_arena.h"
+#include <string.h>
+
+/* Arena bounds, defined in the linker script (IAR : RAM2_ARENA block) */
+#if defined(__ICCARM__)
+#pragma section = "RAM2_ARENA"
+#define RAM_ARENA_START ((uint8_t *)__section_begin("RAM2_ARENA"))
+#define RAM_ARENA_END ((uint8_t *)__section_end("RAM2_ARENA"))
+#else
+extern uint8_t _sram2_arena;
+extern uint8_t _eram2_arena;
+#define RAM_ARENA_START (&_sram2_arena)
+#define RAM_ARENA_END (&_eram2_arena)
+#endif
+
+static uint8_t *ram_arena_top = RAM_ARENA_START;
+
+void *ram_arena_alloc(uint32_t size, uint32_t alignment) {
+    uint32_t primask = __get_PRIMASK();
+    uint8_t *pBlock = NULL;
+    uint32_t start;
+
+    if ((alignment == 0) || ((alignment & (alignment - 1)) != 0)) {
+        return NULL;
+    }
+
+    __disable_irq();
+    start = ((uint32_t)ram_arena_top + alignment - 1) & ~(alignment - 1);
+    if ((start <= (uint32_t)RAM_ARENA_END) && (size <= ((uint32_t)RAM_ARENA_END - start))) {
+        pBlock = (uint8_t *)start;
+        ram_arena_top = pBlock + size;
+    }
+    __set_PRIMASK(primask);
+
+    if (pBlock != NULL) {
+        memset(pBlock, 0, size);
+    }
+
+    return pBlock;
+}
+
+uint32_t ram_arena_get_used(void) {
+    return (uint32_t)(ram_arena_top - RAM_ARENA_START);
+}
+
+uint32_t ram_arena_get_free(void) {
+    return (uint32_t)(RAM_ARENA_END - ram_arena_top);
+}
@@ -0,0 +1,63 @@
+/******************************************************************************
+ * \file	ram_arena.h
+ * \brief   RAM placement sections and static RAM2 arena for STM32L452
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef RAM_ARENA_H_
+#define RAM_ARENA_H_
+
+#include "stm32l4xx.h"
+
+/* Placement of hot objects (output sections of STM32L452RETX_FLASH.ld, blocks of stm32l452xx_flash.icf) :
+ * - RAM_FAST_IO : I/O frame buffers, grouped at the start of .bss in SRAM1
+ *                 (system bus, the memory reachable by the DMA)
+ * - RAM2_CRYPTO : crypto scratch (ECC math buffers, scratch arena) in SRAM2,
+ *                 zeroed at startup, accessed by the CPU only
+ * - RAM2_TABLE  : lookup tables copied from flash to SRAM2 at startup
+ *                 (no flash wait states on table lookups)
+ * - RAM2_FUNC   : hot path kernels copied from flash to SRAM2 at startup, fetched
+ *                 on the I-Code bus while the data accesses use SRAM1
+ *                 (define RAM_FUNC_IN_FLASH to keep them in flash for comparison)
+ */
+#if defined(__ICCARM__)
+/* IAR : same sections placed by stm32l452xx_flash.icf ("@" placement, no alignment
+ * attribute : the objects keep their natural alignment). Functions use __ramfunc
+ * (section .textrw, copied by the IAR data initialization). */
+#define RAM_FAST_IO @ ".bss.fast_io"
+#define RAM2_CRYPTO @ ".ram2_bss.crypto"
+#define RAM2_TABLE @ ".ram2_data.table"
+#ifndef RAM_FUNC_IN_FLASH
+#define RAM2_FUNC __ramfunc
+#else
+#define RAM2_FUNC
+#endif
+#else
+#define RAM_FAST_IO __attribute__((section(".bss.fast_io"), aligned(4)))
+#define RAM2_CRYPTO __attribute__((section(".ram2_bss.crypto"), aligned(4)))
+#define RAM2_TABLE __attribute__((section(".ram2_data.table"), aligned(4)))
+#ifndef RAM_FUNC_IN_FLASH
+#define RAM2_FUNC __attribute__((section(".ramfunc")))
+#else
+#define RAM2_FUNC
+#endif
+#endif /* __ICCARM__ */
+
+/* Static arena : SRAM2 left after the RAM2 sections, carved at initialization time
+ * and never released. Carved blocks are zeroed. */
+void *ram_arena_alloc(uint32_t size, uint32_t alignment);
+uint32_t ram_arena_get_used(void);
+uint32_t ram_arena_get_free(void);
+
+#endif /* RAM_ARENA_H_ */
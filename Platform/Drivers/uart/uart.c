@@ -17,10 +17,13 @@
 
 #include <Drivers/uart/uart.h>
 
+static uint32_t uart_baudrate = 115200;
+
 #ifdef STM32G0
 void uart_init(uint32_t baudrate) {
     /* - Set prescaler & baudrate (baud = usart_ker_ck_pres / BRR ) */
-    USART2->BRR = SystemCoreClock / baudrate;
+    uart_baudrate = baudrate;
+    USART2->BRR = (SystemCoreClock + (baudrate / 2)) / baudrate;
     /* - Configure UART */
     USART2->CR1 = ((1 << USART_CR1_TE_Pos) | // Enable TX
                    (1 << USART_CR1_RE_Pos)   // Enable RX
@@ -37,6 +40,10 @@ void uart_putc(uint8_t c) {
     USART2->TDR = c;
 }
 
+uint8_t uart_rx_ready(void) {
+    return (USART2->ISR & USART_ISR_RXNE_RXFNE) ? 1 : 0;
+}
+
 uint8_t uart_getc(void) {
     /* - Wait for RX not empty */
     while (!(USART2->ISR & USART_ISR_RXNE_RXFNE))
@@ -50,7 +57,8 @@ uint8_t uart_getc(void) {
 void uart_init(uint32_t baudrate) {
     /* - Set prescaler & baudrate (baud = usart_ker_ck_pres / BRR ) */
     USART2->GTPR = (0x1UL << USART_GTPR_PSC_Pos);
-    USART2->BRR = SystemCoreClock / baudrate;
+    uart_baudrate = baudrate;
+    USART2->BRR = (SystemCoreClock + (baudrate / 2)) / baudrate;
     /* Enables receive transmit mode  */
     USART2->CR1 |= ((1 << USART_CR1_TE_Pos) | // Enable TX
                     (1 << USART_CR1_RE_Pos)   // Enable RX
@@ -70,6 +78,10 @@ void uart_putc(uint8_t c) {
         ;
 }
 
+uint8_t uart_rx_ready(void) {
+    return (USART2->ISR & USART_ISR_RXNE) ? 1 : 0;
+}
+
 uint8_t uart_getc(void) {
     /* - Wait for RX not empty */
     while (!(USART2->ISR & USART_ISR_RXNE))
@@ -78,3 +90,18 @@ uint8_t uart_getc(void) {
     return USART2->RDR;
 }
 #endif
+
+void uart_flush(void) {
+    /* - Wait for the last character to be shifted out */
+    while (!(USART2->ISR & USART_ISR_TC))
+        ;
+}
+
+void uart_clock_update(void) {
+    uart_flush();
+
+    /* - BRR is only writable with the UART disabled */
+    USART2->CR1 &= ~(USART_CR1_UE);
+    USART2->BRR = (SystemCoreClock + (uart_baudrate / 2)) / uart_baudrate;
+    USART2->CR1 |= USART_CR1_UE;
+}
@@ -23,5 +23,9 @@
 void uart_init(uint32_t baudrate);
 void uart_putc(uint8_t c);
 uint8_t uart_getc(void);
+uint8_t uart_rx_ready(void);
+void uart_flush(void);
+/* Recompute the baudrate divider after a SystemCoreClock change */
+void uart_clock_update(void);
 
 #endif /* UART_H_ */
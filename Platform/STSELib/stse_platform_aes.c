@@ -17,6 +17,9 @@
 
 #include "Middleware/STM32_Cryptographic/include/cmox_crypto.h"
 #include "stse_conf.h"
+#include "stse_platform_aes.h"
+#include "stse_platform_profiler.h"
+#include "stse_platform_scratch.h"
 #include "stselib.h"
 
 cmox_mac_handle_t *pMAC_Handler;
@@ -24,35 +27,161 @@ cmox_cmac_handle_t CMAC_Handler;
 
 #if defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_HOST_SESSION)
 
-stse_ReturnCode_t stse_platform_aes_cmac_init(const PLAT_UI8 *pKey,
-                                              PLAT_UI16 key_length,
-                                              PLAT_UI16 exp_tag_size) {
+/* Session context of the last key used through the key based CMAC functions */
+static stse_platform_aes_cmac_session_t cmac_key_session;
+static PLAT_UI8 cmac_key_session_key[STSE_PLATFORM_AES_MAX_KEY_SIZE];
+static PLAT_UI16 cmac_key_session_key_length;
+
+/**
+ * \brief  Get the session context of a key, set up again only when the key or the tag size changes
+ */
+static const stse_platform_aes_cmac_session_t *stse_platform_aes_cmac_key_session(const PLAT_UI8 *pKey,
+                                                                                  PLAT_UI16 key_length,
+                                                                                  PLAT_UI16 tag_size) {
+    if (cmac_key_session.ready &&
+        (cmac_key_session.tag_size == tag_size) &&
+        (cmac_key_session_key_length == key_length) &&
+        (memcmp(cmac_key_session_key, pKey, key_length) == 0)) {
+        return &cmac_key_session;
+    }
+
+    stse_platform_aes_cmac_session_clear(&cmac_key_session);
+    if ((key_length > STSE_PLATFORM_AES_MAX_KEY_SIZE) ||
+        (stse_platform_aes_cmac_session_init(&cmac_key_session, pKey, key_length, tag_size) != STSE_OK)) {
+        return NULL;
+    }
+    memcpy(cmac_key_session_key, pKey, key_length);
+    cmac_key_session_key_length = key_length;
+
+    return &cmac_key_session;
+}
+
+stse_ReturnCode_t stse_platform_aes_cmac_session_init(stse_platform_aes_cmac_session_t *pSession,
+                                                      const PLAT_UI8 *pKey,
+                                                      PLAT_UI16 key_length,
+                                                      PLAT_UI16 tag_size) {
+    cmox_mac_handle_t *pHandle;
     cmox_mac_retval_t retval;
 
+    pSession->ready = 0;
+
     /* - Call CMAC constructor */
-    pMAC_Handler = cmox_cmac_construct(&CMAC_Handler, CMOX_CMAC_AESSMALL);
+    pHandle = cmox_cmac_construct(&pSession->handle, STSE_PLATFORM_AES_CMAC_IMPL);
 
     /* - Init MAC */
-    retval = cmox_mac_init(pMAC_Handler);
+    retval = cmox_mac_init(pHandle);
+    /* - Set Tag length */
+    if (retval == CMOX_MAC_SUCCESS) {
+        retval = cmox_mac_setTagLen(pHandle, tag_size);
+    }
+    /* - Set Key (AES key expansion, K1/K2 subkeys) */
+    if (retval == CMOX_MAC_SUCCESS) {
+        retval = cmox_mac_setKey(pHandle, pKey, key_length);
+    }
     if (retval != CMOX_MAC_SUCCESS) {
+        stse_platform_aes_cmac_session_clear(pSession);
         return STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
     }
-    /* - Set Tag length */
-    retval = cmox_mac_setTagLen(pMAC_Handler, exp_tag_size);
-    if (retval != CMOX_MAC_SUCCESS) {
+
+    pSession->tag_size = tag_size;
+    pSession->ready = 1;
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_aes_cmac_session_start(const stse_platform_aes_cmac_session_t *pSession) {
+    if ((pSession == NULL) || !pSession->ready) {
+        return STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
+    }
+
+    /* - Clone by struct copy : CMOX documents no clone operation, the CMAC handle is assumed
+     *   self-contained (expanded key, subkeys and chaining block held by value, pointers to
+     *   constant tables only). Checked by stse_platform_aes_cmac_check() */
+    CMAC_Handler = pSession->handle;
+    pMAC_Handler = (cmox_mac_handle_t *)&CMAC_Handler;
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_aes_cmac_session_compute(const stse_platform_aes_cmac_session_t *pSession,
+                                                         const PLAT_UI8 *pPayload,
+                                                         PLAT_UI16 payload_length,
+                                                         PLAT_UI8 *pTag,
+                                                         PLAT_UI16 *pTag_length) {
+    cmox_cmac_handle_t clone;
+    cmox_mac_retval_t retval;
+    size_t cmox_tag_len = 0;
+
+    if ((pSession == NULL) || !pSession->ready) {
         return STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
     }
-    /* - Set Key  */
-    retval = cmox_mac_setKey(pMAC_Handler, pKey, key_length);
+
+    clone = pSession->handle; /* Clone : self-contained handle assumed, see stse_platform_aes_cmac_session_start() */
+    retval = cmox_mac_append((cmox_mac_handle_t *)&clone, pPayload, payload_length);
+    if (retval == CMOX_MAC_SUCCESS) {
+        retval = cmox_mac_generateTag((cmox_mac_handle_t *)&clone, pTag, &cmox_tag_len);
+    }
+    stse_platform_scratch_wipe(&clone, sizeof(clone));
+
     if (retval != CMOX_MAC_SUCCESS) {
         return STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
     }
 
+    *pTag_length = (PLAT_UI16)cmox_tag_len;
+
     return STSE_OK;
 }
 
+stse_ReturnCode_t stse_platform_aes_cmac_session_verify(const stse_platform_aes_cmac_session_t *pSession,
+                                                        const PLAT_UI8 *pPayload,
+                                                        PLAT_UI16 payload_length,
+                                                        const PLAT_UI8 *pTag) {
+    cmox_cmac_handle_t clone;
+    cmox_mac_retval_t retval;
+    uint32_t cmox_mac_fault_check = 0;
+
+    if ((pSession == NULL) || !pSession->ready) {
+        return STSE_PLATFORM_AES_CMAC_VERIFY_ERROR;
+    }
+
+    clone = pSession->handle; /* Clone : self-contained handle assumed, see stse_platform_aes_cmac_session_start() */
+    retval = cmox_mac_append((cmox_mac_handle_t *)&clone, pPayload, payload_length);
+    if (retval == CMOX_MAC_SUCCESS) {
+        retval = cmox_mac_verifyTag((cmox_mac_handle_t *)&clone, pTag, &cmox_mac_fault_check);
+    }
+    stse_platform_scratch_wipe(&clone, sizeof(clone));
+
+    if ((retval != CMOX_MAC_AUTH_SUCCESS) || (cmox_mac_fault_check != CMOX_MAC_AUTH_SUCCESS)) {
+        return STSE_PLATFORM_AES_CMAC_VERIFY_ERROR;
+    }
+
+    return STSE_OK;
+}
+
+void stse_platform_aes_cmac_session_clear(stse_platform_aes_cmac_session_t *pSession) {
+    if (pSession->ready) {
+        cmox_mac_cleanup((cmox_mac_handle_t *)&pSession->handle);
+    }
+    stse_platform_scratch_wipe(&pSession->handle, sizeof(pSession->handle));
+    pSession->ready = 0;
+
+    if (pSession == &cmac_key_session) {
+        stse_platform_scratch_wipe(cmac_key_session_key, sizeof(cmac_key_session_key));
+        cmac_key_session_key_length = 0;
+    }
+}
+
+stse_ReturnCode_t stse_platform_aes_cmac_init(const PLAT_UI8 *pKey,
+                                              PLAT_UI16 key_length,
+                                              PLAT_UI16 exp_tag_size) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_AES_CMAC_INIT, 0);
+    /* - Clone the prepared context of the key */
+    return stse_platform_aes_cmac_session_start(stse_platform_aes_cmac_key_session(pKey, key_length, exp_tag_size));
+}
+
 stse_ReturnCode_t stse_platform_aes_cmac_append(PLAT_UI8 *pInput,
                                                 PLAT_UI16 lenght) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_AES_CMAC_APPEND, lenght);
     cmox_mac_retval_t retval;
 
     retval = cmox_mac_append(pMAC_Handler, pInput, lenght);
@@ -65,25 +194,25 @@ stse_ReturnCode_t stse_platform_aes_cmac_append(PLAT_UI8 *pInput,
 }
 
 stse_ReturnCode_t stse_platform_aes_cmac_compute_finish(PLAT_UI8 *pTag, PLAT_UI8 *pTagLen) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_AES_CMAC_FINISH, 0);
     cmox_mac_retval_t retval;
     size_t cmox_tag_len = *pTagLen;
 
     retval = cmox_mac_generateTag(pMAC_Handler, pTag, &cmox_tag_len);
-    if (retval != CMOX_MAC_SUCCESS) {
-        return STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
-    }
 
-    *pTagLen = (PLAT_UI8)cmox_tag_len;
+    stse_platform_scratch_wipe(&CMAC_Handler, sizeof(CMAC_Handler));
 
-    retval = cmox_mac_cleanup(pMAC_Handler);
     if (retval != CMOX_MAC_SUCCESS) {
         return STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
     }
 
+    *pTagLen = (PLAT_UI8)cmox_tag_len;
+
     return STSE_OK;
 }
 
 stse_ReturnCode_t stse_platform_aes_cmac_verify_finish(PLAT_UI8 *pTag) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_AES_CMAC_FINISH, 0);
     cmox_mac_retval_t retval;
     uint32_t cmox_mac_fault_check = 0;
 
@@ -92,7 +221,7 @@ stse_ReturnCode_t stse_platform_aes_cmac_verify_finish(PLAT_UI8 *pTag) {
         pTag,
         &cmox_mac_fault_check);
 
-    cmox_mac_cleanup(pMAC_Handler);
+    stse_platform_scratch_wipe(&CMAC_Handler, sizeof(CMAC_Handler));
 
     if ((retval != CMOX_MAC_AUTH_SUCCESS) || (cmox_mac_fault_check != CMOX_MAC_AUTH_SUCCESS)) {
         return STSE_PLATFORM_AES_CMAC_VERIFY_ERROR;
@@ -108,28 +237,13 @@ stse_ReturnCode_t stse_platform_aes_cmac_compute(const PLAT_UI8 *pPayload,
                                                  PLAT_UI16 exp_tag_size,
                                                  PLAT_UI8 *pTag,
                                                  PLAT_UI16 *pTag_length) {
-    cmox_mac_retval_t retval;
-    size_t cmox_tag_len = *pTag_length;
-
-    retval = cmox_mac_compute(CMOX_CMAC_AESSMALL_ALGO, /* Use AES CMAC algorithm */
-                              pPayload,                /* Message */
-                              payload_length,          /* Message length*/
-                              pKey,                    /* AES key */
-                              key_length,              /* AES key length */
-                              NULL,                    /* Custom Data */
-                              0,                       /* Custom Data length */
-                              pTag,                    /* Tag */
-                              exp_tag_size,            /* Expected Tag size */
-                              &cmox_tag_len            /* Generated Tag size */
-    );
-
-    if (retval != CMOX_MAC_SUCCESS) {
-        return STSE_PLATFORM_AES_CMAC_VERIFY_ERROR;
-    }
-
-    *pTag_length = (PLAT_UI16)cmox_tag_len;
-
-    return STSE_OK;
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_AES_CMAC, payload_length);
+    /* - Reuse the expanded key and subkeys of the last key */
+    return stse_platform_aes_cmac_session_compute(stse_platform_aes_cmac_key_session(pKey, key_length, exp_tag_size),
+                                                  pPayload,
+                                                  payload_length,
+                                                  pTag,
+                                                  pTag_length);
 }
 
 stse_ReturnCode_t stse_platform_aes_cmac_verify(const PLAT_UI8 *pPayload,
@@ -138,25 +252,79 @@ stse_ReturnCode_t stse_platform_aes_cmac_verify(const PLAT_UI8 *pPayload,
                                                 PLAT_UI16 key_length,
                                                 const PLAT_UI8 *pTag,
                                                 PLAT_UI16 tag_length) {
-    cmox_mac_retval_t retval;
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_AES_CMAC, payload_length);
+    /* - Reuse the expanded key and subkeys of the last key */
+    return stse_platform_aes_cmac_session_verify(stse_platform_aes_cmac_key_session(pKey, key_length, tag_length),
+                                                 pPayload,
+                                                 payload_length,
+                                                 pTag);
+}
 
-    /* - Perform CMAC verification */
-    retval = cmox_mac_verify(CMOX_CMAC_AESSMALL_ALGO, /* Use AES CMAC algorithm */
-                             pPayload,                /* Message length */
-                             payload_length,          /* Message length */
-                             pKey,                    /* AES key */
-                             key_length,              /* AES key length */
-                             NULL,                    /* Custom data */
-                             0,                       /* Custom data length*/
-                             pTag,                    /* Tag */
-                             tag_length               /* Tag size */
-    );
+void stse_platform_aes_cmac_key_session_end(void) {
+    /* - Wipes the key copy with the context */
+    stse_platform_aes_cmac_session_clear(&cmac_key_session);
+}
 
-    if (retval != CMOX_MAC_AUTH_SUCCESS) {
-        return STSE_PLATFORM_AES_CMAC_VERIFY_ERROR;
+stse_ReturnCode_t stse_platform_aes_cmac_check(void) {
+    static const PLAT_UI16 key_lengths[] = {16U, 32U};
+    stse_platform_aes_cmac_session_t session;
+    PLAT_UI8 key[STSE_PLATFORM_AES_MAX_KEY_SIZE];
+    PLAT_UI8 data[100];
+    PLAT_UI8 tag[STSE_PLATFORM_AES_BLOCK_SIZE];
+    PLAT_UI8 tag_reference[STSE_PLATFORM_AES_BLOCK_SIZE];
+    PLAT_UI8 tag_length;
+    PLAT_UI16 session_tag_length;
+    size_t reference_length;
+    stse_ReturnCode_t ret = STSE_OK;
+
+    for (PLAT_UI8 i = 0; i < sizeof(key); i++) {
+        key[i] = (PLAT_UI8)(0x2BU + (i * 13U));
+    }
+    for (PLAT_UI8 i = 0; i < sizeof(data); i++) {
+        data[i] = (PLAT_UI8)(i ^ 0x5AU);
     }
 
-    return STSE_OK;
+    for (PLAT_UI8 k = 0; (k < (sizeof(key_lengths) / sizeof(key_lengths[0]))) && (ret == STSE_OK); k++) {
+        if (cmox_mac_compute(STSE_PLATFORM_AES_CMAC_ALGO, data, sizeof(data), key, key_lengths[k], NULL, 0,
+                             tag_reference, sizeof(tag_reference), &reference_length) != CMOX_MAC_SUCCESS) {
+            return STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
+        }
+
+        ret = stse_platform_aes_cmac_session_init(&session, key, key_lengths[k], sizeof(tag_reference));
+
+        /* - Two clones of the same session (a clone must not alter the session context) */
+        for (PLAT_UI8 n = 0; (n < 2) && (ret == STSE_OK); n++) {
+            ret = stse_platform_aes_cmac_session_compute(&session, data, sizeof(data), tag, &session_tag_length);
+            if ((ret == STSE_OK) && (memcmp(tag, tag_reference, sizeof(tag)) != 0)) {
+                ret = STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
+            }
+        }
+        if ((ret == STSE_OK) && (stse_platform_aes_cmac_session_verify(&session, data, sizeof(data), tag_reference) != STSE_OK)) {
+            ret = STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
+        }
+
+        /* - Streamed MAC from a clone, data split across block boundaries */
+        if (ret == STSE_OK) {
+            ret = stse_platform_aes_cmac_session_start(&session);
+        }
+        if (ret == STSE_OK) {
+            ret = stse_platform_aes_cmac_append(data, 7);
+        }
+        if (ret == STSE_OK) {
+            ret = stse_platform_aes_cmac_append(&data[7], sizeof(data) - 7);
+        }
+        if (ret == STSE_OK) {
+            tag_length = sizeof(tag);
+            ret = stse_platform_aes_cmac_compute_finish(tag, &tag_length);
+        }
+        if ((ret == STSE_OK) && (memcmp(tag, tag_reference, sizeof(tag)) != 0)) {
+            ret = STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
+        }
+
+        stse_platform_aes_cmac_session_clear(&session);
+    }
+
+    return ret;
 }
 #endif /* defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT) */
 
@@ -168,19 +336,20 @@ stse_ReturnCode_t stse_platform_aes_cbc_enc(const PLAT_UI8 *pPlaintext,
                                             PLAT_UI16 key_length,
                                             PLAT_UI8 *pEncryptedtext,
                                             PLAT_UI16 *pEncryptedtext_length) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_AES_CBC_ENC, plaintext_length);
     cmox_cipher_retval_t retval;
     size_t cmox_encryptedtext_len = *pEncryptedtext_length;
 
     /*- Perform AES ECB Encryption */
-    retval = cmox_cipher_encrypt(CMOX_AESSMALL_CBC_ENC_ALGO, /* Use AES CBC algorithm */
-                                 pPlaintext,                 /* Plain Text */
-                                 plaintext_length,           /* Plain Text length*/
-                                 pKey,                       /* AES Key */
-                                 key_length,                 /* AES Key length*/
-                                 pInitial_value,             /* Initial Value */
-                                 16,                         /* Initial Value length */
-                                 pEncryptedtext,             /* Ciphered Text */
-                                 &cmox_encryptedtext_len     /* Ciphered Text length*/
+    retval = cmox_cipher_encrypt(STSE_PLATFORM_AES_CBC_ENC_ALGO, /* Use AES CBC algorithm */
+                                 pPlaintext,                     /* Plain Text */
+                                 plaintext_length,               /* Plain Text length*/
+                                 pKey,                           /* AES Key */
+                                 key_length,                     /* AES Key length*/
+                                 pInitial_value,                 /* Initial Value */
+                                 16,                             /* Initial Value length */
+                                 pEncryptedtext,                 /* Ciphered Text */
+                                 &cmox_encryptedtext_len         /* Ciphered Text length*/
     );
 
     /*- Verify AES ECB Encryption status */
@@ -200,19 +369,20 @@ stse_ReturnCode_t stse_platform_aes_cbc_dec(const PLAT_UI8 *pEncryptedtext,
                                             PLAT_UI16 key_length,
                                             PLAT_UI8 *pPlaintext,
                                             PLAT_UI16 *pPlaintext_length) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_AES_CBC_DEC, encryptedtext_length);
     cmox_cipher_retval_t retval;
     size_t cmox_plaintext_len = *pPlaintext_length;
 
     /*- Perform AES ECB decryption */
-    retval = cmox_cipher_decrypt(CMOX_AESSMALL_CBC_DEC_ALGO, /* Use AES CBC algorithm */
-                                 pEncryptedtext,             /* Ciphered Text */
-                                 encryptedtext_length,       /* Ciphered Text length */
-                                 pKey,                       /* AES key length */
-                                 key_length,                 /* AES key */
-                                 pInitial_value,             /* Initial Value */
-                                 16,                         /* Initial Value length*/
-                                 pPlaintext,                 /* Plain Text */
-                                 &cmox_plaintext_len         /* Plain Text length*/
+    retval = cmox_cipher_decrypt(STSE_PLATFORM_AES_CBC_DEC_ALGO, /* Use AES CBC algorithm */
+                                 pEncryptedtext,                 /* Ciphered Text */
+                                 encryptedtext_length,           /* Ciphered Text length */
+                                 pKey,                           /* AES key length */
+                                 key_length,                     /* AES key */
+                                 pInitial_value,                 /* Initial Value */
+                                 16,                             /* Initial Value length*/
+                                 pPlaintext,                     /* Plain Text */
+                                 &cmox_plaintext_len             /* Plain Text length*/
     );
 
     /*- Verify AES ECB decrypt return */
@@ -231,20 +401,21 @@ stse_ReturnCode_t stse_platform_aes_ecb_enc(const PLAT_UI8 *pPlaintext,
                                             PLAT_UI16 key_length,
                                             PLAT_UI8 *pEncryptedtext,
                                             PLAT_UI16 *pEncryptedtext_length) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_AES_ECB_ENC, plaintext_length);
     cmox_cipher_retval_t retval;
     PLAT_UI8 IV[16] = {0};
     size_t cmox_encryptedtext_len = *pEncryptedtext_length;
 
     /*- Perform AES ECB Encryption */
-    retval = cmox_cipher_encrypt(CMOX_AESSMALL_ECB_ENC_ALGO, /* Use AES ECB algorithm */
-                                 pPlaintext,                 /* Plain Text */
-                                 plaintext_length,           /* Plain Text length*/
-                                 pKey,                       /* AES Key */
-                                 key_length,                 /* AES Key length*/
-                                 IV,                         /* Initial Value */
-                                 16,                         /* Initial Value length */
-                                 pEncryptedtext,             /* Ciphered Text */
-                                 &cmox_encryptedtext_len     /* Ciphered Text length*/
+    retval = cmox_cipher_encrypt(STSE_PLATFORM_AES_ECB_ENC_ALGO, /* Use AES ECB algorithm */
+                                 pPlaintext,                     /* Plain Text */
+                                 plaintext_length,               /* Plain Text length*/
+                                 pKey,                           /* AES Key */
+                                 key_length,                     /* AES Key length*/
+                                 IV,                             /* Initial Value */
+                                 16,                             /* Initial Value length */
+                                 pEncryptedtext,                 /* Ciphered Text */
+                                 &cmox_encryptedtext_len         /* Ciphered Text length*/
     );
 
     /*- Verify AES ECB Encryption status */
@@ -263,20 +434,21 @@ stse_ReturnCode_t stse_platform_aes_ecb_dec(const PLAT_UI8 *pEncryptedtext,
                                             PLAT_UI16 key_length,
                                             PLAT_UI8 *pPlaintext,
                                             PLAT_UI16 *pPlaintext_length) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_AES_ECB_DEC, encryptedtext_length);
     cmox_cipher_retval_t retval;
     PLAT_UI8 IV[16] = {0};
     size_t cmox_plaintext_len = *pPlaintext_length;
 
     /*- Perform AES ECB decryption */
-    retval = cmox_cipher_decrypt(CMOX_AESSMALL_ECB_DEC_ALGO, /* Use AES ECB algorithm */
-                                 pEncryptedtext,             /* Ciphered Text */
-                                 encryptedtext_length,       /* Ciphered Text length */
-                                 pKey,                       /* AES key length */
-                                 key_length,                 /* AES key */
-                                 IV,                         /* Initial Value */
-                                 16,                         /* Initial Value length*/
-                                 pPlaintext,                 /* Plain Text */
-                                 &cmox_plaintext_len         /* Plain Text length*/
+    retval = cmox_cipher_decrypt(STSE_PLATFORM_AES_ECB_DEC_ALGO, /* Use AES ECB algorithm */
+                                 pEncryptedtext,                 /* Ciphered Text */
+                                 encryptedtext_length,           /* Ciphered Text length */
+                                 pKey,                           /* AES key length */
+                                 key_length,                     /* AES key */
+                                 IV,                             /* Initial Value */
+                                 16,                             /* Initial Value length*/
+                                 pPlaintext,                     /* Plain Text */
+                                 &cmox_plaintext_len             /* Plain Text length*/
     );
 
     /*- Verify AES ECB decrypt return */
@@ -288,4 +460,379 @@ stse_ReturnCode_t stse_platform_aes_ecb_dec(const PLAT_UI8 *pEncryptedtext,
 
     return STSE_OK;
 }
+
+/**
+ * \brief  Construct and key a CBC cipher handle
+ */
+static cmox_cipher_handle_t *stse_platform_aes_cbc_start(cmox_cbc_handle_t *pCbc_handle,
+                                                         cmox_cbc_impl_t impl,
+                                                         const PLAT_UI8 *pKey,
+                                                         PLAT_UI16 key_length,
+                                                         const PLAT_UI8 *pInitial_value) {
+    cmox_cipher_handle_t *pCipher = cmox_cbc_construct(pCbc_handle, impl);
+
+    if ((pCipher == NULL) ||
+        (cmox_cipher_init(pCipher) != CMOX_CIPHER_SUCCESS) ||
+        (cmox_cipher_setKey(pCipher, pKey, key_length) != CMOX_CIPHER_SUCCESS) ||
+        (cmox_cipher_setIV(pCipher, pInitial_value, STSE_PLATFORM_AES_BLOCK_SIZE) != CMOX_CIPHER_SUCCESS)) {
+        return NULL;
+    }
+
+    return pCipher;
+}
+
+stse_ReturnCode_t stse_platform_aes_cbc_enc_cmac_append(const PLAT_UI8 *pPlaintext,
+                                                        PLAT_UI16 plaintext_length,
+                                                        PLAT_UI8 *pInitial_value,
+                                                        const PLAT_UI8 *pKey,
+                                                        PLAT_UI16 key_length,
+                                                        PLAT_UI8 *pEncryptedtext,
+                                                        PLAT_UI16 *pEncryptedtext_length) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_AES_CBC_ENC_CMAC, plaintext_length);
+    stse_ReturnCode_t ret = STSE_OK;
+    cmox_cbc_handle_t cbc_handle;
+    cmox_cipher_handle_t *pCipher;
+    PLAT_UI16 offset = 0;
+
+    if (((plaintext_length % STSE_PLATFORM_AES_BLOCK_SIZE) != 0) || (*pEncryptedtext_length < plaintext_length)) {
+        return STSE_PLATFORM_AES_CBC_ENCRYPT_ERROR;
+    }
+
+    pCipher = stse_platform_aes_cbc_start(&cbc_handle, STSE_PLATFORM_AES_CBC_ENC_IMPL, pKey, key_length, pInitial_value);
+    if (pCipher == NULL) {
+        ret = STSE_PLATFORM_AES_CBC_ENCRYPT_ERROR;
+    }
+
+    while ((ret == STSE_OK) && (offset < plaintext_length)) {
+        PLAT_UI16 chunk = plaintext_length - offset;
+        size_t cmox_chunk_length;
+
+        chunk = (chunk < STSE_PLATFORM_AES_PIPELINE_CHUNK) ? chunk : STSE_PLATFORM_AES_PIPELINE_CHUNK;
+
+        /* - Encrypt the chunk then MAC the ciphertext just produced */
+        if (cmox_cipher_append(pCipher, &pPlaintext[offset], chunk, &pEncryptedtext[offset], &cmox_chunk_length) != CMOX_CIPHER_SUCCESS ||
+            cmox_chunk_length != chunk) {
+            ret = STSE_PLATFORM_AES_CBC_ENCRYPT_ERROR;
+        } else if (cmox_mac_append(pMAC_Handler, &pEncryptedtext[offset], chunk) != CMOX_MAC_SUCCESS) {
+            ret = STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
+        }
+        offset += chunk;
+    }
+
+    if (pCipher != NULL) {
+        cmox_cipher_cleanup(pCipher);
+    }
+
+    if (ret != STSE_OK) {
+        return ret;
+    }
+
+    *pEncryptedtext_length = plaintext_length;
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_aes_cmac_verify_cbc_dec(const PLAT_UI8 *pEncryptedtext,
+                                                        PLAT_UI16 encryptedtext_length,
+                                                        PLAT_UI8 *pInitial_value,
+                                                        const PLAT_UI8 *pKey,
+                                                        PLAT_UI16 key_length,
+                                                        PLAT_UI8 *pTag,
+                                                        PLAT_UI8 *pPlaintext,
+                                                        PLAT_UI16 *pPlaintext_length) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_AES_CMAC_CBC_DEC, encryptedtext_length);
+    stse_ReturnCode_t ret = STSE_OK;
+    cmox_cbc_handle_t cbc_handle;
+    cmox_cipher_handle_t *pCipher;
+    PLAT_UI16 offset = 0;
+
+    if (((encryptedtext_length % STSE_PLATFORM_AES_BLOCK_SIZE) != 0) || (*pPlaintext_length < encryptedtext_length)) {
+        stse_platform_scratch_wipe(&CMAC_Handler, sizeof(CMAC_Handler));
+        return STSE_PLATFORM_AES_CBC_DECRYPT_ERROR;
+    }
+
+    pCipher = stse_platform_aes_cbc_start(&cbc_handle, STSE_PLATFORM_AES_CBC_DEC_IMPL, pKey, key_length, pInitial_value);
+    if (pCipher == NULL) {
+        ret = STSE_PLATFORM_AES_CBC_DECRYPT_ERROR;
+    }
+
+    while ((ret == STSE_OK) && (offset < encryptedtext_length)) {
+        PLAT_UI16 chunk = encryptedtext_length - offset;
+        size_t cmox_chunk_length;
+
+        chunk = (chunk < STSE_PLATFORM_AES_PIPELINE_CHUNK) ? chunk : STSE_PLATFORM_AES_PIPELINE_CHUNK;
+
+        /* - MAC the ciphertext chunk then decrypt it */
+        if (cmox_mac_append(pMAC_Handler, &pEncryptedtext[offset], chunk) != CMOX_MAC_SUCCESS) {
+            ret = STSE_PLATFORM_AES_CMAC_VERIFY_ERROR;
+        } else if (cmox_cipher_append(pCipher, &pEncryptedtext[offset], chunk, &pPlaintext[offset], &cmox_chunk_length) != CMOX_CIPHER_SUCCESS ||
+                   cmox_chunk_length != chunk) {
+            ret = STSE_PLATFORM_AES_CBC_DECRYPT_ERROR;
+        }
+        offset += chunk;
+    }
+
+    if (pCipher != NULL) {
+        cmox_cipher_cleanup(pCipher);
+    }
+
+    /* - Release the plaintext only if the MAC is verified */
+    if (ret == STSE_OK) {
+        ret = stse_platform_aes_cmac_verify_finish(pTag);
+    } else {
+        stse_platform_scratch_wipe(&CMAC_Handler, sizeof(CMAC_Handler));
+    }
+    if (ret != STSE_OK) {
+        stse_platform_scratch_wipe(pPlaintext, encryptedtext_length);
+        return ret;
+    }
+
+    *pPlaintext_length = encryptedtext_length;
+
+    return STSE_OK;
+}
 #endif /* defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT)*/
+
+#if defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED) ||               \
+    defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED) || \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED) ||          \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED)
+
+#define KEK_WRAP_IV_SIZE 8
+const PLAT_UI8 KEK_WRAP_IV[KEK_WRAP_IV_SIZE] = {0xA6, 0xA6, 0xA6, 0xA6, 0xA6, 0xA6, 0xA6, 0xA6};
+
+/* Key wrap session context of the last KEK used through the key based functions */
+static stse_platform_nist_kw_session_t kw_kek_session;
+static PLAT_UI8 kw_kek_session_key[STSE_PLATFORM_AES_MAX_KEY_SIZE];
+static PLAT_UI8 kw_kek_session_key_length;
+
+/**
+ * \brief  Get the session context of a KEK, set up again only when the KEK changes
+ */
+static const stse_platform_nist_kw_session_t *stse_platform_nist_kw_kek_session(const PLAT_UI8 *pKek,
+                                                                                PLAT_UI8 kek_length) {
+    if (kw_kek_session.ready &&
+        (kw_kek_session_key_length == kek_length) &&
+        (memcmp(kw_kek_session_key, pKek, kek_length) == 0)) {
+        return &kw_kek_session;
+    }
+
+    stse_platform_nist_kw_session_clear(&kw_kek_session);
+    if ((kek_length > STSE_PLATFORM_AES_MAX_KEY_SIZE) ||
+        (stse_platform_nist_kw_session_init(&kw_kek_session, pKek, kek_length) != STSE_OK)) {
+        return NULL;
+    }
+    memcpy(kw_kek_session_key, pKek, kek_length);
+    kw_kek_session_key_length = kek_length;
+
+    return &kw_kek_session;
+}
+
+/**
+ * \brief  Wrap or unwrap a key from a clone of a prepared key wrap handle
+ * \param  pHandle : prepared handle (KEK set)
+ * \param  pInput : input
+ * \param  input_length : input length
+ * \param  pOutput : output
+ * \param  output_length : expected output length
+ * \return STSE_OK on success (integrity check passed when unwrapping), STSE_PLATFORM_KEYWRAP_ERROR otherwise
+ */
+static stse_ReturnCode_t stse_platform_nist_kw_process(const cmox_keywrap_handle_t *pHandle,
+                                                       const PLAT_UI8 *pInput,
+                                                       PLAT_UI32 input_length,
+                                                       PLAT_UI8 *pOutput,
+                                                       PLAT_UI32 output_length) {
+    cmox_keywrap_handle_t clone;
+    cmox_cipher_retval_t retval;
+    size_t cmox_output_length = 0;
+
+    /* - The whole key is processed in a single append (RFC 3394 is not streamable) */
+    clone = *pHandle;
+    retval = cmox_cipher_setIV((cmox_cipher_handle_t *)&clone, KEK_WRAP_IV, KEK_WRAP_IV_SIZE);
+    if (retval == CMOX_CIPHER_SUCCESS) {
+        retval = cmox_cipher_append((cmox_cipher_handle_t *)&clone, pInput, input_length, pOutput, &cmox_output_length);
+    }
+    stse_platform_scratch_wipe(&clone, sizeof(clone));
+
+    if (((retval != CMOX_CIPHER_SUCCESS) && (retval != CMOX_CIPHER_AUTH_SUCCESS)) ||
+        (cmox_output_length != output_length)) {
+        return STSE_PLATFORM_KEYWRAP_ERROR;
+    }
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_nist_kw_session_init(stse_platform_nist_kw_session_t *pSession,
+                                                     const PLAT_UI8 *pKek,
+                                                     PLAT_UI8 kek_length) {
+    cmox_cipher_handle_t *pWrap_handle;
+    cmox_cipher_handle_t *pUnwrap_handle;
+    cmox_cipher_retval_t retval;
+
+    pSession->ready = 0;
+
+    /* - Call key wrap constructors */
+    pWrap_handle = cmox_keywrap_construct(&pSession->wrap_handle, STSE_PLATFORM_AES_KEYWRAP_ENC_IMPL);
+    pUnwrap_handle = cmox_keywrap_construct(&pSession->unwrap_handle, STSE_PLATFORM_AES_KEYWRAP_DEC_IMPL);
+    if ((pWrap_handle == NULL) || (pUnwrap_handle == NULL)) {
+        stse_platform_nist_kw_session_clear(pSession);
+        return STSE_PLATFORM_KEYWRAP_ERROR;
+    }
+
+    /* - Init and set the KEK (encryption and decryption key schedules) */
+    retval = cmox_cipher_init(pWrap_handle);
+    if (retval == CMOX_CIPHER_SUCCESS) {
+        retval = cmox_cipher_setKey(pWrap_handle, pKek, kek_length);
+    }
+    if (retval == CMOX_CIPHER_SUCCESS) {
+        retval = cmox_cipher_init(pUnwrap_handle);
+    }
+    if (retval == CMOX_CIPHER_SUCCESS) {
+        retval = cmox_cipher_setKey(pUnwrap_handle, pKek, kek_length);
+    }
+    if (retval != CMOX_CIPHER_SUCCESS) {
+        stse_platform_nist_kw_session_clear(pSession);
+        return STSE_PLATFORM_KEYWRAP_ERROR;
+    }
+
+    pSession->ready = 1;
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_nist_kw_session_wrap(const stse_platform_nist_kw_session_t *pSession,
+                                                     const PLAT_UI8 *pPayload,
+                                                     PLAT_UI32 payload_length,
+                                                     PLAT_UI8 *pOutput,
+                                                     PLAT_UI32 *pOutput_length) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_NIST_KW, payload_length);
+    PLAT_UI32 wrapped_length = payload_length + STSE_PLATFORM_NIST_KW_SEMIBLOCK_SIZE;
+
+    if ((pSession == NULL) || !pSession->ready ||
+        (payload_length < (2 * STSE_PLATFORM_NIST_KW_SEMIBLOCK_SIZE)) ||
+        ((payload_length % STSE_PLATFORM_NIST_KW_SEMIBLOCK_SIZE) != 0) ||
+        (*pOutput_length < wrapped_length)) {
+        return STSE_PLATFORM_KEYWRAP_ERROR;
+    }
+
+    if (stse_platform_nist_kw_process(&pSession->wrap_handle, pPayload, payload_length, pOutput, wrapped_length) != STSE_OK) {
+        return STSE_PLATFORM_KEYWRAP_ERROR;
+    }
+
+    *pOutput_length = wrapped_length;
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_nist_kw_session_unwrap(const stse_platform_nist_kw_session_t *pSession,
+                                                       const PLAT_UI8 *pWrapped,
+                                                       PLAT_UI32 wrapped_length,
+                                                       PLAT_UI8 *pOutput,
+                                                       PLAT_UI32 *pOutput_length) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_NIST_KW_UNWRAP, wrapped_length);
+    PLAT_UI32 key_length = wrapped_length - STSE_PLATFORM_NIST_KW_SEMIBLOCK_SIZE;
+
+    if ((pSession == NULL) || !pSession->ready ||
+        (wrapped_length < (3 * STSE_PLATFORM_NIST_KW_SEMIBLOCK_SIZE)) ||
+        ((wrapped_length % STSE_PLATFORM_NIST_KW_SEMIBLOCK_SIZE) != 0) ||
+        (*pOutput_length < key_length)) {
+        return STSE_PLATFORM_KEYWRAP_ERROR;
+    }
+
+    /* - Never release a key failing the integrity check */
+    if (stse_platform_nist_kw_process(&pSession->unwrap_handle, pWrapped, wrapped_length, pOutput, key_length) != STSE_OK) {
+        stse_platform_scratch_wipe(pOutput, key_length);
+        return STSE_PLATFORM_KEYWRAP_ERROR;
+    }
+
+    *pOutput_length = key_length;
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_nist_kw_wrap_batch(const stse_platform_nist_kw_session_t *pSession,
+                                                   stse_platform_nist_kw_item_t *pItems,
+                                                   PLAT_UI16 item_count,
+                                                   PLAT_UI16 *pFailed_count) {
+    PLAT_UI16 failed_count = 0;
+
+    for (PLAT_UI16 i = 0; i < item_count; i++) {
+        pItems[i].result = stse_platform_nist_kw_session_wrap(pSession,
+                                                              pItems[i].pInput,
+                                                              pItems[i].input_length,
+                                                              pItems[i].pOutput,
+                                                              &pItems[i].output_length);
+        if (pItems[i].result != STSE_OK) {
+            failed_count++;
+        }
+    }
+
+    if (pFailed_count != NULL) {
+        *pFailed_count = failed_count;
+    }
+
+    return (failed_count == 0) ? STSE_OK : STSE_PLATFORM_KEYWRAP_ERROR;
+}
+
+stse_ReturnCode_t stse_platform_nist_kw_unwrap_batch(const stse_platform_nist_kw_session_t *pSession,
+                                                     stse_platform_nist_kw_item_t *pItems,
+                                                     PLAT_UI16 item_count,
+                                                     PLAT_UI16 *pFailed_count) {
+    PLAT_UI16 failed_count = 0;
+
+    for (PLAT_UI16 i = 0; i < item_count; i++) {
+        pItems[i].result = stse_platform_nist_kw_session_unwrap(pSession,
+                                                                pItems[i].pInput,
+                                                                pItems[i].input_length,
+                                                                pItems[i].pOutput,
+                                                                &pItems[i].output_length);
+        if (pItems[i].result != STSE_OK) {
+            failed_count++;
+        }
+    }
+
+    if (pFailed_count != NULL) {
+        *pFailed_count = failed_count;
+    }
+
+    return (failed_count == 0) ? STSE_OK : STSE_PLATFORM_KEYWRAP_ERROR;
+}
+
+void stse_platform_nist_kw_session_clear(stse_platform_nist_kw_session_t *pSession) {
+    if (pSession->ready) {
+        cmox_cipher_cleanup((cmox_cipher_handle_t *)&pSession->wrap_handle);
+        cmox_cipher_cleanup((cmox_cipher_handle_t *)&pSession->unwrap_handle);
+    }
+    stse_platform_scratch_wipe(&pSession->wrap_handle, sizeof(pSession->wrap_handle));
+    stse_platform_scratch_wipe(&pSession->unwrap_handle, sizeof(pSession->unwrap_handle));
+    pSession->ready = 0;
+
+    if (pSession == &kw_kek_session) {
+        stse_platform_scratch_wipe(kw_kek_session_key, sizeof(kw_kek_session_key));
+        kw_kek_session_key_length = 0;
+    }
+}
+
+stse_ReturnCode_t stse_platform_nist_kw_encrypt(PLAT_UI8 *pPayload, PLAT_UI32 payload_length,
+                                                PLAT_UI8 *pKey, PLAT_UI8 key_length,
+                                                PLAT_UI8 *pOutput, PLAT_UI32 *pOutput_length) {
+    /* - Reuse the expanded KEK of the last call */
+    return stse_platform_nist_kw_session_wrap(stse_platform_nist_kw_kek_session(pKey, key_length),
+                                              pPayload,
+                                              payload_length,
+                                              pOutput,
+                                              pOutput_length);
+}
+
+stse_ReturnCode_t stse_platform_nist_kw_decrypt(PLAT_UI8 *pPayload, PLAT_UI32 payload_length,
+                                                PLAT_UI8 *pKey, PLAT_UI8 key_length,
+                                                PLAT_UI8 *pOutput, PLAT_UI32 *pOutput_length) {
+    /* - Reuse the expanded KEK of the last call */
+    return stse_platform_nist_kw_session_unwrap(stse_platform_nist_kw_kek_session(pKey, key_length),
+                                                pPayload,
+                                                payload_length,
+                                                pOutput,
+                                                pOutput_length);
+}
+#endif /* STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED || STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED ||
+			STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED || STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED */
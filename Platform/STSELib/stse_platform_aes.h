@@ -0,0 +1,323 @@
+/******************************************************************************
+ * \file	stse_platform_aes.h
+ * \brief   STSecureElement AES platform extensions
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STSE_PLATFORM_AES_H
+#define STSE_PLATFORM_AES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "Middleware/STM32_Cryptographic/include/cmox_crypto.h"
+#include "stse_conf.h"
+#include "stselib.h"
+
+#define STSE_PLATFORM_AES_MAX_KEY_SIZE 32U
+#define STSE_PLATFORM_AES_BLOCK_SIZE 16U
+#define STSE_PLATFORM_AES_PIPELINE_CHUNK 64U /* Bytes ciphered then MACed per pipeline step (AES block multiple) */
+#define STSE_PLATFORM_NIST_KW_SEMIBLOCK_SIZE 8U /* Key wrap integrity check value and granularity (RFC 3394) */
+
+/* AES backend : CMOX AESFAST (T-tables, speed) or AESSMALL (code size) */
+#ifdef STSE_CONF_AES_BACKEND_FAST
+#define STSE_PLATFORM_AES_BACKEND_NAME "AESFAST"
+#define STSE_PLATFORM_AES_CBC_ENC_ALGO CMOX_AESFAST_CBC_ENC_ALGO
+#define STSE_PLATFORM_AES_CBC_DEC_ALGO CMOX_AESFAST_CBC_DEC_ALGO
+#define STSE_PLATFORM_AES_ECB_ENC_ALGO CMOX_AESFAST_ECB_ENC_ALGO
+#define STSE_PLATFORM_AES_ECB_DEC_ALGO CMOX_AESFAST_ECB_DEC_ALGO
+#define STSE_PLATFORM_AES_KEYWRAP_ENC_ALGO CMOX_AESFAST_KEYWRAP_ENC_ALGO
+#define STSE_PLATFORM_AES_KEYWRAP_DEC_ALGO CMOX_AESFAST_KEYWRAP_DEC_ALGO
+#define STSE_PLATFORM_AES_KEYWRAP_ENC_IMPL CMOX_AESFAST_KEYWRAP_ENC
+#define STSE_PLATFORM_AES_KEYWRAP_DEC_IMPL CMOX_AESFAST_KEYWRAP_DEC
+#define STSE_PLATFORM_AES_CMAC_IMPL CMOX_CMAC_AESFAST
+#define STSE_PLATFORM_AES_CMAC_ALGO CMOX_CMAC_AESFAST_ALGO
+#define STSE_PLATFORM_AES_CBC_ENC_IMPL CMOX_AESFAST_CBC_ENC
+#define STSE_PLATFORM_AES_CBC_DEC_IMPL CMOX_AESFAST_CBC_DEC
+#else
+#define STSE_PLATFORM_AES_BACKEND_NAME "AESSMALL"
+#define STSE_PLATFORM_AES_CBC_ENC_ALGO CMOX_AESSMALL_CBC_ENC_ALGO
+#define STSE_PLATFORM_AES_CBC_DEC_ALGO CMOX_AESSMALL_CBC_DEC_ALGO
+#define STSE_PLATFORM_AES_ECB_ENC_ALGO CMOX_AESSMALL_ECB_ENC_ALGO
+#define STSE_PLATFORM_AES_ECB_DEC_ALGO CMOX_AESSMALL_ECB_DEC_ALGO
+#define STSE_PLATFORM_AES_KEYWRAP_ENC_ALGO CMOX_AESSMALL_KEYWRAP_ENC_ALGO
+#define STSE_PLATFORM_AES_KEYWRAP_DEC_ALGO CMOX_AESSMALL_KEYWRAP_DEC_ALGO
+#define STSE_PLATFORM_AES_KEYWRAP_ENC_IMPL CMOX_AESSMALL_KEYWRAP_ENC
+#define STSE_PLATFORM_AES_KEYWRAP_DEC_IMPL CMOX_AESSMALL_KEYWRAP_DEC
+#define STSE_PLATFORM_AES_CMAC_IMPL CMOX_CMAC_AESSMALL
+#define STSE_PLATFORM_AES_CMAC_ALGO CMOX_CMAC_AESSMALL_ALGO
+#define STSE_PLATFORM_AES_CBC_ENC_IMPL CMOX_AESSMALL_CBC_ENC
+#define STSE_PLATFORM_AES_CBC_DEC_IMPL CMOX_AESSMALL_CBC_DEC
+#endif
+
+/* AES-CMAC session context : CMAC handle with expanded key and K1/K2 subkeys */
+typedef struct {
+    cmox_cmac_handle_t handle;
+    PLAT_UI16 tag_size;
+    PLAT_UI8 ready; /* Key set, handle can be cloned */
+} stse_platform_aes_cmac_session_t;
+
+/* NIST key wrap session context : KEK expanded once for wrapping and for unwrapping */
+typedef struct {
+    cmox_keywrap_handle_t wrap_handle;
+    cmox_keywrap_handle_t unwrap_handle;
+    PLAT_UI8 ready; /* KEK set, handles can be cloned */
+} stse_platform_nist_kw_session_t;
+
+/* Batch key wrap / unwrap item */
+typedef struct {
+    const PLAT_UI8 *pInput;
+    PLAT_UI32 input_length;
+    PLAT_UI8 *pOutput;
+    PLAT_UI32 output_length;  /* in : output buffer size, out : output length */
+    stse_ReturnCode_t result; /* Output : STSE_OK or STSE_PLATFORM_KEYWRAP_ERROR */
+} stse_platform_nist_kw_item_t;
+
+#if defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_HOST_SESSION)
+
+/**
+ * \brief  Set up a CMAC session context (AES key expansion and subkey derivation)
+ * \param  pSession : session context
+ * \param  pKey : AES key
+ * \param  key_length : AES key length
+ * \param  tag_size : MAC size
+ * \return STSE_OK on success, STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_aes_cmac_session_init(stse_platform_aes_cmac_session_t *pSession,
+                                                      const PLAT_UI8 *pKey,
+                                                      PLAT_UI16 key_length,
+                                                      PLAT_UI16 tag_size);
+
+/**
+ * \brief  Start a command MAC from a clone of the session context
+ * \details The MAC is then continued with stse_platform_aes_cmac_append() and
+ *          stse_platform_aes_cmac_compute_finish() / stse_platform_aes_cmac_verify_finish().
+ *          The session must stay set up until the command MAC is finished.
+ * \param  pSession : session context
+ * \return STSE_OK on success, STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_aes_cmac_session_start(const stse_platform_aes_cmac_session_t *pSession);
+
+/**
+ * \brief  Compute the MAC of a message with a session context
+ * \param  pSession : session context
+ * \param  pPayload : message
+ * \param  payload_length : message length
+ * \param  pTag : MAC output
+ * \param  pTag_length : MAC length
+ * \return STSE_OK on success, STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_aes_cmac_session_compute(const stse_platform_aes_cmac_session_t *pSession,
+                                                         const PLAT_UI8 *pPayload,
+                                                         PLAT_UI16 payload_length,
+                                                         PLAT_UI8 *pTag,
+                                                         PLAT_UI16 *pTag_length);
+
+/**
+ * \brief  Verify the MAC of a message with a session context
+ * \param  pSession : session context
+ * \param  pPayload : message
+ * \param  payload_length : message length
+ * \param  pTag : MAC to verify (session tag size)
+ * \return STSE_OK on success, STSE_PLATFORM_AES_CMAC_VERIFY_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_aes_cmac_session_verify(const stse_platform_aes_cmac_session_t *pSession,
+                                                        const PLAT_UI8 *pPayload,
+                                                        PLAT_UI16 payload_length,
+                                                        const PLAT_UI8 *pTag);
+
+/**
+ * \brief  Release a session context and wipe its key material
+ * \param  pSession : session context
+ */
+void stse_platform_aes_cmac_session_clear(stse_platform_aes_cmac_session_t *pSession);
+
+/**
+ * \brief  End the cached key session of stse_platform_aes_cmac_init/compute/verify
+ * \details The key based CMAC functions keep the context and a copy of the last key
+ *          to detect key changes. Call at host session close : both are wiped and
+ *          the next call sets the key up again.
+ */
+void stse_platform_aes_cmac_key_session_end(void);
+
+/**
+ * \brief  Known-answer check of the cloned CMAC session contexts
+ * \details Session contexts are cloned by struct copy, which CMOX does not document.
+ *          Session compute, verify and streamed MACs are compared with the one-shot
+ *          cmox_mac_compute() for 128 and 256-bit keys.
+ * \return STSE_OK if the results match, STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_aes_cmac_check(void);
+
+#endif /* STSE_CONF_USE_HOST_KEY_ESTABLISHMENT || STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT || STSE_CONF_USE_HOST_SESSION */
+
+#if defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_HOST_SESSION)
+
+/**
+ * \brief  CBC encrypt a command payload and append the ciphertext to the running CMAC
+ * \details Single pass replacement of stse_platform_aes_cbc_enc() followed by
+ *          stse_platform_aes_cmac_append() on the ciphertext : each chunk is MACed
+ *          while still in cache after its encryption. The CMAC must have been started
+ *          with stse_platform_aes_cmac_init() or stse_platform_aes_cmac_session_start().
+ * \param  pPlaintext : plaintext (AES block multiple)
+ * \param  plaintext_length : plaintext length
+ * \param  pInitial_value : CBC initial value (16 bytes)
+ * \param  pKey : AES cipher key
+ * \param  key_length : AES cipher key length
+ * \param  pEncryptedtext : ciphertext output
+ * \param  pEncryptedtext_length : in : output buffer size, out : ciphertext length
+ * \return STSE_OK on success, STSE_PLATFORM_AES_CBC_ENCRYPT_ERROR or
+ *         STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_aes_cbc_enc_cmac_append(const PLAT_UI8 *pPlaintext,
+                                                        PLAT_UI16 plaintext_length,
+                                                        PLAT_UI8 *pInitial_value,
+                                                        const PLAT_UI8 *pKey,
+                                                        PLAT_UI16 key_length,
+                                                        PLAT_UI8 *pEncryptedtext,
+                                                        PLAT_UI16 *pEncryptedtext_length);
+
+/**
+ * \brief  Append a response ciphertext to the running CMAC, verify the MAC and CBC decrypt
+ * \details Single pass : each chunk is MACed then deciphered. The ciphertext must be the
+ *          last MACed data of the response. The plaintext is only released when the MAC
+ *          is verified, it is wiped otherwise.
+ * \param  pEncryptedtext : ciphertext (AES block multiple)
+ * \param  encryptedtext_length : ciphertext length
+ * \param  pInitial_value : CBC initial value (16 bytes)
+ * \param  pKey : AES cipher key
+ * \param  key_length : AES cipher key length
+ * \param  pTag : expected MAC
+ * \param  pPlaintext : plaintext output
+ * \param  pPlaintext_length : in : output buffer size, out : plaintext length
+ * \return STSE_OK on success, STSE_PLATFORM_AES_CMAC_VERIFY_ERROR or
+ *         STSE_PLATFORM_AES_CBC_DECRYPT_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_aes_cmac_verify_cbc_dec(const PLAT_UI8 *pEncryptedtext,
+                                                        PLAT_UI16 encryptedtext_length,
+                                                        PLAT_UI8 *pInitial_value,
+                                                        const PLAT_UI8 *pKey,
+                                                        PLAT_UI16 key_length,
+                                                        PLAT_UI8 *pTag,
+                                                        PLAT_UI8 *pPlaintext,
+                                                        PLAT_UI16 *pPlaintext_length);
+
+#endif /* STSE_CONF_USE_HOST_KEY_ESTABLISHMENT || STSE_CONF_USE_HOST_SESSION */
+
+#if defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED) ||               \
+    defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED) || \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED) ||          \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED)
+
+/**
+ * \brief  Set up a key wrap session context (KEK expansion for wrapping and unwrapping)
+ * \param  pSession : session context
+ * \param  pKek : key encryption key
+ * \param  kek_length : key encryption key length
+ * \return STSE_OK on success, STSE_PLATFORM_KEYWRAP_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_nist_kw_session_init(stse_platform_nist_kw_session_t *pSession,
+                                                     const PLAT_UI8 *pKek,
+                                                     PLAT_UI8 kek_length);
+
+/**
+ * \brief  Wrap a key with a session context
+ * \param  pSession : session context
+ * \param  pPayload : key to wrap (semiblock multiple, 16 bytes minimum)
+ * \param  payload_length : key length
+ * \param  pOutput : wrapped key output (payload length + 8 bytes)
+ * \param  pOutput_length : in : output buffer size, out : wrapped key length
+ * \return STSE_OK on success, STSE_PLATFORM_KEYWRAP_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_nist_kw_session_wrap(const stse_platform_nist_kw_session_t *pSession,
+                                                     const PLAT_UI8 *pPayload,
+                                                     PLAT_UI32 payload_length,
+                                                     PLAT_UI8 *pOutput,
+                                                     PLAT_UI32 *pOutput_length);
+
+/**
+ * \brief  Unwrap a key with a session context and check its integrity
+ * \param  pSession : session context
+ * \param  pWrapped : wrapped key
+ * \param  wrapped_length : wrapped key length
+ * \param  pOutput : key output (wrapped length - 8 bytes), wiped if the integrity check fails
+ * \param  pOutput_length : in : output buffer size, out : key length
+ * \return STSE_OK on success, STSE_PLATFORM_KEYWRAP_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_nist_kw_session_unwrap(const stse_platform_nist_kw_session_t *pSession,
+                                                       const PLAT_UI8 *pWrapped,
+                                                       PLAT_UI32 wrapped_length,
+                                                       PLAT_UI8 *pOutput,
+                                                       PLAT_UI32 *pOutput_length);
+
+/**
+ * \brief  Wrap a batch of keys under the session KEK
+ * \details Each item result and output length are reported in the item.
+ * \param  pSession : session context
+ * \param  pItems : (key, wrapped key output) items
+ * \param  item_count : number of items
+ * \param  pFailed_count : number of items not wrapped (can be NULL)
+ * \return STSE_OK if all the items are wrapped, STSE_PLATFORM_KEYWRAP_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_nist_kw_wrap_batch(const stse_platform_nist_kw_session_t *pSession,
+                                                   stse_platform_nist_kw_item_t *pItems,
+                                                   PLAT_UI16 item_count,
+                                                   PLAT_UI16 *pFailed_count);
+
+/**
+ * \brief  Unwrap a batch of keys under the session KEK
+ * \details Each item result and output length are reported in the item.
+ * \param  pSession : session context
+ * \param  pItems : (wrapped key, key output) items
+ * \param  item_count : number of items
+ * \param  pFailed_count : number of items not unwrapped (can be NULL)
+ * \return STSE_OK if all the items are unwrapped, STSE_PLATFORM_KEYWRAP_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_nist_kw_unwrap_batch(const stse_platform_nist_kw_session_t *pSession,
+                                                     stse_platform_nist_kw_item_t *pItems,
+                                                     PLAT_UI16 item_count,
+                                                     PLAT_UI16 *pFailed_count);
+
+/**
+ * \brief  Release a key wrap session context and wipe its key material
+ * \param  pSession : session context
+ */
+void stse_platform_nist_kw_session_clear(stse_platform_nist_kw_session_t *pSession);
+
+/**
+ * \brief  Unwrap a key (one shot counterpart of stse_platform_nist_kw_encrypt)
+ * \param  pPayload : wrapped key
+ * \param  payload_length : wrapped key length
+ * \param  pKey : key encryption key
+ * \param  key_length : key encryption key length
+ * \param  pOutput : key output
+ * \param  pOutput_length : in : output buffer size, out : key length
+ * \return STSE_OK on success, STSE_PLATFORM_KEYWRAP_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_nist_kw_decrypt(PLAT_UI8 *pPayload, PLAT_UI32 payload_length,
+                                                PLAT_UI8 *pKey, PLAT_UI8 key_length,
+                                                PLAT_UI8 *pOutput, PLAT_UI32 *pOutput_length);
+
+#endif /* STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED || STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED ||
+          STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED || STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STSE_PLATFORM_AES_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -15,19 +15,66 @@
  ******************************************************************************
  */
 
+#include "Drivers/cycle_counter/cycle_counter.h"
 #include "Drivers/delay_ms/delay_ms.h"
 #include "Drivers/delay_us/delay_us.h"
 #include "stse_conf.h"
+#include "stse_platform_delay.h"
 #include "stselib.h"
 
+static stse_platform_delay_idle_hook_t delay_idle_hook = NULL;
+static volatile PLAT_UI8 delay_idle_hook_running = 0;
+/* Target processing time already lent from the polling path, deducted from the next delay */
+static PLAT_UI32 delay_idle_credit_ms = 0;
+
 stse_ReturnCode_t stse_platform_delay_init(void) {
     /* Initialize platform Drivers used by PAL */
     delay_ms_init();
+    cycle_counter_init();
 
     return STSE_OK;
 }
 
+void stse_platform_delay_set_idle_hook(stse_platform_delay_idle_hook_t hook) {
+    delay_idle_hook = hook;
+}
+
+PLAT_UI32 stse_platform_delay_yield(PLAT_UI32 delay_val) {
+    PLAT_UI32 start;
+    PLAT_UI32 elapsed_ms;
+
+    if ((delay_idle_hook == NULL) || (delay_idle_hook_running != 0)) {
+        return 0;
+    }
+
+    delay_idle_hook_running = 1;
+    start = cycle_counter_get();
+    delay_idle_hook(delay_val);
+    elapsed_ms = cycle_counter_to_ms(cycle_counter_get() - start);
+    delay_idle_hook_running = 0;
+
+    return elapsed_ms;
+}
+
+void stse_platform_delay_yield_poll(PLAT_UI32 delay_val) {
+    delay_idle_credit_ms = stse_platform_delay_yield(delay_val);
+}
+
 void stse_platform_Delay_ms(PLAT_UI32 delay_val) {
+    PLAT_UI32 elapsed_ms;
+
+    /* - Lend the target processing time to the idle hook */
+    if (delay_idle_hook_running == 0) {
+        elapsed_ms = delay_idle_credit_ms + stse_platform_delay_yield(delay_val);
+        delay_idle_credit_ms = 0;
+
+        /* - Only wait for the remaining part of the delay */
+        if (elapsed_ms >= delay_val) {
+            return;
+        }
+        delay_val -= elapsed_ms;
+    }
+
     delay_ms(delay_val);
 }
 
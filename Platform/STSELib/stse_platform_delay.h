@@ -0,0 +1,68 @@
+/******************************************************************************
+ * \file	stse_platform_delay.h
+ * \brief   STSecureElement delay platform extensions
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STSE_PLATFORM_DELAY_H
+#define STSE_PLATFORM_DELAY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stse_platform_generic.h"
+
+/**
+ * \brief  Idle hook called when STSELib waits for the target processing time
+ *         and when a response poll is not acknowledged
+ * \param  delay_val : requested delay in milliseconds
+ * \note   The time spent in the hook is deducted from the requested delay.
+ *         Byte transfers are polled by the CPU and stay serialized : only
+ *         target processing and response polling time is interleaved.
+ *         The hook is never re-entered : delays requested from inside the hook
+ *         are plain blocking delays.
+ */
+typedef void (*stse_platform_delay_idle_hook_t)(PLAT_UI32 delay_val);
+
+/**
+ * \brief  Install (or remove with NULL) the delay idle hook
+ * \param  hook : idle hook function
+ */
+void stse_platform_delay_set_idle_hook(stse_platform_delay_idle_hook_t hook);
+
+/**
+ * \brief  Run the idle hook once without waiting
+ * \param  delay_val : time the caller can lend, in milliseconds
+ * \return Time spent in the hook in milliseconds (0 if no hook or already in the hook)
+ */
+PLAT_UI32 stse_platform_delay_yield(PLAT_UI32 delay_val);
+
+/**
+ * \brief  Yield point of the response polling loop
+ * \details Called by the bus layer when the target does not acknowledge its response
+ *          read (command still processing). The time spent in the hook is deducted
+ *          from the next polling delay requested by STSELib.
+ * \param  delay_val : time the caller can lend, in milliseconds
+ */
+void stse_platform_delay_yield_poll(PLAT_UI32 delay_val);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STSE_PLATFORM_DELAY_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
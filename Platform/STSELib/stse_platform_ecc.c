@@ -15,129 +15,405 @@
  ******************************************************************************
  */
 
+#include "Drivers/ram_arena/ram_arena.h"
 #include "Middleware/STM32_Cryptographic/include/cmox_crypto.h"
 #include "stse_conf.h"
+#include "stse_platform_ecc.h"
+#include "stse_platform_profiler.h"
+#include "stse_platform_scratch.h"
 #include "stselib.h"
 
-cmox_ecc_handle_t Ecc_Ctx;
-PLAT_UI8 cmox_math_buffer[2400];
+/* Pooled ECC context : constructed on first use, kept across operations */
+typedef struct {
+    cmox_ecc_handle_t handle;
+    cmox_math_funcs_t math_funcs; /* Math functions the handle is constructed with (NULL = not constructed) */
+    stse_ecc_key_type_t key_type; /* Curve of the running operation */
+    PLAT_UI8 profile;             /* Profile of the running operation (math buffer bound index) */
+    PLAT_UI8 in_use;
+    PLAT_UI8 math_buffer[STSE_PLATFORM_ECC_MATH_BUFFER_SIZE] __ALIGNED(4);
+} stse_platform_ecc_context_t;
 
-static cmox_ecc_impl_t stse_platform_get_cmox_ecc_impl(stse_ecc_key_type_t key_type) {
-    switch (key_type) {
-#ifdef STSE_CONF_ECC_NIST_P_256
-    case STSE_ECC_KT_NIST_P_256:
-        return CMOX_ECC_SECP256R1_LOWMEM;
-#endif
-#ifdef STSE_CONF_ECC_NIST_P_384
-    case STSE_ECC_KT_NIST_P_384:
-        return CMOX_ECC_SECP384R1_LOWMEM;
-#endif
-#ifdef STSE_CONF_ECC_NIST_P_521
-    case STSE_ECC_KT_NIST_P_521:
-        return CMOX_ECC_SECP521R1_LOWMEM;
-#endif
-#ifdef STSE_CONF_ECC_BRAINPOOL_P_256
-    case STSE_ECC_KT_BP_P_256:
-        return CMOX_ECC_BPP256R1_LOWMEM;
-#endif
-#ifdef STSE_CONF_ECC_BRAINPOOL_P_384
-    case STSE_ECC_KT_BP_P_384:
-        return CMOX_ECC_BPP384R1_LOWMEM;
-#endif
-#ifdef STSE_CONF_ECC_BRAINPOOL_P_512
-    case STSE_ECC_KT_BP_P_512:
-        return CMOX_ECC_BPP512R1_LOWMEM;
-#endif
-#ifdef STSE_CONF_ECC_CURVE_25519
-    case STSE_ECC_KT_CURVE25519:
-        return CMOX_ECC_CURVE25519;
-#endif
-#ifdef STSE_CONF_ECC_EDWARD_25519
-    case STSE_ECC_KT_ED25519:
-        return CMOX_ECC_ED25519_OPT_LOWMEM;
+static stse_platform_ecc_context_t ecc_context_pool[STSE_CONF_ECC_CONTEXT_POOL_SIZE] RAM2_CRYPTO;
+static stse_platform_ecc_pool_stats_t ecc_pool_stats;
+
+/* Math buffer bytes touched per curve and profile (0 = not learned yet) : the release
+ * wipes up to this bound and checks the guard word above it instead of scanning */
+static PLAT_UI32 ecc_math_bound[STSE_ECC_KT_INVALID][STSE_PLATFORM_ECC_PROFILE_FAST + 1];
+static PLAT_UI32 ecc_math_release_count;
+
+/* - Profile selection : runtime per curve, or fixed at compile time (unused implementations not linked) */
+#ifdef STSE_CONF_ECC_PROFILE_RUNTIME
+static stse_platform_ecc_profile_t ecc_profiles[STSE_ECC_KT_INVALID];
+static PLAT_UI8 ecc_profiles_initialized = 0;
+
+#define STSE_PLATFORM_ECC_SELECT(key_type, small, fast) \
+    ((stse_platform_ecc_get_profile(key_type) == STSE_PLATFORM_ECC_PROFILE_FAST) ? (fast) : (small))
+#elif defined(STSE_CONF_ECC_PROFILE_FAST)
+#define STSE_PLATFORM_ECC_SELECT(key_type, small, fast) (fast)
+#else
+#define STSE_PLATFORM_ECC_SELECT(key_type, small, fast) (small)
 #endif
-    default:
-        return NULL;
+
+stse_ReturnCode_t stse_platform_ecc_set_profile(stse_ecc_key_type_t key_type, stse_platform_ecc_profile_t profile) {
+#ifdef STSE_CONF_ECC_PROFILE_RUNTIME
+    if ((key_type >= STSE_ECC_KT_INVALID) || (profile > STSE_PLATFORM_ECC_PROFILE_FAST)) {
+        return STSE_PLATFORM_INVALID_PARAMETER;
     }
+
+    (void)stse_platform_ecc_get_profile(key_type);
+    ecc_profiles[key_type] = profile;
+
+    return STSE_OK;
+#else
+    return (profile == STSE_PLATFORM_ECC_PROFILE_DEFAULT) ? STSE_OK : STSE_PLATFORM_INVALID_PARAMETER;
+#endif /* STSE_CONF_ECC_PROFILE_RUNTIME */
 }
 
-static size_t stse_platform_get_cmox_ecc_pub_key_len(stse_ecc_key_type_t key_type) {
-    switch (key_type) {
-#ifdef STSE_CONF_ECC_NIST_P_256
-    case STSE_ECC_KT_NIST_P_256:
-        return CMOX_ECC_SECP256R1_PUBKEY_LEN;
-#endif
-#ifdef STSE_CONF_ECC_NIST_P_384
-    case STSE_ECC_KT_NIST_P_384:
-        return CMOX_ECC_SECP384R1_PUBKEY_LEN;
-#endif
-#ifdef STSE_CONF_ECC_NIST_P_521
-    case STSE_ECC_KT_NIST_P_521:
-        return CMOX_ECC_SECP521R1_PUBKEY_LEN;
-#endif
-#ifdef STSE_CONF_ECC_BRAINPOOL_P_256
-    case STSE_ECC_KT_BP_P_256:
-        return CMOX_ECC_BPP256R1_PUBKEY_LEN;
-#endif
-#ifdef STSE_CONF_ECC_BRAINPOOL_P_384
-    case STSE_ECC_KT_BP_P_384:
-        return CMOX_ECC_BPP384R1_PUBKEY_LEN;
-#endif
-#ifdef STSE_CONF_ECC_BRAINPOOL_P_512
-    case STSE_ECC_KT_BP_P_512:
-        return CMOX_ECC_BPP512R1_PUBKEY_LEN;
-#endif
-#ifdef STSE_CONF_ECC_CURVE_25519
-    case STSE_ECC_KT_CURVE25519:
-        return CMOX_ECC_CURVE25519_PUBKEY_LEN;
-#endif
-#ifdef STSE_CONF_ECC_EDWARD_25519
-    case STSE_ECC_KT_ED25519:
-        return CMOX_ECC_ED25519_PUBKEY_LEN;
-#endif
-    default:
-        return 0u;
+stse_platform_ecc_profile_t stse_platform_ecc_get_profile(stse_ecc_key_type_t key_type) {
+#ifdef STSE_CONF_ECC_PROFILE_RUNTIME
+    /* - Apply the compile time default on first use */
+    if (!ecc_profiles_initialized) {
+        for (PLAT_UI8 i = 0; i < STSE_ECC_KT_INVALID; i++) {
+            ecc_profiles[i] = STSE_PLATFORM_ECC_PROFILE_DEFAULT;
+        }
+        ecc_profiles_initialized = 1;
+    }
+
+    if (key_type >= STSE_ECC_KT_INVALID) {
+        return STSE_PLATFORM_ECC_PROFILE_DEFAULT;
     }
+
+    return ecc_profiles[key_type];
+#else
+    (void)key_type;
+    return STSE_PLATFORM_ECC_PROFILE_DEFAULT;
+#endif /* STSE_CONF_ECC_PROFILE_RUNTIME */
 }
 
-static size_t stse_platform_get_cmox_ecc_sig_len(stse_ecc_key_type_t key_type) {
-    switch (key_type) {
+static cmox_math_funcs_t stse_platform_get_cmox_math_funcs(stse_ecc_key_type_t key_type) {
+    (void)key_type;
+    return STSE_PLATFORM_ECC_SELECT(key_type, CMOX_MATH_FUNCS_SMALL, CMOX_MATH_FUNCS_FAST);
+}
+
+/* Curve descriptor : only the implementations of the linked profiles are referenced */
+typedef struct {
+#ifdef STSE_CONF_ECC_PROFILE_RUNTIME
+    const cmox_ecc_impl_t *pImpl_small; /* LOWMEM implementation, NULL when the curve is not enabled */
+    const cmox_ecc_impl_t *pImpl_fast;  /* HIGHMEM implementation */
+#else
+    const cmox_ecc_impl_t *pImpl; /* Implementation of the compile time profile, NULL when the curve is not enabled */
+#endif
+    PLAT_UI8 priv_key_len;
+    PLAT_UI8 pub_key_len;
+    PLAT_UI8 sig_len;    /* 0 when the curve has no signature scheme */
+    PLAT_UI8 random_len; /* RNG input of key generation and signature (private key length, word aligned) */
+} stse_platform_ecc_curve_t;
+
+#define STSE_PLATFORM_ECC_RANDOM_LEN(priv_key_len) ((priv_key_len) + (4U - ((priv_key_len) & 0x3U)))
+#ifdef STSE_CONF_ECC_PROFILE_RUNTIME
+#define STSE_PLATFORM_ECC_CURVE(small, fast, priv_key_len, pub_key_len, sig_len) \
+    {&(small), &(fast), (priv_key_len), (pub_key_len), (sig_len), STSE_PLATFORM_ECC_RANDOM_LEN(priv_key_len)}
+#elif defined(STSE_CONF_ECC_PROFILE_FAST)
+#define STSE_PLATFORM_ECC_CURVE(small, fast, priv_key_len, pub_key_len, sig_len) \
+    {&(fast), (priv_key_len), (pub_key_len), (sig_len), STSE_PLATFORM_ECC_RANDOM_LEN(priv_key_len)}
+#else
+#define STSE_PLATFORM_ECC_CURVE(small, fast, priv_key_len, pub_key_len, sig_len) \
+    {&(small), (priv_key_len), (pub_key_len), (sig_len), STSE_PLATFORM_ECC_RANDOM_LEN(priv_key_len)}
+#endif
+
+/* Descriptors of the enabled curves, indexed by key type (disabled curves are not linked) */
+static const stse_platform_ecc_curve_t ecc_curves[STSE_ECC_KT_INVALID] = {
 #ifdef STSE_CONF_ECC_NIST_P_256
-    case STSE_ECC_KT_NIST_P_256:
-        return CMOX_ECC_SECP256R1_SIG_LEN;
+    [STSE_ECC_KT_NIST_P_256] = STSE_PLATFORM_ECC_CURVE(CMOX_ECC_SECP256R1_LOWMEM, CMOX_ECC_SECP256R1_HIGHMEM,
+                                                       CMOX_ECC_SECP256R1_PRIVKEY_LEN, CMOX_ECC_SECP256R1_PUBKEY_LEN, CMOX_ECC_SECP256R1_SIG_LEN),
 #endif
 #ifdef STSE_CONF_ECC_NIST_P_384
-    case STSE_ECC_KT_NIST_P_384:
-        return CMOX_ECC_SECP384R1_SIG_LEN;
+    [STSE_ECC_KT_NIST_P_384] = STSE_PLATFORM_ECC_CURVE(CMOX_ECC_SECP384R1_LOWMEM, CMOX_ECC_SECP384R1_HIGHMEM,
+                                                       CMOX_ECC_SECP384R1_PRIVKEY_LEN, CMOX_ECC_SECP384R1_PUBKEY_LEN, CMOX_ECC_SECP384R1_SIG_LEN),
 #endif
 #ifdef STSE_CONF_ECC_NIST_P_521
-    case STSE_ECC_KT_NIST_P_521:
-        return CMOX_ECC_SECP521R1_SIG_LEN;
+    [STSE_ECC_KT_NIST_P_521] = STSE_PLATFORM_ECC_CURVE(CMOX_ECC_SECP521R1_LOWMEM, CMOX_ECC_SECP521R1_HIGHMEM,
+                                                       CMOX_ECC_SECP521R1_PRIVKEY_LEN, CMOX_ECC_SECP521R1_PUBKEY_LEN, CMOX_ECC_SECP521R1_SIG_LEN),
 #endif
 #ifdef STSE_CONF_ECC_BRAINPOOL_P_256
-    case STSE_ECC_KT_BP_P_256:
-        return CMOX_ECC_BPP256R1_SIG_LEN;
+    [STSE_ECC_KT_BP_P_256] = STSE_PLATFORM_ECC_CURVE(CMOX_ECC_BPP256R1_LOWMEM, CMOX_ECC_BPP256R1_HIGHMEM,
+                                                     CMOX_ECC_BPP256R1_PRIVKEY_LEN, CMOX_ECC_BPP256R1_PUBKEY_LEN, CMOX_ECC_BPP256R1_SIG_LEN),
 #endif
 #ifdef STSE_CONF_ECC_BRAINPOOL_P_384
-    case STSE_ECC_KT_BP_P_384:
-        return CMOX_ECC_BPP384R1_SIG_LEN;
+    [STSE_ECC_KT_BP_P_384] = STSE_PLATFORM_ECC_CURVE(CMOX_ECC_BPP384R1_LOWMEM, CMOX_ECC_BPP384R1_HIGHMEM,
+                                                     CMOX_ECC_BPP384R1_PRIVKEY_LEN, CMOX_ECC_BPP384R1_PUBKEY_LEN, CMOX_ECC_BPP384R1_SIG_LEN),
 #endif
 #ifdef STSE_CONF_ECC_BRAINPOOL_P_512
-    case STSE_ECC_KT_BP_P_512:
-        return CMOX_ECC_BPP512R1_SIG_LEN;
+    [STSE_ECC_KT_BP_P_512] = STSE_PLATFORM_ECC_CURVE(CMOX_ECC_BPP512R1_LOWMEM, CMOX_ECC_BPP512R1_HIGHMEM,
+                                                     CMOX_ECC_BPP512R1_PRIVKEY_LEN, CMOX_ECC_BPP512R1_PUBKEY_LEN, CMOX_ECC_BPP512R1_SIG_LEN),
 #endif
 #ifdef STSE_CONF_ECC_CURVE_25519
-    case STSE_ECC_KT_CURVE25519:
-        return STSE_OK; /* No signature with curve25519 */
+    [STSE_ECC_KT_CURVE25519] = STSE_PLATFORM_ECC_CURVE(CMOX_ECC_CURVE25519, CMOX_ECC_CURVE25519, /* Single implementation */
+                                                       CMOX_ECC_CURVE25519_PRIVKEY_LEN, CMOX_ECC_CURVE25519_PUBKEY_LEN, 0),
 #endif
 #ifdef STSE_CONF_ECC_EDWARD_25519
-    case STSE_ECC_KT_ED25519:
-        return CMOX_ECC_ED25519_SIG_LEN;
+    [STSE_ECC_KT_ED25519] = STSE_PLATFORM_ECC_CURVE(CMOX_ECC_ED25519_OPT_LOWMEM, CMOX_ECC_ED25519_OPT_HIGHMEM,
+                                                    CMOX_ECC_ED25519_PRIVKEY_LEN, CMOX_ECC_ED25519_PUBKEY_LEN, CMOX_ECC_ED25519_SIG_LEN),
+#endif
+};
+
+static const stse_platform_ecc_curve_t ecc_curve_none = {0};
+
+/**
+ * \brief  Get the descriptor of a curve (single indexed lookup)
+ * \param  key_type : curve
+ * \return curve descriptor, with NULL implementations if the curve is not enabled
+ */
+static const stse_platform_ecc_curve_t *stse_platform_ecc_get_curve(stse_ecc_key_type_t key_type) {
+    return (key_type < STSE_ECC_KT_INVALID) ? &ecc_curves[key_type] : &ecc_curve_none;
+}
+
+/**
+ * \brief  Get the CMOX implementation of a curve for its current profile
+ */
+static cmox_ecc_impl_t stse_platform_ecc_get_impl(const stse_platform_ecc_curve_t *pCurve, stse_ecc_key_type_t key_type) {
+    (void)key_type;
+#ifdef STSE_CONF_ECC_PROFILE_RUNTIME
+    if (pCurve->pImpl_small == NULL) {
+        return NULL;
+    }
+    return STSE_PLATFORM_ECC_SELECT(key_type, *pCurve->pImpl_small, *pCurve->pImpl_fast);
+#else
+    return (pCurve->pImpl == NULL) ? NULL : *pCurve->pImpl;
 #endif
-    default:
-        return 0u;
+}
+
+/**
+ * \brief  Acquire a free pooled ECC context constructed for the curve profile
+ * \param  key_type : curve
+ * \return ECC context, NULL if all the contexts are in use
+ */
+static stse_platform_ecc_context_t *stse_platform_ecc_acquire(stse_ecc_key_type_t key_type) {
+    cmox_math_funcs_t math_funcs = stse_platform_get_cmox_math_funcs(key_type);
+    stse_platform_ecc_context_t *pCtx = NULL;
+    PLAT_UI32 primask = __get_PRIMASK();
+    PLAT_UI8 in_use = 0;
+
+    /* - Reserve a context (callers may run from interrupt or task context) */
+    __disable_irq();
+    for (PLAT_UI8 i = 0; i < STSE_CONF_ECC_CONTEXT_POOL_SIZE; i++) {
+        if (ecc_context_pool[i].in_use) {
+            in_use++;
+        } else if (pCtx == NULL) {
+            pCtx = &ecc_context_pool[i];
+            pCtx->in_use = 1;
+            in_use++;
+        }
+    }
+    if (pCtx != NULL) {
+        ecc_pool_stats.acquire_count++;
+        if (in_use > ecc_pool_stats.max_in_use) {
+            ecc_pool_stats.max_in_use = in_use;
+        }
+    } else {
+        ecc_pool_stats.exhausted_count++;
     }
+    __set_PRIMASK(primask);
+
+    /* - Construct only on first use or profile change */
+    if ((pCtx != NULL) && (pCtx->math_funcs != math_funcs)) {
+        if (pCtx->math_funcs != NULL) {
+            cmox_ecc_cleanup(&pCtx->handle);
+        }
+        cmox_ecc_construct(&pCtx->handle,            /* ECC context */
+                           math_funcs,               /* Profile math functions */
+                           pCtx->math_buffer,        /* Crypto math buffer */
+                           sizeof(pCtx->math_buffer) /* buffer size */
+        );
+        pCtx->math_funcs = math_funcs;
+        ecc_pool_stats.construct_count++;
+    }
+    if (pCtx != NULL) {
+        pCtx->key_type = key_type;
+        pCtx->profile = (PLAT_UI8)STSE_PLATFORM_ECC_SELECT(key_type, STSE_PLATFORM_ECC_PROFILE_SMALL, STSE_PLATFORM_ECC_PROFILE_FAST);
+    }
+
+    return pCtx;
+}
+
+/**
+ * \brief  Return an ECC context to the pool
+ * \param  pCtx : ECC context
+ * \param  retval : CMOX status of the operation (math buffer size check)
+ */
+static void stse_platform_ecc_release(stse_platform_ecc_context_t *pCtx, cmox_ecc_retval_t retval) {
+    PLAT_UI32 primask = __get_PRIMASK();
+    PLAT_UI32 *pBound = NULL;
+    PLAT_UI32 bound = 0;
+    PLAT_UI32 wiped;
+    PLAT_UI8 full_scan;
+
+    /* - Learned bound of the curve profile, full scan every STSE_PLATFORM_ECC_MATH_FULL_SCAN_PERIOD releases */
+    __disable_irq();
+    if (pCtx->key_type < STSE_ECC_KT_INVALID) {
+        pBound = &ecc_math_bound[pCtx->key_type][pCtx->profile];
+        bound = *pBound;
+    }
+    full_scan = ((++ecc_math_release_count % STSE_PLATFORM_ECC_MATH_FULL_SCAN_PERIOD) == 0);
+    __set_PRIMASK(primask);
+
+    /* - Wipe the intermediates left in the math buffer up to the bound (guard word
+     *   checked, scan from the end on a guard hit, unknown bound or periodic check) */
+    wiped = stse_platform_scratch_wipe_touched(pCtx->math_buffer, sizeof(pCtx->math_buffer), bound, full_scan);
+
+    __disable_irq();
+    if (retval == CMOX_ECC_ERR_MEMORY_FAIL) {
+        ecc_pool_stats.math_fail_count++;
+    }
+    if ((wiped > bound) || (bound == 0) || full_scan) {
+        ecc_pool_stats.math_scan_count++;
+    }
+    if ((pBound != NULL) && (wiped > *pBound)) {
+        *pBound = wiped;
+    }
+    if (wiped > ecc_pool_stats.math_buffer_hwm) {
+        ecc_pool_stats.math_buffer_hwm = wiped;
+    }
+    pCtx->in_use = 0;
+    __set_PRIMASK(primask);
+}
+
+void stse_platform_ecc_get_pool_stats(stse_platform_ecc_pool_stats_t *pStats) {
+    *pStats = ecc_pool_stats;
+}
+
+#if (STSE_CONF_ECC_VERIFY_CACHE_BUDGET > 0)
+/* Successful verification, identified by SHA-256(key type || SHA-256(public key) || digest || signature) */
+typedef struct {
+    PLAT_UI8 fingerprint[32];
+    PLAT_UI8 pub_key_tag[8]; /* Truncated SHA-256(public key), for invalidation */
+    PLAT_UI32 last_use;      /* LRU stamp, 0 = free entry */
+} stse_platform_ecc_verify_cache_entry_t;
+
+_Static_assert(sizeof(stse_platform_ecc_verify_cache_entry_t) == STSE_PLATFORM_ECC_VERIFY_CACHE_ENTRY_SIZE,
+               "Verification cache entry size mismatch");
+
+static stse_platform_ecc_verify_cache_entry_t ecc_verify_cache[STSE_PLATFORM_ECC_VERIFY_CACHE_ENTRIES];
+static PLAT_UI32 ecc_verify_cache_clock;
+static stse_platform_ecc_verify_cache_stats_t ecc_verify_cache_stats;
+
+/**
+ * \brief  Compute the public key tag and the fingerprint of a verification triple
+ * \return STSE_OK on success, STSE_PLATFORM_HASH_ERROR otherwise (verification not cached)
+ */
+static stse_ReturnCode_t stse_platform_ecc_verify_cache_fingerprint(stse_ecc_key_type_t key_type,
+                                                                     const PLAT_UI8 *pPubKey, size_t pub_key_len,
+                                                                     const PLAT_UI8 *pDigest, PLAT_UI16 digestLen,
+                                                                     const PLAT_UI8 *pSignature, size_t sig_len,
+                                                                     PLAT_UI8 *pPub_key_tag, PLAT_UI8 *pFingerprint) {
+    cmox_sha256_handle_t sha256_handle;
+    cmox_hash_handle_t *pHash;
+    PLAT_UI8 pub_key_hash[CMOX_SHA256_SIZE];
+    PLAT_UI8 kt = (PLAT_UI8)key_type;
+    cmox_hash_retval_t retval;
+
+    retval = cmox_hash_compute(CMOX_SHA256_ALGO, pPubKey, pub_key_len, pub_key_hash, sizeof(pub_key_hash), NULL);
+    if (retval != CMOX_HASH_SUCCESS) {
+        return STSE_PLATFORM_HASH_ERROR;
+    }
+    memcpy(pPub_key_tag, pub_key_hash, 8);
+
+    pHash = cmox_sha256_construct(&sha256_handle);
+    retval = cmox_hash_init(pHash);
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_append(pHash, &kt, 1);
+    }
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_append(pHash, pub_key_hash, sizeof(pub_key_hash));
+    }
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_append(pHash, pDigest, digestLen);
+    }
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_append(pHash, pSignature, sig_len);
+    }
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_generateTag(pHash, pFingerprint, NULL);
+    }
+    cmox_hash_cleanup(pHash);
+
+    return (retval == CMOX_HASH_SUCCESS) ? STSE_OK : STSE_PLATFORM_HASH_ERROR;
+}
+
+/**
+ * \brief  Look up a fingerprint and refresh its LRU stamp
+ * \return 1 if the verification is cached, 0 otherwise
+ */
+static PLAT_UI8 stse_platform_ecc_verify_cache_lookup(const PLAT_UI8 *pFingerprint) {
+    PLAT_UI32 primask = __get_PRIMASK();
+    PLAT_UI8 hit = 0;
+
+    __disable_irq();
+    for (PLAT_UI16 i = 0; i < STSE_PLATFORM_ECC_VERIFY_CACHE_ENTRIES; i++) {
+        if ((ecc_verify_cache[i].last_use != 0) &&
+            (memcmp(ecc_verify_cache[i].fingerprint, pFingerprint, sizeof(ecc_verify_cache[i].fingerprint)) == 0)) {
+            ecc_verify_cache[i].last_use = ++ecc_verify_cache_clock;
+            hit = 1;
+            break;
+        }
+    }
+    if (hit) {
+        ecc_verify_cache_stats.hit_count++;
+    } else {
+        ecc_verify_cache_stats.miss_count++;
+    }
+    __set_PRIMASK(primask);
+
+    return hit;
+}
+
+/**
+ * \brief  Record a successful verification, evicting the least recently used entry
+ */
+static void stse_platform_ecc_verify_cache_insert(const PLAT_UI8 *pFingerprint, const PLAT_UI8 *pPub_key_tag) {
+    PLAT_UI32 primask = __get_PRIMASK();
+    stse_platform_ecc_verify_cache_entry_t *pEntry = &ecc_verify_cache[0];
+
+    __disable_irq();
+    for (PLAT_UI16 i = 1; i < STSE_PLATFORM_ECC_VERIFY_CACHE_ENTRIES; i++) {
+        if (ecc_verify_cache[i].last_use < pEntry->last_use) {
+            pEntry = &ecc_verify_cache[i];
+        }
+    }
+    if (pEntry->last_use != 0) {
+        ecc_verify_cache_stats.eviction_count++;
+    }
+    memcpy(pEntry->fingerprint, pFingerprint, sizeof(pEntry->fingerprint));
+    memcpy(pEntry->pub_key_tag, pPub_key_tag, sizeof(pEntry->pub_key_tag));
+    pEntry->last_use = ++ecc_verify_cache_clock;
+    __set_PRIMASK(primask);
+}
+
+void stse_platform_ecc_verify_cache_invalidate(stse_ecc_key_type_t key_type, const PLAT_UI8 *pPubKey) {
+    PLAT_UI8 pub_key_tag[CMOX_SHA256_SIZE];
+    PLAT_UI32 primask;
+
+    if (pPubKey != NULL) {
+        if (cmox_hash_compute(CMOX_SHA256_ALGO, pPubKey, stse_platform_ecc_get_curve(key_type)->pub_key_len,
+                              pub_key_tag, sizeof(pub_key_tag), NULL) != CMOX_HASH_SUCCESS) {
+            pPubKey = NULL; /* Cannot identify the key entries : flush all */
+        }
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    for (PLAT_UI16 i = 0; i < STSE_PLATFORM_ECC_VERIFY_CACHE_ENTRIES; i++) {
+        if ((pPubKey == NULL) || (memcmp(ecc_verify_cache[i].pub_key_tag, pub_key_tag, sizeof(ecc_verify_cache[i].pub_key_tag)) == 0)) {
+            memset(&ecc_verify_cache[i], 0, sizeof(ecc_verify_cache[i]));
+        }
+    }
+    __set_PRIMASK(primask);
+}
+
+void stse_platform_ecc_get_verify_cache_stats(stse_platform_ecc_verify_cache_stats_t *pStats) {
+    *pStats = ecc_verify_cache_stats;
 }
+#endif /* STSE_CONF_ECC_VERIFY_CACHE_BUDGET > 0 */
 
 stse_ReturnCode_t stse_platform_ecc_verify(
     stse_ecc_key_type_t key_type,
@@ -145,55 +421,79 @@ stse_ReturnCode_t stse_platform_ecc_verify(
     PLAT_UI8 *pDigest,
     PLAT_UI16 digestLen,
     PLAT_UI8 *pSignature) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_ECC_VERIFY, digestLen);
 #if defined(STSE_CONF_ECC_NIST_P_256) || defined(STSE_CONF_ECC_NIST_P_384) || defined(STSE_CONF_ECC_NIST_P_521) ||                \
     defined(STSE_CONF_ECC_BRAINPOOL_P_256) || defined(STSE_CONF_ECC_BRAINPOOL_P_384) || defined(STSE_CONF_ECC_BRAINPOOL_P_512) || \
     defined(STSE_CONF_ECC_CURVE_25519) || defined(STSE_CONF_ECC_EDWARD_25519)
+    const stse_platform_ecc_curve_t *pCurve = stse_platform_ecc_get_curve(key_type);
+    cmox_ecc_impl_t impl = stse_platform_ecc_get_impl(pCurve, key_type);
     cmox_ecc_retval_t retval;
+    stse_platform_ecc_context_t *pCtx;
     PLAT_UI32 faultCheck;
+#if (STSE_CONF_ECC_VERIFY_CACHE_BUDGET > 0)
+    PLAT_UI8 pub_key_tag[8];
+    PLAT_UI8 fingerprint[CMOX_SHA256_SIZE];
+    stse_ReturnCode_t cache_ret;
 
-    /*- Set ECC context */
-    cmox_ecc_construct(&Ecc_Ctx,                /* ECC context */
-                       CMOX_MATH_FUNCS_SMALL,   /* Small math functions */
-                       cmox_math_buffer,        /* Crypto math buffer */
-                       sizeof(cmox_math_buffer) /* buffer size */
-    );
+    /* - Known triple : skip the ECC math */
+    cache_ret = stse_platform_ecc_verify_cache_fingerprint(key_type,
+                                                           pPubKey, pCurve->pub_key_len,
+                                                           pDigest, digestLen,
+                                                           pSignature, pCurve->sig_len,
+                                                           pub_key_tag, fingerprint);
+    if ((cache_ret == STSE_OK) && stse_platform_ecc_verify_cache_lookup(fingerprint)) {
+        return STSE_OK;
+    }
+#endif /* STSE_CONF_ECC_VERIFY_CACHE_BUDGET > 0 */
+
+    /*- Get a pooled ECC context */
+    pCtx = stse_platform_ecc_acquire(key_type);
+    if (pCtx == NULL) {
+        return STSE_PLATFORM_ECC_VERIFY_ERROR;
+    }
 
 #ifdef STSE_CONF_ECC_EDWARD_25519
     if (key_type == STSE_ECC_KT_ED25519) {
         /* - Perform EDDSA verify */
-        retval = cmox_eddsa_verify(&Ecc_Ctx,                                         /* ECC context */
-                                   stse_platform_get_cmox_ecc_impl(key_type),        /* Curve param */
-                                   pPubKey,                                          /* Public key */
-                                   stse_platform_get_cmox_ecc_pub_key_len(key_type), /* Public key length */
-                                   pDigest,                                          /* Message */
-                                   digestLen,                                        /* Message length */
-                                   pSignature,                                       /* Pointer to signature */
-                                   stse_platform_get_cmox_ecc_sig_len(key_type),     /* Signature size */
-                                   &faultCheck                                       /* Fault check variable */
+        retval = cmox_eddsa_verify(&pCtx->handle,       /* ECC context */
+                                   impl,                /* Curve param */
+                                   pPubKey,             /* Public key */
+                                   pCurve->pub_key_len, /* Public key length */
+                                   pDigest,             /* Message */
+                                   digestLen,           /* Message length */
+                                   pSignature,          /* Pointer to signature */
+                                   pCurve->sig_len,     /* Signature size */
+                                   &faultCheck          /* Fault check variable */
         );
     } else
 #endif /* STSE_CONF_ECC_EDWARD_25519 */
     {
         /* - Perform ECDSA verify */
-        retval = cmox_ecdsa_verify(&Ecc_Ctx,                                         /* ECC context */
-                                   stse_platform_get_cmox_ecc_impl(key_type),        /* Curve : SECP256R1 */
-                                   pPubKey,                                          /* Public key */
-                                   stse_platform_get_cmox_ecc_pub_key_len(key_type), /* Public key length */
-                                   pDigest,                                          /* Message */
-                                   digestLen,                                        /* Message length */
-                                   pSignature,                                       /* Pointer to signature */
-                                   stse_platform_get_cmox_ecc_sig_len(key_type),     /* Signature size */
-                                   &faultCheck                                       /* Fault check variable */
+        retval = cmox_ecdsa_verify(&pCtx->handle,       /* ECC context */
+                                   impl,                /* Curve : SECP256R1 */
+                                   pPubKey,             /* Public key */
+                                   pCurve->pub_key_len, /* Public key length */
+                                   pDigest,             /* Message */
+                                   digestLen,           /* Message length */
+                                   pSignature,          /* Pointer to signature */
+                                   pCurve->sig_len,     /* Signature size */
+                                   &faultCheck          /* Fault check variable */
         );
     }
 
-    /* - Clear ECC context */
-    cmox_ecc_cleanup(&Ecc_Ctx);
+    /* - Release ECC context */
+    stse_platform_ecc_release(pCtx, retval);
 
     if (retval != CMOX_ECC_AUTH_SUCCESS) {
         return STSE_PLATFORM_ECC_VERIFY_ERROR;
     }
 
+#if (STSE_CONF_ECC_VERIFY_CACHE_BUDGET > 0)
+    if (cache_ret == STSE_OK) {
+        stse_platform_ecc_verify_cache_insert(fingerprint, pub_key_tag);
+    }
+#endif /* STSE_CONF_ECC_VERIFY_CACHE_BUDGET > 0 */
+
     return STSE_OK;
 #else
     return STSE_PLATFORM_ECC_VERIFY_ERROR;
@@ -202,124 +502,206 @@ stse_ReturnCode_t stse_platform_ecc_verify(
           STSE_CONF_ECC_CURVE_25519 || STSE_CONF_ECC_EDWARD_25519 */
 }
 
-static size_t stse_platform_get_cmox_ecc_priv_key_len(stse_ecc_key_type_t key_type) {
-    switch (key_type) {
-#ifdef STSE_CONF_ECC_NIST_P_256
-    case STSE_ECC_KT_NIST_P_256:
-        return CMOX_ECC_SECP256R1_PRIVKEY_LEN;
-#endif
-#ifdef STSE_CONF_ECC_NIST_P_384
-    case STSE_ECC_KT_NIST_P_384:
-        return CMOX_ECC_SECP384R1_PRIVKEY_LEN;
-#endif
-#ifdef STSE_CONF_ECC_NIST_P_521
-    case STSE_ECC_KT_NIST_P_521:
-        return CMOX_ECC_SECP521R1_PRIVKEY_LEN;
-#endif
-#ifdef STSE_CONF_ECC_BRAINPOOL_P_256
-    case STSE_ECC_KT_BP_P_256:
-        return CMOX_ECC_BPP256R1_PRIVKEY_LEN;
-#endif
-#ifdef STSE_CONF_ECC_BRAINPOOL_P_384
-    case STSE_ECC_KT_BP_P_384:
-        return CMOX_ECC_BPP384R1_PRIVKEY_LEN;
-#endif
-#ifdef STSE_CONF_ECC_BRAINPOOL_P_512
-    case STSE_ECC_KT_BP_P_512:
-        return CMOX_ECC_BPP512R1_PRIVKEY_LEN;
-#endif
-#ifdef STSE_CONF_ECC_CURVE_25519
-    case STSE_ECC_KT_CURVE25519:
-        return CMOX_ECC_CURVE25519_PRIVKEY_LEN;
-#endif
+stse_ReturnCode_t stse_platform_ecc_verify_batch(
+    stse_ecc_key_type_t key_type,
+    stse_platform_ecc_verify_item_t *pItems,
+    PLAT_UI16 item_count,
+    PLAT_UI16 *pFailed_count) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_ECC_VERIFY_BATCH, 0);
+#if defined(STSE_CONF_ECC_NIST_P_256) || defined(STSE_CONF_ECC_NIST_P_384) || defined(STSE_CONF_ECC_NIST_P_521) ||                \
+    defined(STSE_CONF_ECC_BRAINPOOL_P_256) || defined(STSE_CONF_ECC_BRAINPOOL_P_384) || defined(STSE_CONF_ECC_BRAINPOOL_P_512) || \
+    defined(STSE_CONF_ECC_EDWARD_25519)
+    const stse_platform_ecc_curve_t *pCurve = stse_platform_ecc_get_curve(key_type);
+    cmox_ecc_retval_t retval;
+    stse_platform_ecc_context_t *pCtx;
+    cmox_ecc_impl_t impl;
+    size_t pub_key_len;
+    size_t sig_len;
+    cmox_ecc_retval_t batch_retval = CMOX_ECC_SUCCESS;
+    PLAT_UI32 faultCheck;
+    PLAT_UI16 failed_count = 0;
+#if (STSE_CONF_ECC_VERIFY_CACHE_BUDGET > 0)
+    PLAT_UI8 pub_key_tag[8];
+    PLAT_UI8 fingerprint[CMOX_SHA256_SIZE];
+    stse_ReturnCode_t cache_ret;
+#endif /* STSE_CONF_ECC_VERIFY_CACHE_BUDGET > 0 */
+
+    if ((pItems == NULL) && (item_count != 0)) {
+        return STSE_PLATFORM_INVALID_PARAMETER;
+    }
+
+    /* - Context and curve parameters are set up once for the whole batch */
+    impl = stse_platform_ecc_get_impl(pCurve, key_type);
+    pub_key_len = pCurve->pub_key_len;
+    sig_len = pCurve->sig_len;
+    if ((impl == NULL) || (sig_len == 0)) {
+        return STSE_PLATFORM_INVALID_PARAMETER;
+    }
+
+    pCtx = stse_platform_ecc_acquire(key_type);
+    if (pCtx == NULL) {
+        return STSE_PLATFORM_ECC_VERIFY_ERROR;
+    }
+
+    for (PLAT_UI16 i = 0; i < item_count; i++) {
+        stse_platform_ecc_verify_item_t *pItem = &pItems[i];
+
+#if (STSE_CONF_ECC_VERIFY_CACHE_BUDGET > 0)
+        cache_ret = stse_platform_ecc_verify_cache_fingerprint(key_type,
+                                                               pItem->pPubKey, pub_key_len,
+                                                               pItem->pDigest, pItem->digestLen,
+                                                               pItem->pSignature, sig_len,
+                                                               pub_key_tag, fingerprint);
+        if ((cache_ret == STSE_OK) && stse_platform_ecc_verify_cache_lookup(fingerprint)) {
+            pItem->result = STSE_OK;
+            continue;
+        }
+#endif /* STSE_CONF_ECC_VERIFY_CACHE_BUDGET > 0 */
+
 #ifdef STSE_CONF_ECC_EDWARD_25519
-    case STSE_ECC_KT_ED25519:
-        return CMOX_ECC_ED25519_PRIVKEY_LEN;
-#endif
-    default:
-        return 0u;
+        if (key_type == STSE_ECC_KT_ED25519) {
+            retval = cmox_eddsa_verify(&pCtx->handle, impl,
+                                       pItem->pPubKey, pub_key_len,
+                                       pItem->pDigest, pItem->digestLen,
+                                       pItem->pSignature, sig_len,
+                                       &faultCheck);
+        } else
+#endif /* STSE_CONF_ECC_EDWARD_25519 */
+        {
+            retval = cmox_ecdsa_verify(&pCtx->handle, impl,
+                                       pItem->pPubKey, pub_key_len,
+                                       pItem->pDigest, pItem->digestLen,
+                                       pItem->pSignature, sig_len,
+                                       &faultCheck);
+        }
+
+        if (retval == CMOX_ECC_ERR_MEMORY_FAIL) {
+            batch_retval = retval;
+        }
+        if (retval == CMOX_ECC_AUTH_SUCCESS) {
+            pItem->result = STSE_OK;
+#if (STSE_CONF_ECC_VERIFY_CACHE_BUDGET > 0)
+            if (cache_ret == STSE_OK) {
+                stse_platform_ecc_verify_cache_insert(fingerprint, pub_key_tag);
+            }
+#endif /* STSE_CONF_ECC_VERIFY_CACHE_BUDGET > 0 */
+        } else {
+            pItem->result = STSE_PLATFORM_ECC_VERIFY_ERROR;
+            failed_count++;
+        }
     }
+
+    /* - Release ECC context */
+    stse_platform_ecc_release(pCtx, batch_retval);
+
+    if (pFailed_count != NULL) {
+        *pFailed_count = failed_count;
+    }
+
+    return (failed_count == 0) ? STSE_OK : STSE_PLATFORM_ECC_VERIFY_ERROR;
+#else
+    return STSE_PLATFORM_ECC_VERIFY_ERROR;
+#endif /* STSE_CONF_ECC_NIST_P_256 || STSE_CONF_ECC_NIST_P_384 || STSE_CONF_ECC_NIST_P_521 ||\
+          STSE_CONF_ECC_BRAINPOOL_P_256 || STSE_CONF_ECC_BRAINPOOL_P_384 || STSE_CONF_ECC_BRAINPOOL_P_512 ||\
+          STSE_CONF_ECC_EDWARD_25519 */
 }
 
-/* Private_key */
-PLAT_UI8 static_c25519_priv_key[32] = {0x3D, 0xAC, 0x2A, 0xFF, 0x7A, 0x55, 0x9F, 0xAA,
-                                       0xAC, 0x1B, 0xB6, 0x46, 0xE9, 0xD5, 0xE0, 0x50,
-                                       0x28, 0x72, 0xFE, 0x9F, 0xD5, 0xE8, 0x3B, 0x7E,
-                                       0x68, 0x28, 0x7A, 0xB3, 0xF4, 0x7E, 0x59, 0x8F};
+/**
+ * \brief  Fill the random scratch of a key generation or signature from the RNG
+ * \param  pRandom : word aligned scratch
+ * \param  length : random length in bytes (multiple of 4)
+ */
+static void stse_platform_ecc_random_fill(PLAT_UI32 *pRandom, size_t length) {
+    for (size_t i = 0; i < (length / sizeof(PLAT_UI32)); i++) {
+        pRandom[i] = stse_platform_generate_random();
+    }
+}
 
-/* Public_key */
-PLAT_UI8 static_c25519_pub_key[32] = {0x59, 0x86, 0xA8, 0xA3, 0x51, 0xBB, 0x07, 0xCA,
-                                      0x40, 0x01, 0x76, 0xF7, 0x66, 0x8A, 0x4F, 0xBF,
-                                      0xA1, 0xA5, 0xE1, 0x9A, 0xCB, 0x57, 0x55, 0xF6,
-                                      0x57, 0xF9, 0x43, 0xE9, 0xBC, 0x39, 0x54, 0x0B};
+#ifdef STSE_CONF_ECC_CURVE_25519
+/* Curve25519 base point (u = 9, little-endian) */
+static const PLAT_UI8 c25519_base_point[CMOX_ECC_CURVE25519_PUBKEY_LEN] = {0x09};
+#endif /* STSE_CONF_ECC_CURVE_25519 */
 
-stse_ReturnCode_t stse_platform_ecc_generate_key_pair(
+static stse_ReturnCode_t stse_platform_ecc_compute_key_pair(
     stse_ecc_key_type_t key_type,
     PLAT_UI8 *pPrivKey,
     PLAT_UI8 *pPubKey) {
 #if defined(STSE_CONF_ECC_NIST_P_256) || defined(STSE_CONF_ECC_NIST_P_384) || defined(STSE_CONF_ECC_NIST_P_521) ||                \
     defined(STSE_CONF_ECC_BRAINPOOL_P_256) || defined(STSE_CONF_ECC_BRAINPOOL_P_384) || defined(STSE_CONF_ECC_BRAINPOOL_P_512) || \
     defined(STSE_CONF_ECC_CURVE_25519) || defined(STSE_CONF_ECC_EDWARD_25519)
+    const stse_platform_ecc_curve_t *pCurve = stse_platform_ecc_get_curve(key_type);
+    cmox_ecc_impl_t impl = stse_platform_ecc_get_impl(pCurve, key_type);
     cmox_ecc_retval_t retval;
+    stse_platform_ecc_context_t *pCtx;
 
-    /*- Set ECC context */
-    cmox_ecc_construct(&Ecc_Ctx,                /* ECC context */
-                       CMOX_MATH_FUNCS_SMALL,   /* Small math functions */
-                       cmox_math_buffer,        /* Crypto math buffer */
-                       sizeof(cmox_math_buffer) /* buffer size */
-    );
+    /*- Get a pooled ECC context */
+    pCtx = stse_platform_ecc_acquire(key_type);
+    if (pCtx == NULL) {
+        return STSE_PLATFORM_ECC_GENERATE_KEY_PAIR_ERROR;
+    }
+
+    /* Minimum random length equal the private key length, aligned to modulo 4 */
+    size_t randomLength = pCurve->random_len;
+    PLAT_UI32 random_scratch[STSE_PLATFORM_ECC_MAX_RANDOM_SIZE / sizeof(PLAT_UI32)];
+    PLAT_UI8 *randomNumber = (PLAT_UI8 *)random_scratch;
+
+    if (randomLength > sizeof(random_scratch)) {
+        stse_platform_ecc_release(pCtx, CMOX_ECC_SUCCESS);
+        return STSE_PLATFORM_ECC_GENERATE_KEY_PAIR_ERROR;
+    }
 
-    /* Minimum random length equal the private key length */
-    size_t randomLength = stse_platform_get_cmox_ecc_priv_key_len(key_type);
-    /* Align the random length to modulo 4 */
-    randomLength += 4 - (randomLength & 0x3);
-    /* Add 32bytes to random length if the key is Curve25519 because it will use the Ed25519 key gen */
-#ifdef STSE_CONF_ECC_CURVE_25519
-    randomLength += ((key_type == STSE_ECC_KT_CURVE25519) ? 32 : 0);
-#endif /* STSE_CONF_ECC_CURVE_25519 */
     /* Retry loop in case the RNG isn't strong enough */
     do {
         /* - Generate a random number */
-        PLAT_UI8 randomNumber[randomLength];
-        for (uint8_t i = 0; i < randomLength; i += 4) {
-            *((PLAT_UI32 *)&randomNumber[i]) = stse_platform_generate_random();
-        }
+        stse_platform_ecc_random_fill(random_scratch, randomLength);
 
         /*- Generate EdDSA key pair */
 #ifdef STSE_CONF_ECC_EDWARD_25519
         if (key_type == STSE_ECC_KT_ED25519) {
-            retval = cmox_eddsa_keyGen(&Ecc_Ctx,                                  /* ECC context */
-                                       stse_platform_get_cmox_ecc_impl(key_type), /* Curve param */
-                                       randomNumber,                              /* Random number */
-                                       randomLength,                              /* Random number length */
-                                       pPrivKey,                                  /* Private key */
-                                       NULL,                                      /* Private key length*/
-                                       pPubKey,                                   /* Public key */
-                                       NULL);                                     /* Public key length */
+            retval = cmox_eddsa_keyGen(&pCtx->handle, /* ECC context */
+                                       impl,          /* Curve param */
+                                       randomNumber,  /* Random number */
+                                       randomLength,  /* Random number length */
+                                       pPrivKey,      /* Private key */
+                                       NULL,          /* Private key length*/
+                                       pPubKey,       /* Public key */
+                                       NULL);         /* Public key length */
         } else
 #endif /* STSE_CONF_ECC_EDWARD_25519 */
 #ifdef STSE_CONF_ECC_CURVE_25519
             if (key_type == STSE_ECC_KT_CURVE25519) {
-            memcpy(pPrivKey, static_c25519_priv_key, 32);
-            memcpy(pPubKey, static_c25519_pub_key, 32);
-
-            retval = CMOX_ECC_SUCCESS;
+            /* - Clamped random scalar (RFC 7748), public key = X25519(scalar, base point) */
+            memcpy(pPrivKey, randomNumber, CMOX_ECC_CURVE25519_PRIVKEY_LEN);
+            pPrivKey[0] &= 0xF8;
+            pPrivKey[CMOX_ECC_CURVE25519_PRIVKEY_LEN - 1] &= 0x7F;
+            pPrivKey[CMOX_ECC_CURVE25519_PRIVKEY_LEN - 1] |= 0x40;
+            retval = cmox_ecdh(&pCtx->handle,                   /* ECC context */
+                               CMOX_ECC_CURVE25519,             /* Curve param */
+                               pPrivKey,                        /* Private key */
+                               CMOX_ECC_CURVE25519_PRIVKEY_LEN, /* Private key length */
+                               c25519_base_point,               /* Base point */
+                               sizeof(c25519_base_point),       /* Base point length */
+                               pPubKey,                         /* Public key */
+                               NULL);                           /* Public key length */
         } else
 #endif /* STSE_CONF_ECC_CURVE_25519 */
         {
-            retval = cmox_ecdsa_keyGen(&Ecc_Ctx,                                  /* ECC context */
-                                       stse_platform_get_cmox_ecc_impl(key_type), /* Curve param */
-                                       randomNumber,                              /* Random number */
-                                       randomLength,                              /* Random number length */
-                                       pPrivKey,                                  /* Private key */
-                                       NULL,                                      /* Private key length*/
-                                       pPubKey,                                   /* Public key */
-                                       NULL);                                     /* Public key length */
+            retval = cmox_ecdsa_keyGen(&pCtx->handle, /* ECC context */
+                                       impl,          /* Curve param */
+                                       randomNumber,  /* Random number */
+                                       randomLength,  /* Random number length */
+                                       pPrivKey,      /* Private key */
+                                       NULL,          /* Private key length*/
+                                       pPubKey,       /* Public key */
+                                       NULL);         /* Public key length */
         }
     } while (retval == CMOX_ECC_ERR_WRONG_RANDOM);
 
-    /* - Clear ECC context */
-    cmox_ecc_cleanup(&Ecc_Ctx);
+    /* - Zeroise the random scratch */
+    stse_platform_scratch_wipe(random_scratch, sizeof(random_scratch));
+
+    /* - Release ECC context */
+    stse_platform_ecc_release(pCtx, retval);
 
     if (retval != CMOX_ECC_SUCCESS) {
         return STSE_PLATFORM_ECC_GENERATE_KEY_PAIR_ERROR;
@@ -333,9 +715,175 @@ stse_ReturnCode_t stse_platform_ecc_generate_key_pair(
           STSE_CONF_ECC_CURVE_25519 || STSE_CONF_ECC_EDWARD_25519 */
 }
 
-#if defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED) || \
-    defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT_AUTHENTICATED) ||   \
-    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED)
+#if (STSE_CONF_ECC_KEY_POOL_SIZE > 0)
+/* Pregenerated key pair, linked in its curve ready list or in the free list */
+typedef struct {
+    PLAT_UI8 priv_key[STSE_PLATFORM_ECC_MAX_PRIV_KEY_SIZE];
+    PLAT_UI8 pub_key[STSE_PLATFORM_ECC_MAX_PUB_KEY_SIZE];
+    PLAT_UI8 next;
+} stse_platform_ecc_key_pool_entry_t;
+
+#define STSE_PLATFORM_ECC_KEY_POOL_END 0xFFU
+
+static stse_platform_ecc_key_pool_entry_t ecc_key_pool[STSE_CONF_ECC_KEY_POOL_SIZE] RAM2_CRYPTO;
+static PLAT_UI8 ecc_key_pool_ready[STSE_ECC_KT_INVALID]; /* Ready list head per curve */
+static PLAT_UI8 ecc_key_pool_ready_count[STSE_ECC_KT_INVALID];
+static PLAT_UI8 ecc_key_pool_free;
+static PLAT_UI8 ecc_key_pool_initialized = 0;
+static stse_platform_ecc_key_pool_stats_t ecc_key_pool_stats;
+
+/**
+ * \brief  Pop the head of a key pool list
+ * \details The list length and the statistics are updated in the same critical section.
+ * \param  pHead : list head
+ * \param  pCount : list length, decremented on pop (can be NULL)
+ * \param  pHit_count : counter incremented on pop (can be NULL)
+ * \param  pMiss_count : counter incremented when the list is empty (can be NULL)
+ * \return entry index, STSE_PLATFORM_ECC_KEY_POOL_END if the list is empty
+ */
+static PLAT_UI8 stse_platform_ecc_key_pool_pop(PLAT_UI8 *pHead, PLAT_UI8 *pCount,
+                                               PLAT_UI32 *pHit_count, PLAT_UI32 *pMiss_count) {
+    PLAT_UI32 primask = __get_PRIMASK();
+    PLAT_UI8 index;
+
+    __disable_irq();
+    /* - Link all the entries in the free list on first use */
+    if (!ecc_key_pool_initialized) {
+        for (PLAT_UI8 i = 0; i < STSE_CONF_ECC_KEY_POOL_SIZE; i++) {
+            ecc_key_pool[i].next = (i + 1 < STSE_CONF_ECC_KEY_POOL_SIZE) ? (PLAT_UI8)(i + 1) : STSE_PLATFORM_ECC_KEY_POOL_END;
+        }
+        for (PLAT_UI8 i = 0; i < STSE_ECC_KT_INVALID; i++) {
+            ecc_key_pool_ready[i] = STSE_PLATFORM_ECC_KEY_POOL_END;
+        }
+        ecc_key_pool_free = 0;
+        ecc_key_pool_initialized = 1;
+    }
+    index = *pHead;
+    if (index != STSE_PLATFORM_ECC_KEY_POOL_END) {
+        *pHead = ecc_key_pool[index].next;
+        if (pCount != NULL) {
+            (*pCount)--;
+        }
+        if (pHit_count != NULL) {
+            (*pHit_count)++;
+        }
+    } else if (pMiss_count != NULL) {
+        (*pMiss_count)++;
+    }
+    __set_PRIMASK(primask);
+
+    return index;
+}
+
+/**
+ * \brief  Push an entry at the head of a key pool list
+ * \param  pHead : list head
+ * \param  index : entry index
+ * \param  pCount : list length, incremented on push (can be NULL)
+ * \param  pEvent_count : counter incremented on push (can be NULL)
+ */
+static void stse_platform_ecc_key_pool_push(PLAT_UI8 *pHead, PLAT_UI8 index, PLAT_UI8 *pCount, PLAT_UI32 *pEvent_count) {
+    PLAT_UI32 primask = __get_PRIMASK();
+
+    __disable_irq();
+    ecc_key_pool[index].next = *pHead;
+    *pHead = index;
+    if (pCount != NULL) {
+        (*pCount)++;
+    }
+    if (pEvent_count != NULL) {
+        (*pEvent_count)++;
+    }
+    __set_PRIMASK(primask);
+}
+
+stse_ReturnCode_t stse_platform_ecc_key_pool_fill(stse_ecc_key_type_t key_type, PLAT_UI8 count) {
+    stse_ReturnCode_t ret;
+    PLAT_UI8 index;
+
+    if (key_type >= STSE_ECC_KT_INVALID) {
+        return STSE_PLATFORM_INVALID_PARAMETER;
+    }
+
+    while (count--) {
+        index = stse_platform_ecc_key_pool_pop(&ecc_key_pool_free, NULL, NULL, NULL);
+        if (index == STSE_PLATFORM_ECC_KEY_POOL_END) {
+            break; /* Pool full */
+        }
+
+        ret = stse_platform_ecc_compute_key_pair(key_type, ecc_key_pool[index].priv_key, ecc_key_pool[index].pub_key);
+        if (ret != STSE_OK) {
+            stse_platform_scratch_wipe(ecc_key_pool[index].priv_key, sizeof(ecc_key_pool[index].priv_key));
+            stse_platform_ecc_key_pool_push(&ecc_key_pool_free, index, NULL, NULL);
+            return ret;
+        }
+
+        stse_platform_ecc_key_pool_push(&ecc_key_pool_ready[key_type], index,
+                                        &ecc_key_pool_ready_count[key_type], &ecc_key_pool_stats.generated_count);
+    }
+
+    return STSE_OK;
+}
+
+PLAT_UI8 stse_platform_ecc_key_pool_count(stse_ecc_key_type_t key_type) {
+    return (key_type < STSE_ECC_KT_INVALID) ? ecc_key_pool_ready_count[key_type] : 0;
+}
+
+void stse_platform_ecc_key_pool_flush(void) {
+    PLAT_UI8 index;
+
+    for (PLAT_UI8 kt = 0; kt < STSE_ECC_KT_INVALID; kt++) {
+        while ((index = stse_platform_ecc_key_pool_pop(&ecc_key_pool_ready[kt], &ecc_key_pool_ready_count[kt], NULL, NULL)) !=
+               STSE_PLATFORM_ECC_KEY_POOL_END) {
+            stse_platform_scratch_wipe(ecc_key_pool[index].priv_key, sizeof(ecc_key_pool[index].priv_key));
+            stse_platform_scratch_wipe(ecc_key_pool[index].pub_key, sizeof(ecc_key_pool[index].pub_key));
+            stse_platform_ecc_key_pool_push(&ecc_key_pool_free, index, NULL, NULL);
+        }
+    }
+}
+
+void stse_platform_ecc_get_key_pool_stats(stse_platform_ecc_key_pool_stats_t *pStats) {
+    PLAT_UI32 primask = __get_PRIMASK();
+
+    __disable_irq();
+    *pStats = ecc_key_pool_stats;
+    __set_PRIMASK(primask);
+}
+#endif /* STSE_CONF_ECC_KEY_POOL_SIZE > 0 */
+
+stse_ReturnCode_t stse_platform_ecc_generate_key_pair(
+    stse_ecc_key_type_t key_type,
+    PLAT_UI8 *pPrivKey,
+    PLAT_UI8 *pPubKey) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_ECC_KEYGEN, 0);
+#if (STSE_CONF_ECC_KEY_POOL_SIZE > 0)
+    PLAT_UI8 index = STSE_PLATFORM_ECC_KEY_POOL_END;
+
+    /* - Hand out a pregenerated key pair (O(1)), consumed entry is zeroised */
+    if (key_type < STSE_ECC_KT_INVALID) {
+        index = stse_platform_ecc_key_pool_pop(&ecc_key_pool_ready[key_type], &ecc_key_pool_ready_count[key_type],
+                                               &ecc_key_pool_stats.hit_count, &ecc_key_pool_stats.miss_count);
+    }
+    if (index != STSE_PLATFORM_ECC_KEY_POOL_END) {
+        const stse_platform_ecc_curve_t *pCurve = stse_platform_ecc_get_curve(key_type);
+
+        memcpy(pPrivKey, ecc_key_pool[index].priv_key, pCurve->priv_key_len);
+        memcpy(pPubKey, ecc_key_pool[index].pub_key, pCurve->pub_key_len);
+        stse_platform_scratch_wipe(ecc_key_pool[index].priv_key, sizeof(ecc_key_pool[index].priv_key));
+        stse_platform_scratch_wipe(ecc_key_pool[index].pub_key, sizeof(ecc_key_pool[index].pub_key));
+        stse_platform_ecc_key_pool_push(&ecc_key_pool_free, index, NULL, NULL);
+        return STSE_OK;
+    }
+#endif /* STSE_CONF_ECC_KEY_POOL_SIZE > 0 */
+
+    /* - Pool empty : generate inline */
+    return stse_platform_ecc_compute_key_pair(key_type, pPrivKey, pPubKey);
+}
+
+#if defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED) ||      \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT_AUTHENTICATED) ||        \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED) || \
+    defined(STSE_CONF_CRYPTO_BENCHMARK)
 
 stse_ReturnCode_t stse_platform_ecc_sign(
     stse_ecc_key_type_t key_type,
@@ -343,62 +891,71 @@ stse_ReturnCode_t stse_platform_ecc_sign(
     PLAT_UI8 *pDigest,
     PLAT_UI16 digestLen,
     PLAT_UI8 *pSignature) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_ECC_SIGN, digestLen);
 #if defined(STSE_CONF_ECC_NIST_P_256) || defined(STSE_CONF_ECC_NIST_P_384) || defined(STSE_CONF_ECC_NIST_P_521) ||                \
     defined(STSE_CONF_ECC_BRAINPOOL_P_256) || defined(STSE_CONF_ECC_BRAINPOOL_P_384) || defined(STSE_CONF_ECC_BRAINPOOL_P_512) || \
     defined(STSE_CONF_ECC_CURVE_25519) || defined(STSE_CONF_ECC_EDWARD_25519)
+    const stse_platform_ecc_curve_t *pCurve = stse_platform_ecc_get_curve(key_type);
+    cmox_ecc_impl_t impl = stse_platform_ecc_get_impl(pCurve, key_type);
     cmox_ecc_retval_t retval;
+    stse_platform_ecc_context_t *pCtx;
 
     if (pPrivKey == NULL) {
         return STSE_PLATFORM_INVALID_PARAMETER;
     }
 
-    /*- Set ECC context */
-    cmox_ecc_construct(&Ecc_Ctx,                /* ECC context */
-                       CMOX_MATH_FUNCS_SMALL,   /* Small math functions */
-                       cmox_math_buffer,        /* Crypto math buffer */
-                       sizeof(cmox_math_buffer) /* buffer size */
-    );
+    /*- Get a pooled ECC context */
+    pCtx = stse_platform_ecc_acquire(key_type);
+    if (pCtx == NULL) {
+        return STSE_PLATFORM_ECC_SIGN_ERROR;
+    }
 
 #ifdef STSE_CONF_ECC_EDWARD_25519
     if (key_type == STSE_ECC_KT_ED25519) {
         /* - Perform EDDSA sign */
-        retval = cmox_eddsa_sign(&Ecc_Ctx,                                          /* ECC context */
-                                 stse_platform_get_cmox_ecc_impl(key_type),         /* Curve param */
-                                 pPrivKey,                                          /* Private key */
-                                 stse_platform_get_cmox_ecc_priv_key_len(key_type), /* Private key length*/
-                                 pDigest,                                           /* Message */
-                                 digestLen,                                         /* Message length */
-                                 pSignature,                                        /* Signature */
-                                 NULL                                               /* Signature length */
+        retval = cmox_eddsa_sign(&pCtx->handle,        /* ECC context */
+                                 impl,                 /* Curve param */
+                                 pPrivKey,             /* Private key */
+                                 pCurve->priv_key_len, /* Private key length*/
+                                 pDigest,              /* Message */
+                                 digestLen,            /* Message length */
+                                 pSignature,           /* Signature */
+                                 NULL                  /* Signature length */
         );
     } else
 #endif /* STSE_CONF_ECC_EDWARD_25519 */
     {
+        PLAT_UI32 random_scratch[STSE_PLATFORM_ECC_MAX_RANDOM_SIZE / sizeof(PLAT_UI32)];
+
+        if (pCurve->random_len > sizeof(random_scratch)) {
+            stse_platform_ecc_release(pCtx, CMOX_ECC_SUCCESS);
+            return STSE_PLATFORM_ECC_SIGN_ERROR;
+        }
+
         do {
             /* - Generate a random number */
-            size_t randomLength = stse_platform_get_cmox_ecc_priv_key_len(key_type) + (4 - (stse_platform_get_cmox_ecc_priv_key_len(key_type) & 0x3));
-            PLAT_UI8 randomNumber[randomLength];
-            for (uint8_t i = 0; i < randomLength; i += 4) {
-                *((PLAT_UI32 *)&randomNumber[i]) = stse_platform_generate_random();
-            }
+            stse_platform_ecc_random_fill(random_scratch, pCurve->random_len);
 
             /* - Perform ECDSA sign */
-            retval = cmox_ecdsa_sign(&Ecc_Ctx,                                  /* ECC context */
-                                     stse_platform_get_cmox_ecc_impl(key_type), /* Curve param */
-                                     randomNumber,
-                                     stse_platform_get_cmox_ecc_priv_key_len(key_type),
-                                     pPrivKey,                                          /* Private key */
-                                     stse_platform_get_cmox_ecc_priv_key_len(key_type), /* Private key length*/
-                                     pDigest,                                           /* Message */
-                                     digestLen,                                         /* Message length */
-                                     pSignature,                                        /* Signature */
-                                     NULL                                               /* Signature length */
+            retval = cmox_ecdsa_sign(&pCtx->handle,              /* ECC context */
+                                     impl,                       /* Curve param */
+                                     (PLAT_UI8 *)random_scratch, /* Random number */
+                                     pCurve->priv_key_len,       /* Random number length */
+                                     pPrivKey,                   /* Private key */
+                                     pCurve->priv_key_len,       /* Private key length*/
+                                     pDigest,                    /* Message */
+                                     digestLen,                  /* Message length */
+                                     pSignature,                 /* Signature */
+                                     NULL                        /* Signature length */
             );
         } while (retval == CMOX_ECC_ERR_WRONG_RANDOM);
+
+        /* - Zeroise the random scratch (signature nonce) */
+        stse_platform_scratch_wipe(random_scratch, sizeof(random_scratch));
     }
 
-    /* - Clear ECC context */
-    cmox_ecc_cleanup(&Ecc_Ctx);
+    /* - Release ECC context */
+    stse_platform_ecc_release(pCtx, retval);
 
     if (retval != CMOX_ECC_SUCCESS) {
         return STSE_PLATFORM_ECC_SIGN_ERROR;
@@ -412,42 +969,45 @@ stse_ReturnCode_t stse_platform_ecc_sign(
           STSE_CONF_ECC_CURVE_25519 || STSE_CONF_ECC_EDWARD_25519 */
 }
 #endif /* STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED || STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT_AUTHENTICATED ||
-			STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED */
+			STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED || STSE_CONF_CRYPTO_BENCHMARK */
 
-#if defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) ||                      \
-    defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED) ||               \
-    defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED) || \
-    defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT) ||                 \
-    defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT_AUTHENTICATED) ||   \
-    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED) ||          \
-    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED)
+#if defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) ||                           \
+    defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED) ||                    \
+    defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED) ||      \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT) ||                      \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT_AUTHENTICATED) ||        \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED) ||               \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED) || \
+    defined(STSE_CONF_CRYPTO_BENCHMARK)
 
 stse_ReturnCode_t stse_platform_ecc_ecdh(
     stse_ecc_key_type_t key_type,
     const PLAT_UI8 *pPubKey,
     const PLAT_UI8 *pPrivKey,
     PLAT_UI8 *pSharedSecret) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_ECC_ECDH, 0);
+    const stse_platform_ecc_curve_t *pCurve = stse_platform_ecc_get_curve(key_type);
     cmox_ecc_retval_t retval;
+    stse_platform_ecc_context_t *pCtx;
 
-    /*- Set ECC context */
-    cmox_ecc_construct(&Ecc_Ctx,                /* ECC context */
-                       CMOX_MATH_FUNCS_SMALL,   /* Small math functions */
-                       cmox_math_buffer,        /* Crypto math buffer */
-                       sizeof(cmox_math_buffer) /* buffer size */
-    );
+    /*- Get a pooled ECC context */
+    pCtx = stse_platform_ecc_acquire(key_type);
+    if (pCtx == NULL) {
+        return STSE_PLATFORM_ECC_ECDH_ERROR;
+    }
 
-    retval = cmox_ecdh(&Ecc_Ctx,                                          /* ECC context */
-                       stse_platform_get_cmox_ecc_impl(key_type),         /* Curve param */
-                       pPrivKey,                                          /* Private key (local) */
-                       stse_platform_get_cmox_ecc_priv_key_len(key_type), /* Private key length*/
-                       pPubKey,                                           /* Public key (remote) */
-                       stse_platform_get_cmox_ecc_pub_key_len(key_type),  /* Public key length */
-                       pSharedSecret,                                     /* Shared secret */
-                       NULL                                               /* Shared secret length */
+    retval = cmox_ecdh(&pCtx->handle,                                /* ECC context */
+                       stse_platform_ecc_get_impl(pCurve, key_type), /* Curve param */
+                       pPrivKey,                                     /* Private key (local) */
+                       pCurve->priv_key_len,                         /* Private key length*/
+                       pPubKey,                                      /* Public key (remote) */
+                       pCurve->pub_key_len,                          /* Public key length */
+                       pSharedSecret,                                /* Shared secret */
+                       NULL                                          /* Shared secret length */
     );
 
-    /* - Clear ECC context */
-    cmox_ecc_cleanup(&Ecc_Ctx);
+    /* - Release ECC context */
+    stse_platform_ecc_release(pCtx, retval);
 
     if (retval != CMOX_ECC_SUCCESS) {
         return STSE_PLATFORM_ECC_ECDH_ERROR;
@@ -458,36 +1018,81 @@ stse_ReturnCode_t stse_platform_ecc_ecdh(
 #endif /* STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) || STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED) ||
 			STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED || STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT) ||
 			STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT_AUTHENTICATED || STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED ||
-			STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED */
+			STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED || STSE_CONF_CRYPTO_BENCHMARK */
 
-#if defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED) ||               \
-    defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED) || \
-    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED) ||          \
-    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED)
+/* Operations linked for the math buffer check (same conditions as stse_platform_ecc_sign and stse_platform_ecc_ecdh) */
+#if defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED) ||      \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT_AUTHENTICATED) ||        \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED) || \
+    defined(STSE_CONF_CRYPTO_BENCHMARK)
+#define STSE_PLATFORM_ECC_CHECK_SIGN
+#endif
+#if defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) ||                           \
+    defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED) ||                    \
+    defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED) ||      \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT) ||                      \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT_AUTHENTICATED) ||        \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED) ||               \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED) || \
+    defined(STSE_CONF_CRYPTO_BENCHMARK)
+#define STSE_PLATFORM_ECC_CHECK_ECDH
+#endif
 
-#define KEK_WRAP_IV_SIZE 8
-const PLAT_UI8 KEK_WRAP_IV[KEK_WRAP_IV_SIZE] = {0xA6, 0xA6, 0xA6, 0xA6, 0xA6, 0xA6, 0xA6, 0xA6};
+stse_ReturnCode_t stse_platform_ecc_check_math_buffer(PLAT_UI32 *pUsed) {
+    PLAT_UI8 priv_key[2][STSE_PLATFORM_ECC_MAX_PRIV_KEY_SIZE];
+    PLAT_UI8 pub_key[2][STSE_PLATFORM_ECC_MAX_PUB_KEY_SIZE];
+    PLAT_UI8 output[STSE_PLATFORM_ECC_MAX_PUB_KEY_SIZE]; /* Signature or shared secret */
+#ifdef STSE_PLATFORM_ECC_CHECK_SIGN
+    PLAT_UI8 digest[32] = {0};
+#endif /* STSE_PLATFORM_ECC_CHECK_SIGN */
+    PLAT_UI32 fail_count = ecc_pool_stats.math_fail_count;
+    stse_ReturnCode_t ret = STSE_OK;
 
-stse_ReturnCode_t stse_platform_nist_kw_encrypt(PLAT_UI8 *pPayload, PLAT_UI32 payload_length,
-                                                PLAT_UI8 *pKey, PLAT_UI8 key_length,
-                                                PLAT_UI8 *pOutput, PLAT_UI32 *pOutput_length) {
-    cmox_cipher_retval_t retval;
-    size_t cmox_output_length = *pOutput_length;
+    for (PLAT_UI8 kt = 0; (kt < STSE_ECC_KT_INVALID) && (ret == STSE_OK); kt++) {
+        stse_ecc_key_type_t key_type = (stse_ecc_key_type_t)kt;
+        const stse_platform_ecc_curve_t *pCurve = stse_platform_ecc_get_curve(key_type);
+
+        /* - Curves not enabled */
+        if (stse_platform_ecc_get_impl(pCurve, key_type) == NULL) {
+            continue;
+        }
 
-    retval = cmox_cipher_encrypt(
-        CMOX_AESSMALL_KEYWRAP_ENC_ALGO,
-        pPayload, payload_length,
-        pKey, key_length,
-        KEK_WRAP_IV, KEK_WRAP_IV_SIZE,
-        pOutput, &cmox_output_length);
+        /* - Key generation (inline, not from the key pool) */
+        ret = stse_platform_ecc_compute_key_pair(key_type, priv_key[0], pub_key[0]);
 
-    if (retval != CMOX_CIPHER_SUCCESS) {
-        return STSE_PLATFORM_KEYWRAP_ERROR;
+#ifdef STSE_PLATFORM_ECC_CHECK_SIGN
+        /* - Signature and verification */
+        if ((ret == STSE_OK) && (pCurve->sig_len != 0)) {
+            ret = stse_platform_ecc_sign(key_type, priv_key[0], digest, sizeof(digest), output);
+            if (ret == STSE_OK) {
+                ret = stse_platform_ecc_verify(key_type, pub_key[0], digest, sizeof(digest), output);
+            }
+        }
+#endif /* STSE_PLATFORM_ECC_CHECK_SIGN */
+
+#ifdef STSE_PLATFORM_ECC_CHECK_ECDH
+        /* - Shared secret (signature only curves excluded) */
+#ifdef STSE_CONF_ECC_EDWARD_25519
+        if (key_type == STSE_ECC_KT_ED25519) {
+            continue;
+        }
+#endif /* STSE_CONF_ECC_EDWARD_25519 */
+        if (ret == STSE_OK) {
+            ret = stse_platform_ecc_compute_key_pair(key_type, priv_key[1], pub_key[1]);
+        }
+        if (ret == STSE_OK) {
+            ret = stse_platform_ecc_ecdh(key_type, pub_key[1], priv_key[0], output);
+        }
+#endif /* STSE_PLATFORM_ECC_CHECK_ECDH */
     }
 
-    *pOutput_length = (PLAT_UI32)cmox_output_length;
+    /* - Zeroise the check keys and secrets */
+    stse_platform_scratch_wipe(priv_key, sizeof(priv_key));
+    stse_platform_scratch_wipe(output, sizeof(output));
 
-    return STSE_OK;
+    if (pUsed != NULL) {
+        *pUsed = ecc_pool_stats.math_buffer_hwm;
+    }
+
+    return (ecc_pool_stats.math_fail_count != fail_count) ? STSE_PLATFORM_BUFFER_ERR : ret;
 }
-#endif /* STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED || STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED ||
-			STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED || STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED */
@@ -0,0 +1,241 @@
+/******************************************************************************
+ * \file	stse_platform_ecc.h
+ * \brief   STSecureElement ECC platform extensions
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STSE_PLATFORM_ECC_H
+#define STSE_PLATFORM_ECC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stse_conf.h"
+#include "stselib.h"
+
+/* ECC speed/size profiles */
+typedef enum {
+    STSE_PLATFORM_ECC_PROFILE_SMALL = 0, /* LOWMEM curve implementation, small math functions */
+    STSE_PLATFORM_ECC_PROFILE_FAST       /* HIGHMEM curve implementation, fast math functions */
+} stse_platform_ecc_profile_t;
+
+#ifdef STSE_CONF_ECC_PROFILE_FAST
+#define STSE_PLATFORM_ECC_PROFILE_DEFAULT STSE_PLATFORM_ECC_PROFILE_FAST
+#else
+#define STSE_PLATFORM_ECC_PROFILE_DEFAULT STSE_PLATFORM_ECC_PROFILE_SMALL
+#endif
+
+/* CMOX math buffer size : largest requirement of the linked profiles and enabled curves.
+ * CMOX exports no size macro and cmox_ecc_construct() cannot fail : a too small buffer
+ * is only reported by the operations (CMOX_ECC_ERR_MEMORY_FAIL). The SMALL size is the
+ * one of the original platform port, the FAST sizes are margins over the HIGHMEM needs
+ * per curve size; the reference figures are the ECC memory requirements in CMOX.chm
+ * (X-CUBE-CRYPTOLIB v4.5.0). Both are checked at run time by
+ * stse_platform_ecc_check_math_buffer(), which also reports the bytes actually used. */
+#if defined(STSE_CONF_ECC_PROFILE_FAST) || defined(STSE_CONF_ECC_PROFILE_RUNTIME)
+#if defined(STSE_CONF_ECC_NIST_P_521) || defined(STSE_CONF_ECC_BRAINPOOL_P_512)
+#define STSE_PLATFORM_ECC_MATH_BUFFER_SIZE 7400U
+#elif defined(STSE_CONF_ECC_NIST_P_384) || defined(STSE_CONF_ECC_BRAINPOOL_P_384)
+#define STSE_PLATFORM_ECC_MATH_BUFFER_SIZE 5800U
+#else
+#define STSE_PLATFORM_ECC_MATH_BUFFER_SIZE 4000U
+#endif
+#else
+#define STSE_PLATFORM_ECC_MATH_BUFFER_SIZE 2400U
+#endif
+
+/* ECC context pool size (concurrent ECC operations) */
+#ifndef STSE_CONF_ECC_CONTEXT_POOL_SIZE
+#define STSE_CONF_ECC_CONTEXT_POOL_SIZE 1
+#endif
+
+/* Math buffer releases between two scans from the buffer end : the other releases only
+ * wipe up to the bound learned per curve and profile and check the guard word above it */
+#ifndef STSE_PLATFORM_ECC_MATH_FULL_SCAN_PERIOD
+#define STSE_PLATFORM_ECC_MATH_FULL_SCAN_PERIOD 32U
+#endif
+
+/* ECC context pool statistics */
+typedef struct {
+    PLAT_UI32 acquire_count;   /* ECC operations started */
+    PLAT_UI32 construct_count; /* Context constructions (first use or profile change) */
+    PLAT_UI32 exhausted_count; /* Operations rejected, all contexts in use */
+    PLAT_UI32 math_buffer_hwm; /* Highest math buffer usage (bytes wiped after each operation) */
+    PLAT_UI32 math_scan_count; /* Releases that scanned the math buffer from its end (bound learned or raised) */
+    PLAT_UI32 math_fail_count; /* Operations failed with CMOX_ECC_ERR_MEMORY_FAIL (math buffer too small) */
+    PLAT_UI8 max_in_use;       /* Highest number of contexts used at the same time */
+} stse_platform_ecc_pool_stats_t;
+
+/* Ephemeral key pair pool size (0 = keys always generated inline) */
+#ifndef STSE_CONF_ECC_KEY_POOL_SIZE
+#define STSE_CONF_ECC_KEY_POOL_SIZE 0
+#endif
+
+/* Largest key sizes of the enabled curves */
+#ifdef STSE_CONF_ECC_NIST_P_521
+#define STSE_PLATFORM_ECC_MAX_PRIV_KEY_SIZE 66U
+#define STSE_PLATFORM_ECC_MAX_PUB_KEY_SIZE 132U
+#else
+#define STSE_PLATFORM_ECC_MAX_PRIV_KEY_SIZE 64U
+#define STSE_PLATFORM_ECC_MAX_PUB_KEY_SIZE 128U
+#endif
+
+/* RNG input scratch size of key generation and signature : largest enabled private key, word aligned */
+#if defined(STSE_CONF_ECC_NIST_P_521) || defined(STSE_CONF_ECC_BRAINPOOL_P_512) || defined(STSE_CONF_ECC_EDWARD_25519)
+#define STSE_PLATFORM_ECC_MAX_RANDOM_SIZE 68U
+#elif defined(STSE_CONF_ECC_NIST_P_384) || defined(STSE_CONF_ECC_BRAINPOOL_P_384)
+#define STSE_PLATFORM_ECC_MAX_RANDOM_SIZE 52U
+#else
+#define STSE_PLATFORM_ECC_MAX_RANDOM_SIZE 36U
+#endif
+
+/* Ephemeral key pair pool statistics */
+typedef struct {
+    PLAT_UI32 generated_count; /* Key pairs pregenerated */
+    PLAT_UI32 hit_count;       /* Key pairs handed out from the pool */
+    PLAT_UI32 miss_count;      /* Key pairs generated inline (pool empty) */
+} stse_platform_ecc_key_pool_stats_t;
+
+/* Verification cache RAM budget in bytes (0 = no cache) */
+#ifndef STSE_CONF_ECC_VERIFY_CACHE_BUDGET
+#define STSE_CONF_ECC_VERIFY_CACHE_BUDGET 0
+#endif
+#define STSE_PLATFORM_ECC_VERIFY_CACHE_ENTRY_SIZE 44U
+#define STSE_PLATFORM_ECC_VERIFY_CACHE_ENTRIES (STSE_CONF_ECC_VERIFY_CACHE_BUDGET / STSE_PLATFORM_ECC_VERIFY_CACHE_ENTRY_SIZE)
+#if (STSE_CONF_ECC_VERIFY_CACHE_BUDGET > 0) && (STSE_PLATFORM_ECC_VERIFY_CACHE_ENTRIES == 0)
+#error "STSE_CONF_ECC_VERIFY_CACHE_BUDGET is smaller than one cache entry"
+#endif
+
+/* Verification cache statistics */
+typedef struct {
+    PLAT_UI32 hit_count;      /* Verifications answered from the cache */
+    PLAT_UI32 miss_count;     /* Verifications computed */
+    PLAT_UI32 eviction_count; /* Entries replaced (least recently used) */
+} stse_platform_ecc_verify_cache_stats_t;
+
+/* Batch verification item */
+typedef struct {
+    const PLAT_UI8 *pPubKey;
+    PLAT_UI8 *pDigest;
+    PLAT_UI16 digestLen;
+    PLAT_UI8 *pSignature;
+    stse_ReturnCode_t result; /* Output : STSE_OK or STSE_PLATFORM_ECC_VERIFY_ERROR */
+} stse_platform_ecc_verify_item_t;
+
+/**
+ * \brief  Select the profile used for a curve
+ * \details Only available with STSE_CONF_ECC_PROFILE_RUNTIME, the profile is
+ *          otherwise fixed at compile time by STSE_CONF_ECC_PROFILE_FAST
+ * \param  key_type : curve
+ * \param  profile : ECC profile
+ * \return STSE_OK on success, STSE_PLATFORM_INVALID_PARAMETER otherwise
+ */
+stse_ReturnCode_t stse_platform_ecc_set_profile(stse_ecc_key_type_t key_type, stse_platform_ecc_profile_t profile);
+
+/**
+ * \brief  Get the profile used for a curve
+ * \param  key_type : curve
+ * \return ECC profile
+ */
+stse_platform_ecc_profile_t stse_platform_ecc_get_profile(stse_ecc_key_type_t key_type);
+
+/**
+ * \brief  Get the ECC context pool statistics
+ * \param  pStats : statistics output
+ */
+void stse_platform_ecc_get_pool_stats(stse_platform_ecc_pool_stats_t *pStats);
+
+/**
+ * \brief  Check that the math buffer is large enough for the enabled curves
+ * \details Runs a key generation, a signature and its verification (or an ECDH)
+ *          on each enabled curve with its current profile.
+ * \param  pUsed : highest math buffer usage in bytes (can be NULL)
+ * \return STSE_OK on success, STSE_PLATFORM_BUFFER_ERR if CMOX reported a too small
+ *         math buffer, operation error otherwise
+ */
+stse_ReturnCode_t stse_platform_ecc_check_math_buffer(PLAT_UI32 *pUsed);
+
+/**
+ * \brief  Verify a batch of signatures on the same curve
+ * \details The ECC context and curve parameters are set up once for the batch,
+ *          each item result is reported in its result field.
+ * \param  key_type : curve (signature curves only)
+ * \param  pItems : (public key, digest, signature) items
+ * \param  item_count : number of items
+ * \param  pFailed_count : number of items failing verification (can be NULL)
+ * \return STSE_OK if all the items are verified, STSE_PLATFORM_ECC_VERIFY_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_ecc_verify_batch(stse_ecc_key_type_t key_type,
+                                                 stse_platform_ecc_verify_item_t *pItems,
+                                                 PLAT_UI16 item_count,
+                                                 PLAT_UI16 *pFailed_count);
+
+#if (STSE_CONF_ECC_VERIFY_CACHE_BUDGET > 0)
+/**
+ * \brief  Invalidate cached verifications
+ * \details Successful verifications are cached by stse_platform_ecc_verify() and
+ *          stse_platform_ecc_verify_batch() : a known (public key, digest, signature)
+ *          triple is then accepted without ECC computation.
+ * \param  key_type : curve of the public key
+ * \param  pPubKey : public key whose verifications are invalidated, NULL to flush the cache
+ */
+void stse_platform_ecc_verify_cache_invalidate(stse_ecc_key_type_t key_type, const PLAT_UI8 *pPubKey);
+
+/**
+ * \brief  Get the verification cache statistics
+ * \param  pStats : statistics output
+ */
+void stse_platform_ecc_get_verify_cache_stats(stse_platform_ecc_verify_cache_stats_t *pStats);
+#endif /* STSE_CONF_ECC_VERIFY_CACHE_BUDGET > 0 */
+
+#if (STSE_CONF_ECC_KEY_POOL_SIZE > 0)
+/**
+ * \brief  Pregenerate ephemeral key pairs for a curve
+ * \details To be called at boot or from idle time : stse_platform_ecc_generate_key_pair()
+ *          then hands out pregenerated key pairs, and only falls back to inline
+ *          generation when the pool of the curve is empty.
+ * \param  key_type : curve
+ * \param  count : maximum number of key pairs to generate (stops when the pool is full)
+ * \return STSE_OK on success, key generation error otherwise
+ */
+stse_ReturnCode_t stse_platform_ecc_key_pool_fill(stse_ecc_key_type_t key_type, PLAT_UI8 count);
+
+/**
+ * \brief  Get the number of pregenerated key pairs ready for a curve
+ * \param  key_type : curve
+ * \return number of key pairs
+ */
+PLAT_UI8 stse_platform_ecc_key_pool_count(stse_ecc_key_type_t key_type);
+
+/**
+ * \brief  Zeroise and discard all pregenerated key pairs
+ */
+void stse_platform_ecc_key_pool_flush(void);
+
+/**
+ * \brief  Get the ephemeral key pair pool statistics
+ * \param  pStats : statistics output
+ */
+void stse_platform_ecc_get_key_pool_stats(stse_platform_ecc_key_pool_stats_t *pStats);
+#endif /* STSE_CONF_ECC_KEY_POOL_SIZE > 0 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STSE_PLATFORM_ECC_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,235 @@
+/******************************************************************************
+ * \file	stse_platform_frame_pool.c
+ * \brief   STSecureElement I2C frame buffer pool (fixed-size blocks)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include "Drivers/ram_arena/ram_arena.h"
+#include "stse_platform_frame_pool.h"
+#include "stse_platform_i2c.h"
+
+#ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
+
+#if (STSE_CONF_I2C_FRAME_POOL_SMALL_COUNT < 1) || (STSE_CONF_I2C_FRAME_POOL_SMALL_COUNT > 31) ||   \
+    (STSE_CONF_I2C_FRAME_POOL_MEDIUM_COUNT < 1) || (STSE_CONF_I2C_FRAME_POOL_MEDIUM_COUNT > 31) || \
+    (STSE_CONF_I2C_FRAME_POOL_LARGE_COUNT < 1) || (STSE_CONF_I2C_FRAME_POOL_LARGE_COUNT > 31)
+#error "STSE_CONF_I2C_FRAME_POOL_*_COUNT shall be within 1 and 31"
+#endif
+
+#define STSE_PLATFORM_FRAME_POOL_WORDS(size) (((size) + 3U) / sizeof(PLAT_UI32))
+#define STSE_PLATFORM_FRAME_POOL_MAP(count) ((1UL << (count)) - 1U)
+
+/* Size class descriptor */
+typedef struct {
+    PLAT_UI8 *pBlocks;
+    volatile PLAT_UI16 *pOwners; /* Ownership token of each block (0 = free) */
+    PLAT_UI16 stride;            /* Block size rounded up to a word multiple */
+    PLAT_UI16 block_size;
+    PLAT_UI8 block_count;
+} stse_platform_frame_pool_class_desc_t;
+
+static PLAT_UI32 frame_pool_small[STSE_CONF_I2C_FRAME_POOL_SMALL_COUNT]
+                                 [STSE_PLATFORM_FRAME_POOL_WORDS(STSE_PLATFORM_FRAME_POOL_SMALL_SIZE)] RAM_FAST_IO;
+static PLAT_UI32 frame_pool_medium[STSE_CONF_I2C_FRAME_POOL_MEDIUM_COUNT]
+                                  [STSE_PLATFORM_FRAME_POOL_WORDS(STSE_PLATFORM_FRAME_POOL_MEDIUM_SIZE)] RAM_FAST_IO;
+static PLAT_UI32 frame_pool_large[STSE_CONF_I2C_FRAME_POOL_LARGE_COUNT]
+                                 [STSE_PLATFORM_FRAME_POOL_WORDS(STSE_PLATFORM_FRAME_POOL_LARGE_SIZE)] RAM_FAST_IO;
+static volatile PLAT_UI16 frame_pool_small_owners[STSE_CONF_I2C_FRAME_POOL_SMALL_COUNT];
+static volatile PLAT_UI16 frame_pool_medium_owners[STSE_CONF_I2C_FRAME_POOL_MEDIUM_COUNT];
+static volatile PLAT_UI16 frame_pool_large_owners[STSE_CONF_I2C_FRAME_POOL_LARGE_COUNT];
+
+static const stse_platform_frame_pool_class_desc_t frame_pool_classes[STSE_PLATFORM_FRAME_POOL_CLASS_COUNT] = {
+    {(PLAT_UI8 *)frame_pool_small, frame_pool_small_owners, sizeof(frame_pool_small[0]),
+     STSE_PLATFORM_FRAME_POOL_SMALL_SIZE, STSE_CONF_I2C_FRAME_POOL_SMALL_COUNT},
+    {(PLAT_UI8 *)frame_pool_medium, frame_pool_medium_owners, sizeof(frame_pool_medium[0]),
+     STSE_PLATFORM_FRAME_POOL_MEDIUM_SIZE, STSE_CONF_I2C_FRAME_POOL_MEDIUM_COUNT},
+    {(PLAT_UI8 *)frame_pool_large, frame_pool_large_owners, sizeof(frame_pool_large[0]),
+     STSE_PLATFORM_FRAME_POOL_LARGE_SIZE, STSE_CONF_I2C_FRAME_POOL_LARGE_COUNT},
+};
+
+/* Free block map of each class (bit set = block free) */
+static volatile PLAT_UI32 frame_pool_free_map[STSE_PLATFORM_FRAME_POOL_CLASS_COUNT] = {
+    STSE_PLATFORM_FRAME_POOL_MAP(STSE_CONF_I2C_FRAME_POOL_SMALL_COUNT),
+    STSE_PLATFORM_FRAME_POOL_MAP(STSE_CONF_I2C_FRAME_POOL_MEDIUM_COUNT),
+    STSE_PLATFORM_FRAME_POOL_MAP(STSE_CONF_I2C_FRAME_POOL_LARGE_COUNT),
+};
+
+static volatile PLAT_UI32 frame_pool_token;
+static volatile PLAT_UI32 frame_pool_alloc_count[STSE_PLATFORM_FRAME_POOL_CLASS_COUNT];
+static volatile PLAT_UI32 frame_pool_max_in_use[STSE_PLATFORM_FRAME_POOL_CLASS_COUNT];
+static volatile PLAT_UI32 frame_pool_spill_count;
+static volatile PLAT_UI32 frame_pool_exhausted_count;
+static volatile PLAT_UI32 frame_pool_oversize_count;
+static volatile PLAT_UI32 frame_pool_reclaim_count;
+static volatile PLAT_UI32 frame_pool_stale_count;
+
+static void stse_platform_frame_pool_count(volatile PLAT_UI32 *pCounter) {
+    PLAT_UI32 value;
+
+    do {
+        value = __LDREXW(pCounter) + 1U;
+    } while (__STREXW(value, pCounter) != 0);
+}
+
+static void stse_platform_frame_pool_update_max(volatile PLAT_UI32 *pMax, PLAT_UI32 value) {
+    do {
+        if (__LDREXW(pMax) >= value) {
+            __CLREX();
+            return;
+        }
+    } while (__STREXW(value, pMax) != 0);
+}
+
+static PLAT_UI16 stse_platform_frame_pool_new_token(void) {
+    PLAT_UI32 token;
+
+    /* - 16-bit tokens, 0 is reserved for "no block held" */
+    do {
+        token = __LDREXW(&frame_pool_token) + 1U;
+        if ((token & 0xFFFFU) == 0) {
+            token++;
+        }
+    } while (__STREXW(token, &frame_pool_token) != 0);
+
+    return (PLAT_UI16)token;
+}
+
+static PLAT_I8 stse_platform_frame_pool_take(PLAT_UI8 class_id, PLAT_UI32 *pFree_map) {
+    volatile PLAT_UI32 *pMap = &frame_pool_free_map[class_id];
+    PLAT_UI32 map;
+    PLAT_UI8 index;
+
+    /* - Clear the lowest free bit of the class map */
+    do {
+        map = __LDREXW(pMap);
+        if (map == 0) {
+            __CLREX();
+            return -1;
+        }
+        index = __CLZ(__RBIT(map));
+        map &= ~(1UL << index);
+    } while (__STREXW(map, pMap) != 0);
+
+    *pFree_map = map;
+    return (PLAT_I8)index;
+}
+
+static void stse_platform_frame_pool_give(PLAT_UI8 class_id, PLAT_UI8 index) {
+    volatile PLAT_UI32 *pMap = &frame_pool_free_map[class_id];
+    PLAT_UI32 map;
+
+    do {
+        map = __LDREXW(pMap) | (1UL << index);
+    } while (__STREXW(map, pMap) != 0);
+}
+
+stse_ReturnCode_t stse_platform_frame_pool_alloc(stse_platform_frame_t *pFrame, PLAT_UI16 length) {
+    const stse_platform_frame_pool_class_desc_t *pClass;
+    PLAT_UI32 free_map = 0;
+    PLAT_I8 index = -1;
+    PLAT_UI8 class_id = 0;
+    PLAT_UI8 fit;
+
+    /* - Release the block of an aborted transaction */
+    if (pFrame->token != 0) {
+        stse_platform_frame_pool_count(&frame_pool_reclaim_count);
+        stse_platform_frame_pool_free(pFrame);
+    }
+
+    /* - Smallest fitting class, then the larger ones */
+    while ((class_id < STSE_PLATFORM_FRAME_POOL_CLASS_COUNT) && (length > frame_pool_classes[class_id].block_size)) {
+        class_id++;
+    }
+    if (class_id == STSE_PLATFORM_FRAME_POOL_CLASS_COUNT) {
+        stse_platform_frame_pool_count(&frame_pool_oversize_count);
+        return STSE_PLATFORM_BUFFER_ERR;
+    }
+    for (fit = class_id; class_id < STSE_PLATFORM_FRAME_POOL_CLASS_COUNT; class_id++) {
+        index = stse_platform_frame_pool_take(class_id, &free_map);
+        if (index >= 0) {
+            break;
+        }
+    }
+    if (index < 0) {
+        stse_platform_frame_pool_count(&frame_pool_exhausted_count);
+        return STSE_PLATFORM_BUFFER_ERR;
+    }
+    if (class_id != fit) {
+        stse_platform_frame_pool_count(&frame_pool_spill_count);
+    }
+
+    /* - The block is exclusively ours until its free bit is set again */
+    pClass = &frame_pool_classes[class_id];
+    pFrame->token = stse_platform_frame_pool_new_token();
+    pFrame->class_id = class_id;
+    pFrame->index = (PLAT_UI8)index;
+    pFrame->pBuffer = pClass->pBlocks + ((PLAT_UI32)index * pClass->stride);
+    pClass->pOwners[index] = pFrame->token;
+
+    stse_platform_frame_pool_count(&frame_pool_alloc_count[class_id]);
+    stse_platform_frame_pool_update_max(&frame_pool_max_in_use[class_id],
+                                        pClass->block_count - (PLAT_UI32)__builtin_popcount(free_map));
+
+    return STSE_OK;
+}
+
+PLAT_UI8 *stse_platform_frame_pool_buffer(const stse_platform_frame_t *pFrame) {
+    if ((pFrame->token == 0) || (pFrame->class_id >= STSE_PLATFORM_FRAME_POOL_CLASS_COUNT) ||
+        (frame_pool_classes[pFrame->class_id].pOwners[pFrame->index] != pFrame->token)) {
+        stse_platform_frame_pool_count(&frame_pool_stale_count);
+        return NULL;
+    }
+
+    return pFrame->pBuffer;
+}
+
+void stse_platform_frame_pool_free(stse_platform_frame_t *pFrame) {
+    volatile PLAT_UI16 *pOwner;
+
+    if ((pFrame->token == 0) || (pFrame->class_id >= STSE_PLATFORM_FRAME_POOL_CLASS_COUNT)) {
+        return;
+    }
+
+    /* - Drop the ownership only if the token still owns the block */
+    pOwner = &frame_pool_classes[pFrame->class_id].pOwners[pFrame->index];
+    do {
+        if (__LDREXH(pOwner) != pFrame->token) {
+            __CLREX();
+            stse_platform_frame_pool_count(&frame_pool_stale_count);
+            pFrame->token = 0;
+            pFrame->pBuffer = NULL;
+            return;
+        }
+    } while (__STREXH(0, pOwner) != 0);
+
+    stse_platform_frame_pool_give(pFrame->class_id, pFrame->index);
+    pFrame->token = 0;
+    pFrame->pBuffer = NULL;
+}
+
+void stse_platform_frame_pool_get_stats(stse_platform_frame_pool_stats_t *pStats) {
+    for (PLAT_UI8 class_id = 0; class_id < STSE_PLATFORM_FRAME_POOL_CLASS_COUNT; class_id++) {
+        pStats->alloc_count[class_id] = frame_pool_alloc_count[class_id];
+        pStats->in_use[class_id] = (PLAT_UI8)(frame_pool_classes[class_id].block_count -
+                                              __builtin_popcount(frame_pool_free_map[class_id]));
+        pStats->max_in_use[class_id] = (PLAT_UI8)frame_pool_max_in_use[class_id];
+    }
+    pStats->spill_count = frame_pool_spill_count;
+    pStats->exhausted_count = frame_pool_exhausted_count;
+    pStats->oversize_count = frame_pool_oversize_count;
+    pStats->reclaim_count = frame_pool_reclaim_count;
+    pStats->stale_count = frame_pool_stale_count;
+}
+
+#endif /* STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION */
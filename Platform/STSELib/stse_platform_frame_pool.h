@@ -0,0 +1,110 @@
+/******************************************************************************
+ * \file	stse_platform_frame_pool.h
+ * \brief   STSecureElement I2C frame buffer pool (fixed-size blocks)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STSE_PLATFORM_FRAME_POOL_H
+#define STSE_PLATFORM_FRAME_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stse_conf.h"
+#include "stselib.h"
+
+/* Block count of each size class (0 to 31 blocks) */
+#ifndef STSE_CONF_I2C_FRAME_POOL_SMALL_COUNT
+#define STSE_CONF_I2C_FRAME_POOL_SMALL_COUNT 2
+#endif
+#ifndef STSE_CONF_I2C_FRAME_POOL_MEDIUM_COUNT
+#define STSE_CONF_I2C_FRAME_POOL_MEDIUM_COUNT 1
+#endif
+#ifndef STSE_CONF_I2C_FRAME_POOL_LARGE_COUNT
+#define STSE_CONF_I2C_FRAME_POOL_LARGE_COUNT 1
+#endif
+
+/* Block size of each size class */
+#define STSE_PLATFORM_FRAME_POOL_SMALL_SIZE 64U   /* Short commands and responses (echo probes, status) */
+#define STSE_PLATFORM_FRAME_POOL_MEDIUM_SIZE 256U /* Certificates chunks, signatures */
+#define STSE_PLATFORM_FRAME_POOL_LARGE_SIZE 755U  /* A120 max input buffer size + length + header */
+
+/* Size classes */
+typedef enum {
+    STSE_PLATFORM_FRAME_POOL_SMALL = 0,
+    STSE_PLATFORM_FRAME_POOL_MEDIUM,
+    STSE_PLATFORM_FRAME_POOL_LARGE,
+    STSE_PLATFORM_FRAME_POOL_CLASS_COUNT
+} stse_platform_frame_pool_class_t;
+
+/* Frame buffer held by a transaction */
+typedef struct {
+    PLAT_UI8 *pBuffer;
+    PLAT_UI16 token; /* Ownership token of the block (0 = no block held) */
+    PLAT_UI8 class_id;
+    PLAT_UI8 index;
+} stse_platform_frame_t;
+
+/* Frame pool statistics */
+typedef struct {
+    PLAT_UI32 alloc_count[STSE_PLATFORM_FRAME_POOL_CLASS_COUNT]; /* Blocks handed out per class */
+    PLAT_UI32 spill_count;     /* Frames served by a larger class, best fitting class empty */
+    PLAT_UI32 exhausted_count; /* Frames rejected, no free block large enough */
+    PLAT_UI32 oversize_count;  /* Frames rejected, larger than the largest block */
+    PLAT_UI32 reclaim_count;   /* Blocks released by a new start (transaction aborted before stop) */
+    PLAT_UI32 stale_count;     /* Accesses and releases with a stale ownership token */
+    PLAT_UI8 in_use[STSE_PLATFORM_FRAME_POOL_CLASS_COUNT];     /* Blocks currently held per class */
+    PLAT_UI8 max_in_use[STSE_PLATFORM_FRAME_POOL_CLASS_COUNT]; /* Highest blocks held at the same time per class */
+} stse_platform_frame_pool_stats_t;
+
+/**
+ * \brief  Take a block for a frame from the smallest class that fits
+ * \details Lock-free and constant time (one free map per class). A frame still
+ *          holding a block (previous transaction aborted before its stop) is
+ *          released first.
+ * \param  pFrame : frame, receives the block and its ownership token
+ * \param  length : frame length
+ * \return STSE_OK on success, STSE_PLATFORM_BUFFER_ERR if no block is available
+ */
+stse_ReturnCode_t stse_platform_frame_pool_alloc(stse_platform_frame_t *pFrame, PLAT_UI16 length);
+
+/**
+ * \brief  Get the buffer of a frame
+ * \param  pFrame : frame
+ * \return frame buffer, NULL if the frame does not own its block any more
+ */
+PLAT_UI8 *stse_platform_frame_pool_buffer(const stse_platform_frame_t *pFrame);
+
+/**
+ * \brief  Return the block of a frame to the pool
+ * \details Releases with a stale token (block already returned) are counted and ignored.
+ * \param  pFrame : frame
+ */
+void stse_platform_frame_pool_free(stse_platform_frame_t *pFrame);
+
+/**
+ * \brief  Get the frame pool statistics
+ * \param  pStats : statistics output
+ */
+void stse_platform_frame_pool_get_stats(stse_platform_frame_pool_stats_t *pStats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STSE_PLATFORM_FRAME_POOL_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -17,50 +17,56 @@
 
 #include "Middleware/STM32_Cryptographic/include/cmox_crypto.h"
 #include "stse_conf.h"
+#include "stse_platform_hash.h"
+#include "stse_platform_profiler.h"
+#include "stse_platform_scratch.h"
 #include "stselib.h"
 
-static cmox_hash_algo_t stse_platform_get_cmox_hash_algo(stse_hash_algorithm_t hash_algo) {
-    switch (hash_algo) {
+/* Hash algorithm descriptor */
+typedef struct {
+    const cmox_hash_algo_t *pAlgo; /* CMOX algorithm, NULL when the hash is not enabled */
+    PLAT_UI8 digest_size;
+} stse_platform_hash_algo_t;
+
+/* Descriptors of the enabled hash algorithms, indexed by hash algorithm (disabled hashes are not linked) */
+static const stse_platform_hash_algo_t hash_algos[STSE_SHA_INVALID] = {
 #ifdef STSE_CONF_HASH_SHA_1
-    case STSE_SHA_1:
-        return CMOX_SHA1_ALGO;
+    [STSE_SHA_1] = {&CMOX_SHA1_ALGO, CMOX_SHA1_SIZE},
 #endif
 #ifdef STSE_CONF_HASH_SHA_224
-    case STSE_SHA_224:
-        return CMOX_SHA224_ALGO;
+    [STSE_SHA_224] = {&CMOX_SHA224_ALGO, CMOX_SHA224_SIZE},
 #endif
 #ifdef STSE_CONF_HASH_SHA_256
-    case STSE_SHA_256:
-        return CMOX_SHA256_ALGO;
+    [STSE_SHA_256] = {&CMOX_SHA256_ALGO, CMOX_SHA256_SIZE},
 #endif
 #ifdef STSE_CONF_HASH_SHA_384
-    case STSE_SHA_384:
-        return CMOX_SHA384_ALGO;
+    [STSE_SHA_384] = {&CMOX_SHA384_ALGO, CMOX_SHA384_SIZE},
 #endif
 #ifdef STSE_CONF_HASH_SHA_512
-    case STSE_SHA_512:
-        return CMOX_SHA512_ALGO;
+    [STSE_SHA_512] = {&CMOX_SHA512_ALGO, CMOX_SHA512_SIZE},
 #endif
 #ifdef STSE_CONF_HASH_SHA_3_256
-    case STSE_SHA3_256:
-        return CMOX_SHA3_256_ALGO;
+    [STSE_SHA3_256] = {&CMOX_SHA3_256_ALGO, CMOX_SHA3_256_SIZE},
 #endif
 #ifdef STSE_CONF_HASH_SHA_3_384
-    case STSE_SHA3_384:
-        return CMOX_SHA3_384_ALGO;
+    [STSE_SHA3_384] = {&CMOX_SHA3_384_ALGO, CMOX_SHA3_384_SIZE},
 #endif
 #ifdef STSE_CONF_HASH_SHA_3_512
-    case STSE_SHA3_512:
-        return CMOX_SHA3_512_ALGO;
+    [STSE_SHA3_512] = {&CMOX_SHA3_512_ALGO, CMOX_SHA3_512_SIZE},
 #endif
-    default:
+};
+
+static cmox_hash_algo_t stse_platform_get_cmox_hash_algo(stse_hash_algorithm_t hash_algo) {
+    if ((hash_algo >= STSE_SHA_INVALID) || (hash_algos[hash_algo].pAlgo == NULL)) {
         return NULL;
     }
+    return *hash_algos[hash_algo].pAlgo;
 }
 
 stse_ReturnCode_t stse_platform_hash_compute(stse_hash_algorithm_t hash_algo,
                                              PLAT_UI8 *pPayload, PLAT_UI16 payload_length,
                                              PLAT_UI8 *pHash, PLAT_UI16 *hash_length) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_HASH, payload_length);
 #if defined(STSE_CONF_HASH_SHA_1) || defined(STSE_CONF_HASH_SHA_224) ||                                      \
     defined(STSE_CONF_HASH_SHA_256) || defined(STSE_CONF_HASH_SHA_384) || defined(STSE_CONF_HASH_SHA_512) || \
     defined(STSE_CONF_HASH_SHA_3_256) || defined(STSE_CONF_HASH_SHA_3_284) || defined(STSE_CONF_HASH_SHA_3_512)
@@ -89,9 +95,130 @@ stse_ReturnCode_t stse_platform_hash_compute(stse_hash_algorithm_t hash_algo,
           STSE_CONF_HASH_SHA_3_256 || STSE_CONF_HASH_SHA_3_284 || STSE_CONF_HASH_SHA_3_512 */
 }
 
+stse_ReturnCode_t stse_platform_hash_init(stse_platform_hash_ctx_t *pCtx, stse_hash_algorithm_t hash_algo) {
+    cmox_hash_retval_t retval;
+
+    if (pCtx == NULL) {
+        return STSE_PLATFORM_HASH_ERROR;
+    }
+
+    /* - Construct the CMOX handle of the algorithm */
+    switch (hash_algo) {
+#ifdef STSE_CONF_HASH_SHA_1
+    case STSE_SHA_1:
+        pCtx->pHandle = cmox_sha1_construct(&pCtx->handle.sha1);
+        break;
+#endif
+#ifdef STSE_CONF_HASH_SHA_224
+    case STSE_SHA_224:
+        pCtx->pHandle = cmox_sha224_construct(&pCtx->handle.sha224);
+        break;
+#endif
+#ifdef STSE_CONF_HASH_SHA_256
+    case STSE_SHA_256:
+        pCtx->pHandle = cmox_sha256_construct(&pCtx->handle.sha256);
+        break;
+#endif
+#ifdef STSE_CONF_HASH_SHA_384
+    case STSE_SHA_384:
+        pCtx->pHandle = cmox_sha384_construct(&pCtx->handle.sha384);
+        break;
+#endif
+#ifdef STSE_CONF_HASH_SHA_512
+    case STSE_SHA_512:
+        pCtx->pHandle = cmox_sha512_construct(&pCtx->handle.sha512);
+        break;
+#endif
+#ifdef STSE_CONF_HASH_SHA_3_256
+    case STSE_SHA3_256:
+        pCtx->pHandle = cmox_sha3_256_construct(&pCtx->handle.sha3);
+        break;
+#endif
+#ifdef STSE_CONF_HASH_SHA_3_384
+    case STSE_SHA3_384:
+        pCtx->pHandle = cmox_sha3_384_construct(&pCtx->handle.sha3);
+        break;
+#endif
+#ifdef STSE_CONF_HASH_SHA_3_512
+    case STSE_SHA3_512:
+        pCtx->pHandle = cmox_sha3_512_construct(&pCtx->handle.sha3);
+        break;
+#endif
+    default:
+        pCtx->pHandle = NULL;
+        return STSE_PLATFORM_HASH_ERROR;
+    }
+    pCtx->digest_size = hash_algos[hash_algo].digest_size;
+
+    retval = cmox_hash_init(pCtx->pHandle);
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_setTagLen(pCtx->pHandle, pCtx->digest_size);
+    }
+    if (retval != CMOX_HASH_SUCCESS) {
+        stse_platform_hash_abort(pCtx);
+        return STSE_PLATFORM_HASH_ERROR;
+    }
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_hash_update(stse_platform_hash_ctx_t *pCtx, const PLAT_UI8 *pData, PLAT_UI32 data_length) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_HASH_UPDATE, data_length);
+    if (pCtx == NULL || pCtx->pHandle == NULL) {
+        return STSE_PLATFORM_HASH_ERROR;
+    }
+    if (data_length == 0) {
+        return STSE_OK;
+    }
+
+    if (cmox_hash_append(pCtx->pHandle, pData, data_length) != CMOX_HASH_SUCCESS) {
+        stse_platform_hash_abort(pCtx);
+        return STSE_PLATFORM_HASH_ERROR;
+    }
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_hash_final(stse_platform_hash_ctx_t *pCtx, PLAT_UI8 *pHash, PLAT_UI16 *hash_length) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_HASH_FINAL, 0);
+    cmox_hash_retval_t retval;
+    size_t cmox_hash_length = 0;
+
+    if (pCtx == NULL || pCtx->pHandle == NULL) {
+        return STSE_PLATFORM_HASH_ERROR;
+    }
+    if (*hash_length < pCtx->digest_size) {
+        stse_platform_hash_abort(pCtx);
+        return STSE_PLATFORM_HASH_ERROR;
+    }
+
+    retval = cmox_hash_generateTag(pCtx->pHandle, pHash, &cmox_hash_length);
+    stse_platform_hash_abort(pCtx);
+
+    /*- Verify Hash compute return */
+    if (retval != CMOX_HASH_SUCCESS || cmox_hash_length != pCtx->digest_size) {
+        return STSE_PLATFORM_HASH_ERROR;
+    }
+    *hash_length = pCtx->digest_size;
+
+    return STSE_OK;
+}
+
+void stse_platform_hash_abort(stse_platform_hash_ctx_t *pCtx) {
+    if (pCtx == NULL || pCtx->pHandle == NULL) {
+        return;
+    }
+
+    /* - Release the handle and wipe the intermediate state */
+    cmox_hash_cleanup(pCtx->pHandle);
+    pCtx->pHandle = NULL;
+    stse_platform_scratch_wipe(&pCtx->handle, sizeof(pCtx->handle));
+}
+
 stse_ReturnCode_t stse_platform_hmac_sha256_extract(PLAT_UI8 *pSalt, PLAT_UI16 salt_length,
                                                     PLAT_UI8 *pInput_keying_material, PLAT_UI16 input_keying_material_length,
                                                     PLAT_UI8 *pPseudorandom_key, PLAT_UI16 pseudorandom_key_expected_length) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_HKDF_EXTRACT, input_keying_material_length);
     cmox_mac_retval_t retval;
 
     size_t pseudorandom_key_length = pseudorandom_key_expected_length;
@@ -115,19 +242,178 @@ stse_ReturnCode_t stse_platform_hmac_sha256_extract(PLAT_UI8 *pSalt, PLAT_UI16 s
     return STSE_OK;
 }
 
+/* HMAC-SHA256 key schedule : SHA-256 states after the (key ^ ipad) and (key ^ opad) blocks */
+typedef struct {
+    cmox_sha256_handle_t inner;
+    cmox_sha256_handle_t outer;
+} stse_platform_hmac_sha256_key_t;
+
+static void stse_platform_hmac_sha256_wipe(stse_platform_hmac_sha256_key_t *pKey) {
+    cmox_hash_cleanup((cmox_hash_handle_t *)&pKey->inner);
+    cmox_hash_cleanup((cmox_hash_handle_t *)&pKey->outer);
+    stse_platform_scratch_wipe(pKey, sizeof(*pKey));
+}
+
+/* HKDF-SHA256 expand temporaries, allocated from the crypto scratch arena */
+typedef struct {
+    stse_platform_hmac_sha256_key_t prk;
+    PLAT_UI8 block[CMOX_SHA256_SIZE]; /* T(n) */
+} stse_platform_hkdf_sha256_scratch_t;
+
+_Static_assert(sizeof(stse_platform_hkdf_sha256_scratch_t) <= STSE_CONF_CRYPTO_SCRATCH_SIZE,
+               "STSE_CONF_CRYPTO_SCRATCH_SIZE is too small for HKDF-SHA256");
+
+/**
+ * \brief  Hash the inner and outer pads of a HMAC-SHA256 key once
+ */
+static stse_ReturnCode_t stse_platform_hmac_sha256_prepare(stse_platform_hmac_sha256_key_t *pKey,
+                                                           const PLAT_UI8 *pMac_key, PLAT_UI16 mac_key_length) {
+    PLAT_UI8 block[STSE_PLATFORM_HMAC_SHA256_BLOCK_SIZE] = {0};
+    cmox_hash_retval_t retval;
+
+    /* - RFC 2104 : keys longer than the block size are hashed first */
+    if (mac_key_length > STSE_PLATFORM_HMAC_SHA256_BLOCK_SIZE) {
+        retval = cmox_hash_compute(CMOX_SHA256_ALGO, pMac_key, mac_key_length, block, CMOX_SHA256_SIZE, NULL);
+        if (retval != CMOX_HASH_SUCCESS) {
+            return STSE_PLATFORM_HKDF_ERROR;
+        }
+    } else if (mac_key_length != 0) {
+        memcpy(block, pMac_key, mac_key_length);
+    }
+
+    for (PLAT_UI8 i = 0; i < STSE_PLATFORM_HMAC_SHA256_BLOCK_SIZE; i++) {
+        block[i] ^= 0x36;
+    }
+    retval = cmox_hash_init(cmox_sha256_construct(&pKey->inner));
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_setTagLen((cmox_hash_handle_t *)&pKey->inner, CMOX_SHA256_SIZE);
+    }
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_append((cmox_hash_handle_t *)&pKey->inner, block, sizeof(block));
+    }
+
+    for (PLAT_UI8 i = 0; i < STSE_PLATFORM_HMAC_SHA256_BLOCK_SIZE; i++) {
+        block[i] ^= (0x36 ^ 0x5C);
+    }
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_init(cmox_sha256_construct(&pKey->outer));
+    }
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_setTagLen((cmox_hash_handle_t *)&pKey->outer, CMOX_SHA256_SIZE);
+    }
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_append((cmox_hash_handle_t *)&pKey->outer, block, sizeof(block));
+    }
+
+    stse_platform_scratch_wipe(block, sizeof(block));
+    if (retval != CMOX_HASH_SUCCESS) {
+        stse_platform_hmac_sha256_wipe(pKey);
+        return STSE_PLATFORM_HKDF_ERROR;
+    }
+
+    return STSE_OK;
+}
+
+/**
+ * \brief  HMAC-SHA256 of (pData1 || pData2 || pData3) from cloned prepared states
+ * \details The prepared states are cloned by struct copy. CMOX does not document a
+ *          clone operation : this assumes the SHA-256 handle is self-contained (no
+ *          pointer into itself, state and pending block held by value). The
+ *          assumption is checked by stse_platform_hmac_sha256_check() against the
+ *          one-shot cmox_mac_compute().
+ */
+static stse_ReturnCode_t stse_platform_hmac_sha256_compute_prepared(const stse_platform_hmac_sha256_key_t *pKey,
+                                                                    const PLAT_UI8 *pData1, PLAT_UI16 data1_length,
+                                                                    const PLAT_UI8 *pData2, PLAT_UI16 data2_length,
+                                                                    const PLAT_UI8 *pData3, PLAT_UI16 data3_length,
+                                                                    PLAT_UI8 *pMac) {
+    cmox_sha256_handle_t state = pKey->inner; /* Clone : self-contained handle assumed, see above */
+    cmox_hash_handle_t *pHash = (cmox_hash_handle_t *)&state;
+    cmox_hash_retval_t retval = CMOX_HASH_SUCCESS;
+
+    /* - Inner hash */
+    if (data1_length != 0) {
+        retval = cmox_hash_append(pHash, pData1, data1_length);
+    }
+    if ((retval == CMOX_HASH_SUCCESS) && (data2_length != 0)) {
+        retval = cmox_hash_append(pHash, pData2, data2_length);
+    }
+    if ((retval == CMOX_HASH_SUCCESS) && (data3_length != 0)) {
+        retval = cmox_hash_append(pHash, pData3, data3_length);
+    }
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_generateTag(pHash, pMac, NULL);
+    }
+
+    /* - Outer hash */
+    if (retval == CMOX_HASH_SUCCESS) {
+        state = pKey->outer; /* Clone : self-contained handle assumed, see above */
+        retval = cmox_hash_append(pHash, pMac, CMOX_SHA256_SIZE);
+    }
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_generateTag(pHash, pMac, NULL);
+    }
+
+    cmox_hash_cleanup(pHash);
+    stse_platform_scratch_wipe(&state, sizeof(state));
+
+    return (retval == CMOX_HASH_SUCCESS) ? STSE_OK : STSE_PLATFORM_HKDF_ERROR;
+}
+
+stse_ReturnCode_t stse_platform_hmac_sha256_check(void) {
+    static const PLAT_UI16 key_lengths[] = {CMOX_SHA256_SIZE, STSE_PLATFORM_HMAC_SHA256_BLOCK_SIZE + 36U};
+    PLAT_UI8 key[STSE_PLATFORM_HMAC_SHA256_BLOCK_SIZE + 36U];
+    PLAT_UI8 data[150];
+    PLAT_UI8 mac[CMOX_SHA256_SIZE];
+    PLAT_UI8 mac_reference[CMOX_SHA256_SIZE];
+    stse_platform_hmac_sha256_key_t prepared;
+    stse_ReturnCode_t ret = STSE_OK;
+    size_t mac_length;
+
+    for (PLAT_UI16 i = 0; i < sizeof(key); i++) {
+        key[i] = (PLAT_UI8)(0xA0U + i);
+    }
+    for (PLAT_UI16 i = 0; i < sizeof(data); i++) {
+        data[i] = (PLAT_UI8)(i * 7U);
+    }
+
+    /* - Short key and key longer than the block size (hashed first) */
+    for (PLAT_UI8 k = 0; (k < (sizeof(key_lengths) / sizeof(key_lengths[0]))) && (ret == STSE_OK); k++) {
+        if (cmox_mac_compute(CMOX_HMAC_SHA256_ALGO, data, sizeof(data), key, key_lengths[k], NULL, 0,
+                             mac_reference, sizeof(mac_reference), &mac_length) != CMOX_MAC_SUCCESS) {
+            return STSE_PLATFORM_HKDF_ERROR;
+        }
+
+        ret = stse_platform_hmac_sha256_prepare(&prepared, key, key_lengths[k]);
+        if (ret != STSE_OK) {
+            return ret;
+        }
+
+        /* - Two clones of the same prepared states (a clone must not alter the original),
+         *   data split across block boundaries */
+        for (PLAT_UI8 n = 0; (n < 2) && (ret == STSE_OK); n++) {
+            ret = stse_platform_hmac_sha256_compute_prepared(&prepared, data, 1, &data[1], 70, &data[71], sizeof(data) - 71, mac);
+            if ((ret == STSE_OK) && (memcmp(mac, mac_reference, sizeof(mac)) != 0)) {
+                ret = STSE_PLATFORM_HKDF_ERROR;
+            }
+        }
+        stse_platform_hmac_sha256_wipe(&prepared);
+    }
+
+    return ret;
+}
+
 stse_ReturnCode_t stse_platform_hmac_sha256_expand(PLAT_UI8 *pPseudorandom_key, PLAT_UI16 pseudorandom_key_length,
                                                    PLAT_UI8 *pInfo, PLAT_UI16 info_length,
                                                    PLAT_UI8 *pOutput_keying_material, PLAT_UI16 output_keying_material_length) {
-    cmox_mac_retval_t retval;
-
-    PLAT_UI8 tmp[CMOX_SHA256_SIZE];
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_HKDF_EXPAND, output_keying_material_length);
+    stse_ReturnCode_t ret;
+    stse_platform_hkdf_sha256_scratch_t *pScratch;
+    PLAT_UI8 *tmp;
     PLAT_UI16 tmp_length = 0;
     PLAT_UI16 out_index = 0;
     PLAT_UI8 n = 0x1;
 
-    cmox_mac_handle_t *pMac_handle;
-    cmox_hmac_handle_t hmac_handle;
-
     /*	RFC 5869 : output keying material must be
 	 * 		- L <= 255*HashLen
 	 * 		- N = ceil(L/HashLen) */
@@ -135,48 +421,71 @@ stse_ReturnCode_t stse_platform_hmac_sha256_expand(PLAT_UI8 *pPseudorandom_key,
         return STSE_PLATFORM_HKDF_ERROR;
     }
 
-    pMac_handle = cmox_hmac_construct(&hmac_handle, CMOX_HMAC_SHA256);
-    retval = cmox_mac_init(pMac_handle);
-
-    if (retval != CMOX_MAC_SUCCESS) {
+    /* - Prepared states and T(n) block taken from the crypto scratch arena */
+    pScratch = stse_platform_scratch_alloc(sizeof(*pScratch));
+    if (pScratch == NULL) {
         return STSE_PLATFORM_HKDF_ERROR;
     }
+    tmp = pScratch->block;
+
+    /* - Pads hashed once, each block starts from a copy of the prepared states */
+    ret = stse_platform_hmac_sha256_prepare(&pScratch->prk, pPseudorandom_key, pseudorandom_key_length);
+    if (ret != STSE_OK) {
+        stse_platform_scratch_release(pScratch);
+        return ret;
+    }
 
     while (out_index < output_keying_material_length) {
         PLAT_UI16 left = output_keying_material_length - out_index;
 
-        retval = cmox_mac_setKey(pMac_handle, pPseudorandom_key, pseudorandom_key_length);
-        if (retval != CMOX_MAC_SUCCESS)
-            break;
-        retval = cmox_mac_append(pMac_handle, tmp, tmp_length);
-        if (retval != CMOX_MAC_SUCCESS)
-            break;
-        retval = cmox_mac_append(pMac_handle, pInfo, info_length);
-        if (retval != CMOX_MAC_SUCCESS)
-            break;
-        retval = cmox_mac_append(pMac_handle, &n, 1);
-        if (retval != CMOX_MAC_SUCCESS)
-            break;
-        retval = cmox_mac_generateTag(pMac_handle, tmp, NULL);
-        if (retval != CMOX_MAC_SUCCESS)
+        /* - T(n) = HMAC(PRK, T(n-1) || info || n) */
+        ret = stse_platform_hmac_sha256_compute_prepared(&pScratch->prk,
+                                                         tmp, tmp_length,
+                                                         pInfo, info_length,
+                                                         &n, 1,
+                                                         tmp);
+        if (ret != STSE_OK)
             break;
 
         left = left < CMOX_SHA256_SIZE ? left : CMOX_SHA256_SIZE;
         memcpy(pOutput_keying_material + out_index, tmp, left);
 
         tmp_length = CMOX_SHA256_SIZE;
-        out_index += CMOX_SHA256_SIZE;
+        out_index += left;
         n++;
     }
 
-    cmox_mac_cleanup(pMac_handle);
+    /* - Release the scratch region, prepared states and last block are wiped */
+    cmox_hash_cleanup((cmox_hash_handle_t *)&pScratch->prk.inner);
+    cmox_hash_cleanup((cmox_hash_handle_t *)&pScratch->prk.outer);
+    stse_platform_scratch_release(pScratch);
 
     /*- Verify MAC compute return */
-    if (retval != CMOX_MAC_SUCCESS) {
-        memset(tmp, 0, CMOX_SHA256_SIZE);
-        memset(pOutput_keying_material, 0, output_keying_material_length);
+    if (ret != STSE_OK) {
+        stse_platform_scratch_wipe(pOutput_keying_material, output_keying_material_length);
         return STSE_PLATFORM_HKDF_ERROR;
     }
 
     return STSE_OK;
 }
+
+stse_ReturnCode_t stse_platform_hkdf_sha256(PLAT_UI8 *pSalt, PLAT_UI16 salt_length,
+                                            PLAT_UI8 *pInput_keying_material, PLAT_UI16 input_keying_material_length,
+                                            PLAT_UI8 *pInfo, PLAT_UI16 info_length,
+                                            PLAT_UI8 *pOutput_keying_material, PLAT_UI16 output_keying_material_length) {
+    STSE_PLATFORM_PROFILE(STSE_PLATFORM_PROFILER_HKDF, output_keying_material_length);
+    stse_ReturnCode_t ret;
+    PLAT_UI8 prk[CMOX_SHA256_SIZE];
+
+    ret = stse_platform_hmac_sha256_extract(pSalt, salt_length,
+                                            pInput_keying_material, input_keying_material_length,
+                                            prk, sizeof(prk));
+    if (ret == STSE_OK) {
+        ret = stse_platform_hmac_sha256_expand(prk, sizeof(prk),
+                                               pInfo, info_length,
+                                               pOutput_keying_material, output_keying_material_length);
+    }
+    stse_platform_scratch_wipe(prk, sizeof(prk));
+
+    return ret;
+}
@@ -0,0 +1,130 @@
+/******************************************************************************
+ * \file	stse_platform_hash.h
+ * \brief   STSecureElement HASH platform extensions
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STSE_PLATFORM_HASH_H
+#define STSE_PLATFORM_HASH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "Middleware/STM32_Cryptographic/include/cmox_crypto.h"
+#include "stse_conf.h"
+#include "stselib.h"
+
+#define STSE_PLATFORM_HMAC_SHA256_BLOCK_SIZE 64U
+#define STSE_PLATFORM_HKDF_SHA256_MAX_OUTPUT_SIZE (255U * CMOX_SHA256_SIZE)
+
+/* Incremental hash context */
+typedef struct {
+    union {
+#ifdef STSE_CONF_HASH_SHA_1
+        cmox_sha1_handle_t sha1;
+#endif
+#ifdef STSE_CONF_HASH_SHA_224
+        cmox_sha224_handle_t sha224;
+#endif
+#ifdef STSE_CONF_HASH_SHA_256
+        cmox_sha256_handle_t sha256;
+#endif
+#ifdef STSE_CONF_HASH_SHA_384
+        cmox_sha384_handle_t sha384;
+#endif
+#ifdef STSE_CONF_HASH_SHA_512
+        cmox_sha512_handle_t sha512;
+#endif
+#if defined(STSE_CONF_HASH_SHA_3_256) || defined(STSE_CONF_HASH_SHA_3_384) || defined(STSE_CONF_HASH_SHA_3_512)
+        cmox_sha3_handle_t sha3;
+#endif
+        PLAT_UI8 none; /* No hash algorithm enabled */
+    } handle;
+    cmox_hash_handle_t *pHandle; /* NULL when the context is not started */
+    PLAT_UI16 digest_size;
+} stse_platform_hash_ctx_t;
+
+/**
+ * \brief  Start an incremental hash
+ * \param  pCtx : hash context
+ * \param  hash_algo : hash algorithm (STSE_CONF_HASH_* enabled algorithms)
+ * \return STSE_OK on success, STSE_PLATFORM_HASH_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_hash_init(stse_platform_hash_ctx_t *pCtx, stse_hash_algorithm_t hash_algo);
+
+/**
+ * \brief  Hash the next chunk of data
+ * \details Chunks can have any length (including 0), the digest is the one of
+ *          their concatenation, as computed by stse_platform_hash_compute().
+ *          The context is released on error.
+ * \param  pCtx : started hash context
+ * \param  pData : data chunk
+ * \param  data_length : data chunk length
+ * \return STSE_OK on success, STSE_PLATFORM_HASH_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_hash_update(stse_platform_hash_ctx_t *pCtx, const PLAT_UI8 *pData, PLAT_UI32 data_length);
+
+/**
+ * \brief  Output the digest and release the context
+ * \param  pCtx : started hash context
+ * \param  pHash : digest output
+ * \param  hash_length : in : digest buffer size, out : digest length
+ * \return STSE_OK on success, STSE_PLATFORM_HASH_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_hash_final(stse_platform_hash_ctx_t *pCtx, PLAT_UI8 *pHash, PLAT_UI16 *hash_length);
+
+/**
+ * \brief  Release a started context without digest (aborted transfer)
+ * \param  pCtx : hash context
+ */
+void stse_platform_hash_abort(stse_platform_hash_ctx_t *pCtx);
+
+/**
+ * \brief  Known-answer check of the prepared HMAC-SHA256 path
+ * \details HKDF expand clones prepared SHA-256 states by struct copy, which CMOX does
+ *          not document. The prepared path is compared with the one-shot
+ *          cmox_mac_compute(CMOX_HMAC_SHA256_ALGO) for a short and a long key.
+ * \return STSE_OK if the results match, STSE_PLATFORM_HKDF_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_hmac_sha256_check(void);
+
+/**
+ * \brief  HKDF-SHA256 (RFC 5869) extract and expand in one call
+ * \details The pseudorandom key stays on the stack and is zeroised before return.
+ *          The HMAC pads of the pseudorandom key are hashed once for all the
+ *          output blocks, as in stse_platform_hmac_sha256_expand().
+ * \param  pSalt : salt (can be empty)
+ * \param  salt_length : salt length
+ * \param  pInput_keying_material : input keying material
+ * \param  input_keying_material_length : input keying material length
+ * \param  pInfo : context and application specific information
+ * \param  info_length : info length
+ * \param  pOutput_keying_material : output keying material
+ * \param  output_keying_material_length : output keying material length (up to 255 * 32 bytes)
+ * \return STSE_OK on success, STSE_PLATFORM_HKDF_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_hkdf_sha256(PLAT_UI8 *pSalt, PLAT_UI16 salt_length,
+                                            PLAT_UI8 *pInput_keying_material, PLAT_UI16 input_keying_material_length,
+                                            PLAT_UI8 *pInfo, PLAT_UI16 info_length,
+                                            PLAT_UI8 *pOutput_keying_material, PLAT_UI16 output_keying_material_length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STSE_PLATFORM_HASH_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -15,62 +15,164 @@
  ******************************************************************************
  */
 
+#include "Drivers/ram_arena/ram_arena.h"
 #include "core/stse_platform.h"
 #include "drivers/i2c/I2C.h"
-#include <stdlib.h>
+#include "stse_platform_delay.h"
+#include "stse_platform_frame_pool.h"
+#include "stse_platform_i2c.h"
+
+/* Frame in flight for one (bus, device) pair, from start to stop */
+typedef struct {
+    PLAT_UI8 busID;
+    PLAT_UI8 devAddr;
+    PLAT_UI8 active;
+    PLAT_UI16 frame_size;
+    volatile PLAT_UI16 frame_offset;
+#ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
+    stse_platform_frame_t frame; /* Frame pool block of the transaction */
+#endif
+} stse_platform_i2c_frame_ctx_t;
+
+#ifndef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
+static PLAT_UI8 I2c_buffer[STSE_CONF_I2C_FRAME_CONTEXT_COUNT][755U] RAM_FAST_IO; // Set to A120 max input buffer size + 2 bytes needed for response length + 1 byte for command or response header. Shall be adapted to applicative use case!
+#endif
+static stse_platform_i2c_frame_ctx_t i2c_frame_ctx[STSE_CONF_I2C_FRAME_CONTEXT_COUNT];
+
+/* busID to I2C peripheral (0 kept as an alias of I2C1) */
+static I2C_TypeDef *const i2c_buses[] = {I2C1, I2C1, I2C2, I2C3};
+
+static I2C_TypeDef *stse_platform_i2c_bus(PLAT_UI8 busID) {
+    return (busID < (sizeof(i2c_buses) / sizeof(i2c_buses[0]))) ? i2c_buses[busID] : NULL;
+}
+
+static stse_platform_i2c_frame_ctx_t *stse_platform_i2c_frame_ctx_get(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI8 claim) {
+    stse_platform_i2c_frame_ctx_t *pFree = NULL;
+    PLAT_UI32 primask = __get_PRIMASK();
 
-//#define STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
+    __disable_irq();
+    for (PLAT_UI8 i = 0; i < STSE_CONF_I2C_FRAME_CONTEXT_COUNT; i++) {
+        stse_platform_i2c_frame_ctx_t *pCtx = &i2c_frame_ctx[i];
 
+        /* - Frame of the device already in flight (or aborted before its stop) */
+        if (pCtx->active && (pCtx->busID == busID) && (pCtx->devAddr == devAddr)) {
+            __set_PRIMASK(primask);
+            return pCtx;
+        }
+        if (!pCtx->active && (pFree == NULL)) {
+            pFree = pCtx;
+        }
+    }
+    if (claim && (pFree != NULL)) {
+        pFree->busID = busID;
+        pFree->devAddr = devAddr;
+        pFree->active = 1;
+    } else {
+        pFree = NULL;
+    }
+    __set_PRIMASK(primask);
+
+    return pFree;
+}
+
+static void stse_platform_i2c_frame_ctx_release(stse_platform_i2c_frame_ctx_t *pCtx) {
 #ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
-static PLAT_UI8 *pI2c_buffer;
+    /* - Return the i2c buffer to the frame pool */
+    stse_platform_frame_pool_free(&pCtx->frame);
+#endif
+    pCtx->frame_offset = 0;
+    pCtx->active = 0;
+}
+
+static PLAT_UI8 *stse_platform_i2c_buffer(stse_platform_i2c_frame_ctx_t *pCtx) {
+#ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
+    /* - NULL if the transaction does not own its frame block any more */
+    return stse_platform_frame_pool_buffer(&pCtx->frame);
 #else
-static PLAT_UI8 I2c_buffer[755U]; // Set to A120 max input buffer size + 2 bytes needed for response length + 1 byte for command or response header. Shall be adapted to applicative use case!
+    return I2c_buffer[pCtx - i2c_frame_ctx];
 #endif
-static PLAT_UI16 i2c_frame_size;
-static volatile PLAT_UI16 i2c_frame_offset;
+}
 
 stse_ReturnCode_t stse_platform_i2c_init(PLAT_UI8 busID) {
-    (void)busID;
-    return (stse_ReturnCode_t)i2c_init(I2C1);
+    I2C_TypeDef *pI2C = stse_platform_i2c_bus(busID);
+
+    if (pI2C == NULL) {
+        return STSE_PLATFORM_INVALID_PARAMETER;
+    }
+
+    i2c_io_init(pI2C);
+    return (stse_ReturnCode_t)i2c_init(pI2C);
 }
 
 stse_ReturnCode_t stse_platform_i2c_wake(PLAT_UI8 busID,
                                          PLAT_UI8 devAddr,
                                          PLAT_UI16 speed) {
-    (void)busID;
+    I2C_TypeDef *pI2C = stse_platform_i2c_bus(busID);
     (void)speed;
 
-    i2c_wake(I2C1, devAddr);
+    if (pI2C == NULL) {
+        return STSE_PLATFORM_INVALID_PARAMETER;
+    }
+
+    i2c_wake(pI2C, devAddr);
 
     return (STSE_OK);
 }
 
+stse_ReturnCode_t stse_platform_i2c_probe(PLAT_UI8 busID,
+                                          PLAT_UI8 devAddr) {
+    I2C_TypeDef *pI2C = stse_platform_i2c_bus(busID);
+
+    if (pI2C == NULL) {
+        return STSE_PLATFORM_INVALID_PARAMETER;
+    }
+
+    /* - Reset the peripheral only if the previous transfer was aborted (disabled or bus still busy) */
+    if (!(pI2C->CR1 & I2C_CR1_PE) || (pI2C->ISR & I2C_ISR_BUSY)) {
+        i2c_init(pI2C);
+    }
+
+    if (i2c_probe(pI2C, devAddr) != 0) {
+        return STSE_PLATFORM_BUS_ACK_ERROR;
+    }
+
+    return STSE_OK;
+}
+
 stse_ReturnCode_t stse_platform_i2c_send_start(
     PLAT_UI8 busID,
     PLAT_UI8 devAddr,
     PLAT_UI16 speed,
     PLAT_UI16 FrameLength) {
-    (void)busID;
-    (void)devAddr;
+    stse_platform_i2c_frame_ctx_t *pCtx;
     (void)speed;
 
-#ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
-    /* - Allocate Communication buffer */
-    pI2c_buffer = malloc(FrameLength);
+    if (stse_platform_i2c_bus(busID) == NULL) {
+        return STSE_PLATFORM_INVALID_PARAMETER;
+    }
 
-    /* - Check buffer overflow */
-    if (pI2c_buffer == NULL) {
+    /* - Frame context of the device (all contexts in flight : buffer error) */
+    pCtx = stse_platform_i2c_frame_ctx_get(busID, devAddr, 1);
+    if (pCtx == NULL) {
+        return STSE_PLATFORM_BUFFER_ERR;
+    }
+
+#ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
+    /* - Take a communication buffer from the frame pool */
+    if (stse_platform_frame_pool_alloc(&pCtx->frame, FrameLength) != STSE_OK) {
+        stse_platform_i2c_frame_ctx_release(pCtx);
         return STSE_PLATFORM_BUFFER_ERR;
     }
 #else
     /* - Check buffer overflow */
-    if (FrameLength > sizeof(I2c_buffer) / sizeof(I2c_buffer[0])) {
+    if (FrameLength > sizeof(I2c_buffer[0]) / sizeof(I2c_buffer[0][0])) {
+        stse_platform_i2c_frame_ctx_release(pCtx);
         return STSE_PLATFORM_BUFFER_ERR;
     }
 #endif
 
-    i2c_frame_size = FrameLength;
-    i2c_frame_offset = 0;
+    pCtx->frame_size = FrameLength;
+    pCtx->frame_offset = 0;
 
     return STSE_OK;
 }
@@ -81,25 +183,30 @@ stse_ReturnCode_t stse_platform_i2c_send_continue(
     PLAT_UI16 speed,
     PLAT_UI8 *pData,
     PLAT_UI16 data_size) {
-    (void)busID;
-    (void)devAddr;
+    stse_platform_i2c_frame_ctx_t *pCtx = stse_platform_i2c_frame_ctx_get(busID, devAddr, 0);
+    PLAT_UI8 *pI2c_buffer;
     (void)speed;
 
+    if (pCtx == NULL) {
+        return STSE_PLATFORM_BUFFER_ERR;
+    }
+    pI2c_buffer = stse_platform_i2c_buffer(pCtx);
+    if (pI2c_buffer == NULL) {
+        return STSE_PLATFORM_BUFFER_ERR;
+    }
+
     if (data_size != 0) {
+        /* - Check frame overflow */
+        if ((pCtx->frame_size - pCtx->frame_offset) < data_size) {
+            return STSE_PLATFORM_BUFFER_ERR;
+        }
+
         if (pData == NULL) {
-#ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
-            memset((pI2c_buffer + i2c_frame_offset), 0x00, data_size);
-#else
-            memset((I2c_buffer + i2c_frame_offset), 0x00, data_size);
-#endif
+            memset((pI2c_buffer + pCtx->frame_offset), 0x00, data_size);
         } else {
-#ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
-            memcpy((pI2c_buffer + i2c_frame_offset), pData, data_size);
-#else
-            memcpy((I2c_buffer + i2c_frame_offset), pData, data_size);
-#endif
+            memcpy((pI2c_buffer + pCtx->frame_offset), pData, data_size);
         }
-        i2c_frame_offset += data_size;
+        pCtx->frame_offset += data_size;
     }
 
     return STSE_OK;
@@ -111,6 +218,7 @@ stse_ReturnCode_t stse_platform_i2c_send_stop(
     PLAT_UI16 speed,
     PLAT_UI8 *pData,
     PLAT_UI16 data_size) {
+    stse_platform_i2c_frame_ctx_t *pCtx;
     stse_ReturnCode_t ret;
 
     ret = stse_platform_i2c_send_continue(
@@ -120,19 +228,18 @@ stse_ReturnCode_t stse_platform_i2c_send_stop(
         pData,
         data_size);
 
+    pCtx = stse_platform_i2c_frame_ctx_get(busID, devAddr, 0);
+    if (pCtx == NULL) {
+        return STSE_PLATFORM_BUFFER_ERR;
+    }
+
     /* - Send I2C frame buffer */
     if (ret == STSE_OK) {
-#ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
-        ret = (stse_ReturnCode_t)i2c_write(I2C1, devAddr, speed, pI2c_buffer, i2c_frame_size);
-#else
-        ret = (stse_ReturnCode_t)i2c_write(I2C1, devAddr, speed, I2c_buffer, i2c_frame_size);
-#endif
+        ret = (stse_ReturnCode_t)i2c_write(stse_platform_i2c_bus(busID), devAddr, speed,
+                                           stse_platform_i2c_buffer(pCtx), pCtx->frame_size);
     }
 
-#ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
-    /* - Free memory allocated to i2c buffer*/
-    free(pI2c_buffer);
-#endif
+    stse_platform_i2c_frame_ctx_release(pCtx);
 
     if (ret != STSE_OK) {
         ret = STSE_PLATFORM_BUS_ACK_ERROR;
@@ -146,34 +253,49 @@ stse_ReturnCode_t stse_platform_i2c_receive_start(
     PLAT_UI8 devAddr,
     PLAT_UI16 speed,
     PLAT_UI16 frameLength) {
-    (void)busID;
+    I2C_TypeDef *pI2C = stse_platform_i2c_bus(busID);
+    stse_platform_i2c_frame_ctx_t *pCtx;
     PLAT_I8 ret = 1;
 
+    if (pI2C == NULL) {
+        return STSE_PLATFORM_INVALID_PARAMETER;
+    }
+
+    /* - Frame context of the device (all contexts in flight : buffer error) */
+    pCtx = stse_platform_i2c_frame_ctx_get(busID, devAddr, 1);
+    if (pCtx == NULL) {
+        return STSE_PLATFORM_BUFFER_ERR;
+    }
+
     /* - Store response Length */
-    i2c_frame_size = frameLength;
+    pCtx->frame_size = frameLength;
 
 #ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
-    /* - Allocate Communication buffer */
-    pI2c_buffer = malloc(frameLength);
-
+    /* - Take a communication buffer from the frame pool */
+    if (stse_platform_frame_pool_alloc(&pCtx->frame, frameLength) != STSE_OK) {
+        stse_platform_i2c_frame_ctx_release(pCtx);
+        return STSE_PLATFORM_BUFFER_ERR;
+    }
+#else
     /* - Check buffer overflow */
-    if (pI2c_buffer == NULL) {
+    if (frameLength > sizeof(I2c_buffer[0]) / sizeof(I2c_buffer[0][0])) {
+        stse_platform_i2c_frame_ctx_release(pCtx);
         return STSE_PLATFORM_BUFFER_ERR;
     }
 #endif
 
     /* - Read full Frame */
-#ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
-    ret = i2c_read(I2C1, devAddr, speed, pI2c_buffer, i2c_frame_size);
-#else
-    ret = i2c_read(I2C1, devAddr, speed, I2c_buffer, i2c_frame_size);
-#endif
+    ret = i2c_read(pI2C, devAddr, speed, stse_platform_i2c_buffer(pCtx), pCtx->frame_size);
     if (ret != 0) {
+        /* - No receive stop follows a failed read */
+        stse_platform_i2c_frame_ctx_release(pCtx);
+        /* - Response not ready : lend the polling interval to the delay idle hook */
+        stse_platform_delay_yield_poll(STSE_POLLING_RETRY_INTERVAL);
         return STSE_PLATFORM_BUS_ACK_ERROR;
     }
 
     /* - Reset read offset */
-    i2c_frame_offset = 0;
+    pCtx->frame_offset = 0;
 
     return STSE_OK;
 }
@@ -184,25 +306,29 @@ stse_ReturnCode_t stse_platform_i2c_receive_continue(
     PLAT_UI16 speed,
     PLAT_UI8 *pData,
     PLAT_UI16 data_size) {
-    (void)busID;
-    (void)devAddr;
+    stse_platform_i2c_frame_ctx_t *pCtx = stse_platform_i2c_frame_ctx_get(busID, devAddr, 0);
+    PLAT_UI8 *pI2c_buffer;
     (void)speed;
 
+    if (pCtx == NULL) {
+        return STSE_PLATFORM_BUFFER_ERR;
+    }
+    pI2c_buffer = stse_platform_i2c_buffer(pCtx);
+    if (pI2c_buffer == NULL) {
+        return STSE_PLATFORM_BUFFER_ERR;
+    }
+
     if (pData != NULL) {
         /* Check read overflow */
-        if ((i2c_frame_size - i2c_frame_offset) < data_size) {
+        if ((pCtx->frame_size - pCtx->frame_offset) < data_size) {
             return STSE_PLATFORM_BUFFER_ERR;
         }
 
         /* Copy buffer content */
-#ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
-        memcpy(pData, (pI2c_buffer + i2c_frame_offset), data_size);
-#else
-        memcpy(pData, (I2c_buffer + i2c_frame_offset), data_size);
-#endif
+        memcpy(pData, (pI2c_buffer + pCtx->frame_offset), data_size);
     }
 
-    i2c_frame_offset += data_size;
+    pCtx->frame_offset += data_size;
 
     return STSE_OK;
 }
@@ -213,16 +339,17 @@ stse_ReturnCode_t stse_platform_i2c_receive_stop(
     PLAT_UI16 speed,
     PLAT_UI8 *pData,
     PLAT_UI16 data_size) {
+    stse_platform_i2c_frame_ctx_t *pCtx;
     stse_ReturnCode_t ret;
 
     /*- Copy last element*/
     ret = stse_platform_i2c_receive_continue(busID, devAddr, speed, pData, data_size);
 
-    i2c_frame_offset = 0;
+    /*- Release the frame context of the device*/
+    pCtx = stse_platform_i2c_frame_ctx_get(busID, devAddr, 0);
+    if (pCtx != NULL) {
+        stse_platform_i2c_frame_ctx_release(pCtx);
+    }
 
-#ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
-    /*- Free i2c buffer*/
-    free(pI2c_buffer);
-#endif
     return ret;
 }
@@ -0,0 +1,53 @@
+/******************************************************************************
+ * \file	stse_platform_i2c.h
+ * \brief   STSecureElement I2C platform extensions
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STSE_PLATFORM_I2C_H
+#define STSE_PLATFORM_I2C_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stse_conf.h"
+#include "stselib.h"
+
+/* I2C frames in flight at the same time : one frame context per (bus, device) pair, from start to stop.
+ * busID 1, 2 and 3 select I2C1, I2C2 and I2C3 (0 is an alias of I2C1) */
+#ifndef STSE_CONF_I2C_FRAME_CONTEXT_COUNT
+#define STSE_CONF_I2C_FRAME_CONTEXT_COUNT 1
+#endif
+
+/* Per transaction frame buffers taken from the frame pool (stse_platform_frame_pool.h)
+ * instead of the static 755-byte frame buffer */
+//#define STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
+
+/**
+ * \brief  Check that a target acknowledges its address on the bus
+ * \param  busID : bus identifier
+ * \param  devAddr : 7-bit target address
+ * \return STSE_OK if the address is acknowledged, STSE_PLATFORM_BUS_ACK_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_i2c_probe(PLAT_UI8 busID, PLAT_UI8 devAddr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STSE_PLATFORM_I2C_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
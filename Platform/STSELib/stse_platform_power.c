@@ -15,49 +15,120 @@
  ******************************************************************************
  */
 
+#include "Drivers/cycle_counter/cycle_counter.h"
+#include "Drivers/delay_ms/delay_ms.h"
 #include "stm32l4xx.h"
 #include "stse_conf.h"
+#include "stse_platform_i2c.h"
+#include "stse_platform_power.h"
 #include "stselib.h"
 
+#define STSE_PLATFORM_POWER_SLOT_UNMAPPED 0xFFU
+
+typedef struct {
+    GPIO_TypeDef *pPort;
+    PLAT_UI8 pin;
+    PLAT_UI8 bus;
+    PLAT_UI8 devAddr;
+} stse_platform_power_slot_t;
+
+/* STSAFE slots power lines (open-drain, active low) */
+static stse_platform_power_slot_t power_slots[STSE_PLATFORM_POWER_SLOT_COUNT] = {
+    {GPIOC, 0, STSE_PLATFORM_POWER_SLOT_UNMAPPED, 0}, /* PC0 */
+    {GPIOC, 1, STSE_PLATFORM_POWER_SLOT_UNMAPPED, 0}, /* PC1 */
+    {GPIOB, 0, STSE_PLATFORM_POWER_SLOT_UNMAPPED, 0}, /* PB0 */
+};
+
+static stse_platform_power_slot_t *stse_platform_power_get_slot(PLAT_UI8 bus, PLAT_UI8 devAddr) {
+    for (PLAT_UI8 i = 0; i < STSE_PLATFORM_POWER_SLOT_COUNT; i++) {
+        if ((power_slots[i].bus == bus) && (power_slots[i].devAddr == devAddr)) {
+            return &power_slots[i];
+        }
+    }
+    return NULL;
+}
+
+static void stse_platform_power_set(PLAT_UI8 bus, PLAT_UI8 devAddr, PLAT_UI8 on) {
+    stse_platform_power_slot_t *pSlot = stse_platform_power_get_slot(bus, devAddr);
+
+    for (PLAT_UI8 i = 0; i < STSE_PLATFORM_POWER_SLOT_COUNT; i++) {
+        /* - Unmapped targets drive all the STSAFE SLOTS */
+        if ((pSlot == NULL) || (pSlot == &power_slots[i])) {
+            if (on) {
+                power_slots[i].pPort->BRR = (1UL << power_slots[i].pin);
+            } else {
+                power_slots[i].pPort->BSRR = (1UL << power_slots[i].pin);
+            }
+        }
+    }
+}
+
 stse_ReturnCode_t stse_platform_power_init(void) {
-    /* -Initialize power line control (PC0  - open-drain) */
-    GPIOC->MODER &= ~(GPIO_MODER_MODE0_Msk);
-    GPIOC->MODER |= (1 << GPIO_MODER_MODE0_Pos);
-    GPIOC->ODR &= ~(1 << GPIO_ODR_OD0_Pos);
+    /* - Initialize power lines control (PC0, PC1, PB0 - open-drain) */
+    for (PLAT_UI8 i = 0; i < STSE_PLATFORM_POWER_SLOT_COUNT; i++) {
+        GPIO_TypeDef *pPort = power_slots[i].pPort;
+        PLAT_UI8 pin = power_slots[i].pin;
+
+        pPort->MODER &= ~(GPIO_MODER_MODE0_Msk << (pin * 2));
+        pPort->MODER |= (1UL << (pin * 2));
+        pPort->ODR &= ~(1UL << pin);
+    }
 
-    /* -Initialize power line control (PC1  - open-drain) */
-    GPIOC->MODER &= ~(GPIO_MODER_MODE1_Msk);
-    GPIOC->MODER |= (1 << GPIO_MODER_MODE1_Pos);
-    GPIOC->ODR &= ~(1 << GPIO_ODR_OD1_Pos);
+    return STSE_OK;
+}
 
-    /* -Initialize power line control (PB0  - open-drain) */
-    GPIOB->MODER &= ~(GPIO_MODER_MODE0_Msk);
-    GPIOB->MODER |= (1 << GPIO_MODER_MODE0_Pos);
-    GPIOB->ODR &= ~(1 << GPIO_ODR_OD0_Pos);
+stse_ReturnCode_t stse_platform_power_map_slot(PLAT_UI8 slot, PLAT_UI8 bus, PLAT_UI8 devAddr) {
+    if (slot >= STSE_PLATFORM_POWER_SLOT_COUNT) {
+        return STSE_PLATFORM_INVALID_PARAMETER;
+    }
+
+    power_slots[slot].bus = bus;
+    power_slots[slot].devAddr = devAddr;
 
     return STSE_OK;
 }
 
 stse_ReturnCode_t stse_platform_power_on(PLAT_UI8 bus, PLAT_UI8 devAddr) {
-    (void)bus;
-    (void)devAddr;
-
-    /* - Power on all the STSAFE SLOTS */
-    GPIOB->ODR &= ~(1 << GPIO_ODR_OD0_Pos);
-    GPIOC->ODR &= ~(1 << GPIO_ODR_OD0_Pos);
-    GPIOC->ODR &= ~(1 << GPIO_ODR_OD1_Pos);
+    /* - Power on the STSAFE SLOT (all slots if not mapped) */
+    stse_platform_power_set(bus, devAddr, 1);
 
     return (STSE_OK);
 }
 
 stse_ReturnCode_t stse_platform_power_off(PLAT_UI8 bus, PLAT_UI8 devAddr) {
-    (void)bus;
-    (void)devAddr;
-
-    /* - Power-off all the STSAFE SLOTS */
-    GPIOB->ODR |= (1 << GPIO_ODR_OD0_Pos);
-    GPIOC->ODR |= (1 << GPIO_ODR_OD0_Pos);
-    GPIOC->ODR |= (1 << GPIO_ODR_OD1_Pos);
+    /* - Power-off the STSAFE SLOT (all slots if not mapped) */
+    stse_platform_power_set(bus, devAddr, 0);
 
     return (STSE_OK);
 }
+
+stse_ReturnCode_t stse_platform_power_cycle(PLAT_UI8 bus, PLAT_UI8 devAddr,
+                                            PLAT_UI16 off_time_ms, PLAT_UI16 ready_timeout_ms,
+                                            PLAT_UI32 *pBoot_time_us) {
+    stse_ReturnCode_t ret;
+    PLAT_UI32 start;
+    PLAT_UI32 elapsed;
+    PLAT_UI32 timeout = (PLAT_UI32)(((PLAT_UI64)SystemCoreClock * ready_timeout_ms) / 1000U);
+
+    cycle_counter_init();
+
+    /* - Power-off the slot and let its supply discharge */
+    stse_platform_power_set(bus, devAddr, 0);
+    if (off_time_ms != 0) {
+        delay_ms(off_time_ms);
+    }
+
+    /* - Power on and poll for the first address acknowledge */
+    stse_platform_power_set(bus, devAddr, 1);
+    start = cycle_counter_get();
+    do {
+        ret = stse_platform_i2c_probe(bus, devAddr);
+        elapsed = cycle_counter_get() - start;
+    } while ((ret != STSE_OK) && (elapsed < timeout));
+
+    if (pBoot_time_us != NULL) {
+        *pBoot_time_us = cycle_counter_to_us(elapsed);
+    }
+
+    return ret;
+}
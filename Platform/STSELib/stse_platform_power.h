@@ -0,0 +1,60 @@
+/******************************************************************************
+ * \file	stse_platform_power.h
+ * \brief   STSecureElement power platform extensions
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STSE_PLATFORM_POWER_H
+#define STSE_PLATFORM_POWER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stselib.h"
+
+/* Number of STSAFE slots power lines (PC0, PC1, PB0) */
+#define STSE_PLATFORM_POWER_SLOT_COUNT 3U
+
+/**
+ * \brief  Map a target (bus, devAddr) to a slot power line
+ * \details Power on/off requests of unmapped targets drive all the slots
+ * \param  slot : power line index (0 = PC0, 1 = PC1, 2 = PB0)
+ * \param  bus : target bus identifier
+ * \param  devAddr : target 7-bit address
+ * \return STSE_OK on success, STSE_PLATFORM_INVALID_PARAMETER otherwise
+ */
+stse_ReturnCode_t stse_platform_power_map_slot(PLAT_UI8 slot, PLAT_UI8 bus, PLAT_UI8 devAddr);
+
+/**
+ * \brief  Power-cycle a single target and wait for its first address acknowledge
+ * \param  bus : target bus identifier
+ * \param  devAddr : target 7-bit address
+ * \param  off_time_ms : power-off (discharge) time in milliseconds
+ * \param  ready_timeout_ms : maximum time to wait for the first acknowledge
+ * \param  pBoot_time_us : measured power-on to first acknowledge time (can be NULL)
+ * \return STSE_OK if the target answered in time, STSE_PLATFORM_BUS_ACK_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_power_cycle(PLAT_UI8 bus, PLAT_UI8 devAddr,
+                                            PLAT_UI16 off_time_ms, PLAT_UI16 ready_timeout_ms,
+                                            PLAT_UI32 *pBoot_time_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STSE_PLATFORM_POWER_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
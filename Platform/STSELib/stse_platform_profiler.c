@@ -0,0 +1,89 @@
+/******************************************************************************
+ * \file	stse_platform_profiler.c
+ * \brief   STSecureElement crypto platform profiler
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include "stse_conf.h"
+#include "stse_platform_profiler.h"
+#include "stselib.h"
+
+#ifdef STSE_CONF_CRYPTO_PROFILER
+
+static stse_platform_profiler_entry_t profiler_table[STSE_PLATFORM_PROFILER_ENTRY_COUNT];
+
+static const char *const profiler_names[STSE_PLATFORM_PROFILER_ENTRY_COUNT] = {
+    [STSE_PLATFORM_PROFILER_ECC_VERIFY] = "ecc_verify",
+    [STSE_PLATFORM_PROFILER_ECC_VERIFY_BATCH] = "ecc_verify_batch",
+    [STSE_PLATFORM_PROFILER_ECC_SIGN] = "ecc_sign",
+    [STSE_PLATFORM_PROFILER_ECC_KEYGEN] = "ecc_keygen",
+    [STSE_PLATFORM_PROFILER_ECC_ECDH] = "ecc_ecdh",
+    [STSE_PLATFORM_PROFILER_NIST_KW] = "nist_kw",
+    [STSE_PLATFORM_PROFILER_NIST_KW_UNWRAP] = "nist_kw_unwrap",
+    [STSE_PLATFORM_PROFILER_HASH] = "hash",
+    [STSE_PLATFORM_PROFILER_HASH_UPDATE] = "hash_update",
+    [STSE_PLATFORM_PROFILER_HASH_FINAL] = "hash_final",
+    [STSE_PLATFORM_PROFILER_HKDF_EXTRACT] = "hkdf_extract",
+    [STSE_PLATFORM_PROFILER_HKDF_EXPAND] = "hkdf_expand",
+    [STSE_PLATFORM_PROFILER_HKDF] = "hkdf",
+    [STSE_PLATFORM_PROFILER_AES_CMAC_INIT] = "cmac_init",
+    [STSE_PLATFORM_PROFILER_AES_CMAC_APPEND] = "cmac_append",
+    [STSE_PLATFORM_PROFILER_AES_CMAC_FINISH] = "cmac_finish",
+    [STSE_PLATFORM_PROFILER_AES_CMAC] = "cmac",
+    [STSE_PLATFORM_PROFILER_AES_CBC_ENC] = "cbc_enc",
+    [STSE_PLATFORM_PROFILER_AES_CBC_DEC] = "cbc_dec",
+    [STSE_PLATFORM_PROFILER_AES_ECB_ENC] = "ecb_enc",
+    [STSE_PLATFORM_PROFILER_AES_ECB_DEC] = "ecb_dec",
+    [STSE_PLATFORM_PROFILER_AES_CBC_ENC_CMAC] = "cbc_enc_cmac",
+    [STSE_PLATFORM_PROFILER_AES_CMAC_CBC_DEC] = "cmac_cbc_dec",
+};
+
+void stse_platform_profiler_leave(stse_platform_profiler_scope_t *pScope) {
+    PLAT_UI32 cycles = cycle_counter_get() - pScope->start;
+    stse_platform_profiler_entry_t *pEntry = &profiler_table[pScope->id];
+    PLAT_UI32 primask = __get_PRIMASK();
+
+    __disable_irq();
+    pEntry->call_count++;
+    pEntry->byte_count += pScope->byte_count;
+    pEntry->total_cycles += cycles;
+    if (cycles > pEntry->max_cycles) {
+        pEntry->max_cycles = cycles;
+    }
+    __set_PRIMASK(primask);
+}
+
+void stse_platform_profiler_reset(void) {
+    PLAT_UI32 primask = __get_PRIMASK();
+
+    cycle_counter_init();
+
+    __disable_irq();
+    memset(profiler_table, 0, sizeof(profiler_table));
+    __set_PRIMASK(primask);
+}
+
+void stse_platform_profiler_get(stse_platform_profiler_id_t id, stse_platform_profiler_entry_t *pEntry) {
+    PLAT_UI32 primask = __get_PRIMASK();
+
+    __disable_irq();
+    *pEntry = profiler_table[id];
+    __set_PRIMASK(primask);
+}
+
+const char *stse_platform_profiler_get_name(stse_platform_profiler_id_t id) {
+    return (id < STSE_PLATFORM_PROFILER_ENTRY_COUNT) ? profiler_names[id] : "?";
+}
+
+#endif /* STSE_CONF_CRYPTO_PROFILER */
@@ -0,0 +1,122 @@
+/******************************************************************************
+ * \file	stse_platform_profiler.h
+ * \brief   STSecureElement crypto platform profiler
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STSE_PLATFORM_PROFILER_H
+#define STSE_PLATFORM_PROFILER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stse_conf.h"
+#include "stselib.h"
+
+/* Profiled crypto entry points */
+typedef enum {
+    STSE_PLATFORM_PROFILER_ECC_VERIFY = 0,
+    STSE_PLATFORM_PROFILER_ECC_VERIFY_BATCH,
+    STSE_PLATFORM_PROFILER_ECC_SIGN,
+    STSE_PLATFORM_PROFILER_ECC_KEYGEN,
+    STSE_PLATFORM_PROFILER_ECC_ECDH,
+    STSE_PLATFORM_PROFILER_NIST_KW,
+    STSE_PLATFORM_PROFILER_NIST_KW_UNWRAP,
+    STSE_PLATFORM_PROFILER_HASH,
+    STSE_PLATFORM_PROFILER_HASH_UPDATE,
+    STSE_PLATFORM_PROFILER_HASH_FINAL,
+    STSE_PLATFORM_PROFILER_HKDF_EXTRACT,
+    STSE_PLATFORM_PROFILER_HKDF_EXPAND,
+    STSE_PLATFORM_PROFILER_HKDF,
+    STSE_PLATFORM_PROFILER_AES_CMAC_INIT,
+    STSE_PLATFORM_PROFILER_AES_CMAC_APPEND,
+    STSE_PLATFORM_PROFILER_AES_CMAC_FINISH,
+    STSE_PLATFORM_PROFILER_AES_CMAC,
+    STSE_PLATFORM_PROFILER_AES_CBC_ENC,
+    STSE_PLATFORM_PROFILER_AES_CBC_DEC,
+    STSE_PLATFORM_PROFILER_AES_ECB_ENC,
+    STSE_PLATFORM_PROFILER_AES_ECB_DEC,
+    STSE_PLATFORM_PROFILER_AES_CBC_ENC_CMAC,
+    STSE_PLATFORM_PROFILER_AES_CMAC_CBC_DEC,
+    STSE_PLATFORM_PROFILER_ENTRY_COUNT
+} stse_platform_profiler_id_t;
+
+#ifdef STSE_CONF_CRYPTO_PROFILER
+
+#include "Drivers/cycle_counter/cycle_counter.h"
+
+/* Profiler entry */
+typedef struct {
+    PLAT_UI32 call_count;
+    PLAT_UI32 byte_count;   /* Bytes processed (payload, digest or output length) */
+    PLAT_UI64 total_cycles; /* Cumulative DWT cycles, nested calls included */
+    PLAT_UI32 max_cycles;   /* Longest call */
+} stse_platform_profiler_entry_t;
+
+/* Running measurement, recorded when it goes out of scope */
+typedef struct {
+    stse_platform_profiler_id_t id;
+    PLAT_UI32 byte_count;
+    PLAT_UI32 start;
+} stse_platform_profiler_scope_t;
+
+/**
+ * \brief  Record a measurement (scope cleanup of STSE_PLATFORM_PROFILE)
+ * \param  pScope : measurement
+ */
+void stse_platform_profiler_leave(stse_platform_profiler_scope_t *pScope);
+
+/**
+ * \brief  Profile the enclosing function : call count, DWT cycles until return and bytes
+ * \details Place at the top of the function body. Compiles to nothing without
+ *          STSE_CONF_CRYPTO_PROFILER.
+ */
+#define STSE_PLATFORM_PROFILE(id, bytes)                                                                                 \
+    stse_platform_profiler_scope_t stse_platform_profiler_scope __attribute__((cleanup(stse_platform_profiler_leave))) = \
+        {(id), (PLAT_UI32)(bytes), cycle_counter_get()}
+
+/**
+ * \brief  Clear the profiler table and start the DWT cycle counter
+ */
+void stse_platform_profiler_reset(void);
+
+/**
+ * \brief  Get a profiler entry
+ * \param  id : crypto entry point
+ * \param  pEntry : entry output (snapshot)
+ */
+void stse_platform_profiler_get(stse_platform_profiler_id_t id, stse_platform_profiler_entry_t *pEntry);
+
+/**
+ * \brief  Get the name of a crypto entry point
+ * \param  id : crypto entry point
+ * \return entry point name
+ */
+const char *stse_platform_profiler_get_name(stse_platform_profiler_id_t id);
+
+#else
+
+#define STSE_PLATFORM_PROFILE(id, bytes)
+
+#endif /* STSE_CONF_CRYPTO_PROFILER */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STSE_PLATFORM_PROFILER_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,133 @@
+/******************************************************************************
+ * \file	stse_platform_scratch.c
+ * \brief   STSecureElement crypto scratch memory (arena and zeroisation)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include "Drivers/ram_arena/ram_arena.h"
+#include "stse_conf.h"
+#include "stse_platform_scratch.h"
+#include "stselib.h"
+
+#define STSE_PLATFORM_SCRATCH_WORDS ((STSE_CONF_CRYPTO_SCRATCH_SIZE + 3U) / sizeof(PLAT_UI32))
+
+static PLAT_UI32 scratch_arena[STSE_PLATFORM_SCRATCH_WORDS] RAM2_CRYPTO;
+static PLAT_UI32 scratch_top; /* Bytes handed out */
+static PLAT_UI32 scratch_hwm; /* Highest top since the last release : bytes to wipe */
+static stse_platform_scratch_stats_t scratch_stats;
+
+void *stse_platform_scratch_alloc(PLAT_UI32 size) {
+    PLAT_UI32 primask = __get_PRIMASK();
+    void *pRegion = NULL;
+
+    size = (size + 3U) & ~3U;
+
+    __disable_irq();
+    if (size <= (sizeof(scratch_arena) - scratch_top)) {
+        pRegion = (PLAT_UI8 *)scratch_arena + scratch_top;
+        scratch_top += size;
+        if (scratch_top > scratch_hwm) {
+            scratch_hwm = scratch_top;
+        }
+        if (scratch_top > scratch_stats.peak) {
+            scratch_stats.peak = scratch_top;
+        }
+        scratch_stats.alloc_count++;
+    } else {
+        scratch_stats.failed_count++;
+    }
+    __set_PRIMASK(primask);
+
+    return pRegion;
+}
+
+void stse_platform_scratch_release(void *pRegion) {
+    PLAT_UI32 offset = (PLAT_UI32)((PLAT_UI8 *)pRegion - (PLAT_UI8 *)scratch_arena);
+    PLAT_UI32 primask = __get_PRIMASK();
+
+    if (pRegion == NULL) {
+        return;
+    }
+
+    /* - Check, wipe and update the top in one critical section : an allocation
+     *   from an interrupt cannot land in the bytes being wiped */
+    __disable_irq();
+    if (offset < scratch_top) {
+        /* - Wipe the touched bytes above the region start only */
+        stse_platform_scratch_wipe(pRegion, scratch_hwm - offset);
+        scratch_stats.wiped_byte_count += scratch_hwm - offset;
+        scratch_top = offset;
+        scratch_hwm = offset;
+    }
+    __set_PRIMASK(primask);
+}
+
+void stse_platform_scratch_get_stats(stse_platform_scratch_stats_t *pStats) {
+    *pStats = scratch_stats;
+}
+
+void stse_platform_scratch_wipe(void *pBuffer, PLAT_UI32 length) {
+    volatile PLAT_UI8 *p = (volatile PLAT_UI8 *)pBuffer;
+
+    /* - Byte stores up to the first word boundary, word stores, then the tail */
+    while ((length != 0) && (((PLAT_UI32)p & 3U) != 0)) {
+        *p++ = 0;
+        length--;
+    }
+    for (; length >= sizeof(PLAT_UI32); length -= sizeof(PLAT_UI32)) {
+        *(volatile PLAT_UI32 *)p = 0;
+        p += sizeof(PLAT_UI32);
+    }
+    while (length--) {
+        *p++ = 0;
+    }
+}
+
+PLAT_UI32 stse_platform_scratch_touched(const void *pRegion, PLAT_UI32 size, PLAT_UI32 hwm) {
+    const PLAT_UI32 *pWords = (const PLAT_UI32 *)pRegion;
+    PLAT_UI32 words = size / sizeof(PLAT_UI32);
+    PLAT_UI32 mark = (hwm + 3U) / sizeof(PLAT_UI32);
+
+    if (mark >= words) {
+        return words * sizeof(PLAT_UI32);
+    }
+
+    /* - Last non-zero word above the known mark : zero words inside the touched
+     *   part (zero limbs, alignment gaps) do not bound the library usage */
+    while ((words > mark) && (pWords[words - 1] == 0)) {
+        words--;
+    }
+
+    return words * sizeof(PLAT_UI32);
+}
+
+PLAT_UI32 stse_platform_scratch_wipe_touched(void *pRegion, PLAT_UI32 size, PLAT_UI32 bound, PLAT_UI8 full_scan) {
+    const PLAT_UI32 *pWords = (const PLAT_UI32 *)pRegion;
+    PLAT_UI32 words = size / sizeof(PLAT_UI32);
+    PLAT_UI32 mark = (bound + 3U) / sizeof(PLAT_UI32);
+
+    if (mark > words) {
+        mark = words;
+    }
+
+    /* - The library fills the region from its start : a write above the bound
+     *   reaches the guard word first, the periodic full scan covers the rest */
+    if ((full_scan != 0) || (mark == 0) || ((mark < words) && (pWords[mark] != 0))) {
+        mark = stse_platform_scratch_touched(pRegion, size, mark * sizeof(PLAT_UI32)) / sizeof(PLAT_UI32);
+    }
+
+    stse_platform_scratch_wipe(pRegion, mark * sizeof(PLAT_UI32));
+
+    return mark * sizeof(PLAT_UI32);
+}
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * \file	stse_platform_scratch.h
+ * \brief   STSecureElement crypto scratch memory (arena and zeroisation)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STSE_PLATFORM_SCRATCH_H
+#define STSE_PLATFORM_SCRATCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stse_conf.h"
+#include "stselib.h"
+
+/* Crypto scratch arena size in bytes (per operation temporaries : HMAC states, HKDF blocks) */
+#ifndef STSE_CONF_CRYPTO_SCRATCH_SIZE
+#define STSE_CONF_CRYPTO_SCRATCH_SIZE 512
+#endif
+
+/* Crypto scratch arena statistics */
+typedef struct {
+    PLAT_UI32 alloc_count;      /* Regions handed out */
+    PLAT_UI32 failed_count;     /* Allocations rejected, arena full */
+    PLAT_UI32 peak;             /* Highest arena usage (bytes) */
+    PLAT_UI32 wiped_byte_count; /* Bytes zeroised on release */
+} stse_platform_scratch_stats_t;
+
+/**
+ * \brief  Allocate a per operation region from the crypto scratch arena
+ * \details Regions are released in reverse allocation order.
+ * \param  size : region size (rounded up to a word multiple)
+ * \return word aligned region, NULL if the arena is full
+ */
+void *stse_platform_scratch_alloc(PLAT_UI32 size);
+
+/**
+ * \brief  Release a region and every region allocated after it
+ * \details Only the bytes handed out since the last release (up to the arena
+ *          high-water mark) are zeroised, not the whole arena. The wipe runs with
+ *          interrupts masked (at most STSE_CONF_CRYPTO_SCRATCH_SIZE bytes).
+ * \param  pRegion : region returned by stse_platform_scratch_alloc()
+ */
+void stse_platform_scratch_release(void *pRegion);
+
+/**
+ * \brief  Get the crypto scratch arena statistics
+ * \param  pStats : statistics output
+ */
+void stse_platform_scratch_get_stats(stse_platform_scratch_stats_t *pStats);
+
+/**
+ * \brief  Zeroise sensitive memory (not optimized out, word stores on the aligned part)
+ * \param  pBuffer : buffer
+ * \param  length : buffer length
+ */
+void stse_platform_scratch_wipe(void *pBuffer, PLAT_UI32 length);
+
+/**
+ * \brief  Get the number of bytes touched in a zero-initialized region filled by a library
+ * \details Used for buffers handed to CMOX (math buffers) : the region is scanned
+ *          down from its end to the known high-water mark for the last non-zero
+ *          word, so the returned length never decreases and every non-zero byte
+ *          lies below it.
+ * \param  pRegion : word aligned region, zero outside of the touched bytes
+ * \param  size : region size
+ * \param  hwm : known high-water mark (0 if unknown)
+ * \return touched length, at least hwm rounded up (word multiple, bounded by size)
+ */
+PLAT_UI32 stse_platform_scratch_touched(const void *pRegion, PLAT_UI32 size, PLAT_UI32 hwm);
+
+/**
+ * \brief  Zeroise the touched part of a zero-initialized region filled by a library
+ * \details Used to release buffers handed to CMOX (math buffers) without a full scan :
+ *          only the bytes below the known bound are wiped once the word at the bound
+ *          (guard word) is found zero. An unknown bound, a non-zero guard word or a
+ *          full scan request fall back to stse_platform_scratch_touched() from the
+ *          region end, which raises the bound.
+ * \param  pRegion : word aligned region, zero above the touched bytes
+ * \param  size : region size
+ * \param  bound : known bound of the library usage (0 if unknown)
+ * \param  full_scan : scan the region from its end even if the guard word is zero
+ * \return bytes wiped : new bound, at least bound rounded up (word multiple, bounded by size)
+ */
+PLAT_UI32 stse_platform_scratch_wipe_touched(void *pRegion, PLAT_UI32 size, PLAT_UI32 bound, PLAT_UI8 full_scan);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STSE_PLATFORM_SCRATCH_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
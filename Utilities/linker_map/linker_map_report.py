@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2022 STMicroelectronics
+#
+# This software is licensed under terms that can be found in the LICENSE file in
+# the root directory of this software component.
+# If no LICENSE file comes with this software, it is provided AS-IS.
+#
+"""STSAFE-A echo loop memory placement report.
+
+Reads the GNU ld map file of a build (-Wl,-Map=...) and reports the usage of
+each memory region of STM32L452RETX_FLASH.ld, then where each hot object
+(I/O frame buffers, crypto scratch, lookup tables) lives : FLASH (read with
+wait states), SRAM1 (system bus, shared with the DMA) or SRAM2 (RAM2 alias,
+placement sections of Platform/Drivers/ram_arena/ram_arena.h).
+
+Build with "-fdata-sections" to get one input section per object.
+
+Usage:
+    linker_map_report.py Debug/STSAFE-A_echo.map
+    linker_map_report.py Debug/STSAFE-A_echo.map --hot "I2c_buffer|crc16_tab"
+"""
+
+import argparse
+import os
+import re
+import sys
+
+DEFAULT_HOT = (r"fast_io|ram2_|I2c_buffer|echo_scheduler|ecc_context_pool|ecc_key_pool|scratch_arena|"
+               r"crc16_tab|math_buffer")
+
+MEMORY_LINE = re.compile(r"^(?P<name>\S+)\s+0x(?P<origin>[0-9a-fA-F]+)\s+0x(?P<length>[0-9a-fA-F]+)(\s+\S+)?$")
+ADDRESS_SIZE = re.compile(r"^\s+0x(?P<address>[0-9a-fA-F]+)\s+0x(?P<size>[0-9a-fA-F]+)"
+                          r"(\s+load address 0x(?P<load>[0-9a-fA-F]+))?(\s+(?P<file>\S.*))?$")
+SYMBOL_LINE = re.compile(r"^\s+0x(?P<address>[0-9a-fA-F]+)\s+(?P<name>[A-Za-z_][A-Za-z0-9_.$]*)$")
+
+BUS_NOTES = {
+    "FLASH": "flash (wait states)",
+    "RAM": "SRAM1 (shared with DMA)",
+    "RAM2": "SRAM2 (CPU)",
+}
+
+
+class Region:
+    def __init__(self, name, origin, length):
+        self.name = name
+        self.origin = origin
+        self.length = length
+        self.used = 0
+
+    def contains(self, address):
+        return self.origin <= address < self.origin + self.length
+
+
+class InputSection:
+    def __init__(self, name, output, address, size, file_name):
+        self.name = name
+        self.output = output
+        self.address = address
+        self.size = size
+        self.file_name = file_name
+        self.symbols = []
+
+
+def parse(map_path):
+    regions = []
+    outputs = []
+    inputs = []
+    with open(map_path) as map_file:
+        lines = [line.rstrip("\n") for line in map_file]
+
+    index = 0
+    while index < len(lines) and not lines[index].startswith("Memory Configuration"):
+        index += 1
+    while index < len(lines) and not lines[index].startswith("Linker script and memory map"):
+        match = MEMORY_LINE.match(lines[index])
+        if match is not None and match.group("name") not in ("Name", "*default*"):
+            regions.append(Region(match.group("name"), int(match.group("origin"), 16),
+                                  int(match.group("length"), 16)))
+        index += 1
+
+    output = None
+    pending = None  # Section name wrapped on its own line
+    for line in lines[index:]:
+        if pending is not None:
+            match = ADDRESS_SIZE.match(line)
+            name, is_output = pending
+            pending = None
+            if match is not None:
+                line = ("" if is_output else " ") + name + line
+        if re.match(r"^\.\S+$", line) or re.match(r"^ \.\S+$", line):
+            pending = (line.strip(), not line.startswith(" "))
+            continue
+        if line.startswith(".") or line.startswith(" ."):
+            is_output = not line.startswith(" ")
+            name, rest = line.strip().split(None, 1)
+            match = ADDRESS_SIZE.match(" " + rest)
+            if match is None:
+                continue
+            address = int(match.group("address"), 16)
+            size = int(match.group("size"), 16)
+            if is_output:
+                load = int(match.group("load"), 16) if match.group("load") else None
+                output = name
+                outputs.append((name, address, size, load))
+            elif size != 0:
+                file_name = os.path.basename(match.group("file") or "")
+                inputs.append(InputSection(name, output, address, size, file_name))
+            continue
+        match = SYMBOL_LINE.match(line)
+        if match is not None and inputs and inputs[-1].address <= int(match.group("address"), 16) \
+                < inputs[-1].address + inputs[-1].size:
+            inputs[-1].symbols.append(match.group("name"))
+    return regions, outputs, inputs
+
+
+def region_of(regions, address):
+    for region in regions:
+        if region.contains(address):
+            return region
+    return None
+
+
+def object_name(section):
+    """Object name : global symbols of the input section, else the -fdata-sections suffix."""
+    if section.symbols:
+        return ", ".join(section.symbols)
+    for prefix in (".bss.", ".data.", ".rodata.", ".ram2_bss.", ".ram2_data."):
+        if section.name.startswith(prefix):
+            return section.name[len(prefix):]
+    return section.name
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Report the memory placement of the hot objects")
+    parser.add_argument("map", help="GNU ld map file")
+    parser.add_argument("--hot", default=DEFAULT_HOT, help="hot object regex (input section, symbol or object file)")
+    args = parser.parse_args()
+
+    regions, outputs, inputs = parse(args.map)
+    if not regions or not outputs:
+        sys.stderr.write("%s is not a GNU ld map file\n" % args.map)
+        return 2
+
+    for name, address, size, load in outputs:
+        region = region_of(regions, address)
+        if region is not None and size != 0:
+            region.used += size
+        load_region = region_of(regions, load) if load is not None else None
+        if load_region is not None and load_region is not region and not name.endswith("bss") \
+                and not name.startswith("._"):
+            load_region.used += size
+
+    sys.stdout.write("%-8s %10s %8s %8s %6s\n" % ("region", "origin", "size", "used", "usage"))
+    for region in regions:
+        sys.stdout.write("%-8s 0x%08X %8d %8d %5d%%\n" % (region.name, region.origin, region.length, region.used,
+                                                          100 * region.used // region.length))
+
+    hot = re.compile(args.hot)
+    rows = [section for section in inputs
+            if hot.search(section.name) or hot.search(section.file_name)
+            or any(hot.search(symbol) for symbol in section.symbols)]
+    sys.stdout.write("\n%-32s %-14s %10s %6s %-26s %s\n" % ("hot object", "section", "address", "size",
+                                                              "memory", "object file"))
+    for section in sorted(rows, key=lambda item: item.address):
+        region = region_of(regions, section.address)
+        memory = BUS_NOTES.get(region.name, region.name) if region is not None else "-"
+        sys.stdout.write("%-32s %-14s 0x%08X %6d %-26s %s\n" % (object_name(section)[:32], section.output,
+                                                                section.address, section.size, memory,
+                                                                section.file_name))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2022 STMicroelectronics
+#
+# This software is licensed under terms that can be found in the LICENSE file in
+# the root directory of this software component.
+# If no LICENSE file comes with this software, it is provided AS-IS.
+#
+"""STSAFE-A echo loop static stack usage report.
+
+Reads the GCC stack usage files of a build directory and reports the stack
+frame and the worst-case stack depth of the host crypto entry points of the
+platform layer (Platform/STSELib/stse_platform_*.c).
+
+Build with "-fstack-usage" (.su files: frame of each function) and, for the
+worst-case depth, "-fcallgraph-info=su" (.ci files: call graph, GCC 10 or
+later). Functions without stack information (CMOX library, newlib) are listed
+as unknown callees : their usage has to be added from the library
+documentation.
+
+Usage:
+    stack_usage_report.py Debug
+    stack_usage_report.py Debug --entry "^stse_platform_ecc_" --stack-size 0x2000
+"""
+
+import argparse
+import os
+import re
+import sys
+
+DEFAULT_ENTRY = r"^stse_platform_(ecc|hash|hmac|hkdf|aes|nist_kw)_"
+DEFAULT_STACK_SIZE = 0x2000  # _Min_Stack_Size of STM32L452RETX_FLASH.ld
+
+SU_LINE = re.compile(r"^(?P<file>.*?):(?P<line>\d+):(?P<column>\d+):(?P<name>[^\t]+)\t(?P<size>\d+)\t(?P<qualifier>.+)$")
+CI_EDGE = re.compile(r'edge: \{ sourcename: "(?P<source>[^"]+)" targetname: "(?P<target>[^"]+)"')
+
+
+class Function:
+    def __init__(self, name, location, size, qualifier):
+        self.name = name
+        self.location = location
+        self.size = size
+        self.qualifier = qualifier
+        self.callees = set()
+
+
+def load(build_dir):
+    functions = {}
+    edges = []
+    for root, _, files in os.walk(build_dir):
+        for file_name in files:
+            path = os.path.join(root, file_name)
+            if file_name.endswith(".su"):
+                with open(path) as su_file:
+                    for line in su_file:
+                        match = SU_LINE.match(line.rstrip("\n"))
+                        if match is None:
+                            continue
+                        name = match.group("name")
+                        location = "%s:%s" % (os.path.basename(match.group("file")), match.group("line"))
+                        functions[name] = Function(name, location, int(match.group("size")),
+                                                   match.group("qualifier"))
+            elif file_name.endswith(".ci"):
+                with open(path) as ci_file:
+                    for line in ci_file:
+                        match = CI_EDGE.search(line)
+                        if match is not None:
+                            edges.append((match.group("source"), match.group("target")))
+    for source, target in edges:
+        if source in functions:
+            functions[source].callees.add(target)
+    return functions, len(edges) != 0
+
+
+def depth(functions, name, path, cache):
+    """Worst-case stack depth from a function and its callees without stack information.
+
+    The depth is None when the call graph is recursive (unbounded).
+    """
+    if name in cache:
+        return cache[name]
+    function = functions.get(name)
+    if function is None:
+        return 0, frozenset([name])
+    if name in path:
+        return None, frozenset()
+    path.add(name)
+    worst = 0
+    unknown = set()
+    for callee in function.callees:
+        callee_depth, callee_unknown = depth(functions, callee, path, cache)
+        unknown |= callee_unknown
+        if callee_depth is None:
+            worst = None
+        elif worst is not None:
+            worst = max(worst, callee_depth)
+    path.discard(name)
+    cache[name] = (None if worst is None else function.size + worst), frozenset(unknown)
+    return cache[name]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Report the stack usage of the host crypto entry points")
+    parser.add_argument("build_dir", help="build directory holding the .su (and .ci) files")
+    parser.add_argument("--entry", default=DEFAULT_ENTRY, help="entry point name regex")
+    parser.add_argument("--stack-size", type=lambda value: int(value, 0), default=DEFAULT_STACK_SIZE,
+                        help="stack reservation to budget against (default 0x%X)" % DEFAULT_STACK_SIZE)
+    args = parser.parse_args()
+
+    functions, has_callgraph = load(args.build_dir)
+    if not functions:
+        sys.stderr.write("no .su file found in %s, build with -fstack-usage\n" % args.build_dir)
+        return 2
+
+    entry = re.compile(args.entry)
+    entries = sorted(name for name in functions if entry.search(name))
+    cache = {}
+    status = 0
+
+    sys.stdout.write("%-48s %6s %-16s %8s %6s  %s\n" % ("entry point", "frame", "qualifier", "depth", "budget", "location"))
+    for name in entries:
+        function = functions[name]
+        worst, unknown = depth(functions, name, set(), cache) if has_callgraph else (None, frozenset())
+        if worst is None:
+            depth_text, budget_text = ("unbound" if has_callgraph else "-"), "-"
+        else:
+            depth_text = "%d%s" % (worst, "+" if unknown else "")
+            budget_text = "%d%%" % (100 * worst // args.stack_size)
+            if worst > args.stack_size:
+                status = 1
+        if function.qualifier != "static":
+            status = 1
+        sys.stdout.write("%-48s %6d %-16s %8s %6s  %s\n"
+                         % (name, function.size, function.qualifier, depth_text, budget_text, function.location))
+        if unknown:
+            sys.stdout.write("%-48s unknown callees: %s\n" % ("", ", ".join(sorted(unknown))))
+
+    if not has_callgraph:
+        sys.stdout.write("\nno .ci file found : build with -fcallgraph-info=su for the worst-case depth\n")
+    if status != 0:
+        sys.stdout.write("\nnon static frame or stack budget exceeded\n")
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2022 STMicroelectronics
+#
+# This software is licensed under terms that can be found in the LICENSE file in
+# the root directory of this software component.
+# If no LICENSE file comes with this software, it is provided AS-IS.
+#
+"""STSAFE-A echo loop telemetry decoder.
+
+Reconstructs human readable logs from the binary telemetry stream sent by
+Application/Apps/apps_telemetry.c (COBS framed records, see apps_telemetry.h).
+
+Usage:
+    telemetry_decoder.py --port COM5            # live decode (requires pyserial)
+    telemetry_decoder.py capture.bin            # decode a raw capture
+    telemetry_decoder.py capture.bin --csv echo.csv
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+RECORD_BOOT = 0x01
+RECORD_TEXT = 0x02
+RECORD_ECHO = 0x03
+RECORD_PRESENCE = 0x04
+RECORD_STATS = 0x05
+
+PRESENCE_EVENTS = {0: "ATTACHED", 1: "DETACHED", 2: "STABLE"}
+
+
+def crc16_x25(data):
+    """CRC16 X.25 (reflected 0x1021, init 0xFFFF, final xor 0xFFFF)."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = (crc >> 1) ^ 0x8408 if crc & 1 else crc >> 1
+    return crc ^ 0xFFFF
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            raise ValueError("invalid COBS block")
+        out += data[i + 1:i + code]
+        i += code
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class Decoder:
+    def __init__(self, out, csv_writer=None):
+        self.out = out
+        self.csv_writer = csv_writer
+        self.buffer = bytearray()
+        self.next_sequence = None
+        self.frames = 0
+        self.lost = 0
+        self.corrupted = 0
+
+    def feed(self, data):
+        for byte in data:
+            if byte != 0:
+                self.buffer.append(byte)
+                continue
+            if self.buffer:
+                self._frame(bytes(self.buffer))
+                self.buffer.clear()
+
+    def _frame(self, encoded):
+        try:
+            frame = cobs_decode(encoded)
+        except ValueError:
+            self.corrupted += 1
+            return
+        if len(frame) < 5 or crc16_x25(frame[:-2]) != struct.unpack_from("<H", frame, len(frame) - 2)[0]:
+            self.corrupted += 1
+            self.out.write("\n[telemetry] corrupted frame dropped\n")
+            return
+
+        record_type, sequence = struct.unpack_from("<BH", frame)
+        payload = frame[3:-2]
+        self.frames += 1
+
+        if record_type == RECORD_BOOT:
+            self.next_sequence = None
+        if self.next_sequence is not None and sequence != self.next_sequence:
+            missed = (sequence - self.next_sequence) & 0xFFFF
+            self.lost += missed
+            self.out.write("\n[telemetry] %d frame(s) lost before #%d\n" % (missed, sequence))
+        self.next_sequence = (sequence + 1) & 0xFFFF
+
+        handler = {
+            RECORD_BOOT: self._boot,
+            RECORD_TEXT: self._text,
+            RECORD_ECHO: self._echo,
+            RECORD_PRESENCE: self._presence,
+            RECORD_STATS: self._stats,
+        }.get(record_type)
+        if handler is None:
+            self.out.write("\n[telemetry] #%d unknown record 0x%02X : %s\n" % (sequence, record_type, payload.hex()))
+        else:
+            handler(sequence, payload)
+        self.out.flush()
+
+    def _boot(self, sequence, payload):
+        version, clock = struct.unpack_from("<BI", payload)
+        self.out.write("\n[telemetry] #%d boot : protocol v%d, core clock %d Hz\n" % (sequence, version, clock))
+
+    def _text(self, sequence, payload):
+        self.out.write(payload.decode("ascii", errors="replace").replace("\r", ""))
+
+    def _echo(self, sequence, payload):
+        device, status, length, message_crc, mismatch, duration_us = struct.unpack_from("<BHHHHI", payload)
+        if status != 0:
+            result = "ERROR 0x%04X" % status
+        elif mismatch != 0xFFFF:
+            result = "COMPARE ERROR at byte %d" % mismatch
+        else:
+            result = "OK"
+        self.out.write("\n #%05d device %d : echo %d bytes (crc 0x%04X) in %d us : %s"
+                       % (sequence, device, length, message_crc, duration_us, result))
+        if self.csv_writer is not None:
+            self.csv_writer.writerow([sequence, device, length, "0x%04X" % message_crc,
+                                      duration_us, "0x%04X" % status, "" if mismatch == 0xFFFF else mismatch])
+
+    def _presence(self, sequence, payload):
+        device, event = struct.unpack_from("<BB", payload)
+        self.out.write("\n #%05d device %d %s" % (sequence, device, PRESENCE_EVENTS.get(event, "event %d" % event)))
+
+    def _stats(self, sequence, payload):
+        (device, enabled, echo_count, error_count, compare_error_count,
+         byte_count, busy_us, recovery_count) = struct.unpack_from("<BBIIIIII", payload)
+        throughput = byte_count * 1000000 // busy_us if busy_us else 0
+        self.out.write("\n #%05d device %d %s : %d echo, %d error, %d compare error, %d bytes, %d B/s, %d recovery"
+                       % (sequence, device, "ON " if enabled else "OFF", echo_count, error_count,
+                          compare_error_count, byte_count, throughput, recovery_count))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode STSAFE-A echo loop binary telemetry")
+    parser.add_argument("capture", nargs="?", help="raw capture file (default: stdin)")
+    parser.add_argument("--port", help="serial port to read from (requires pyserial)")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--csv", help="write echo records to a CSV file")
+    args = parser.parse_args()
+
+    csv_file = open(args.csv, "w", newline="") if args.csv else None
+    csv_writer = None
+    if csv_file is not None:
+        csv_writer = csv.writer(csv_file)
+        csv_writer.writerow(["sequence", "device", "length", "message_crc", "duration_us", "status", "mismatch"])
+
+    decoder = Decoder(sys.stdout, csv_writer)
+    try:
+        if args.port:
+            import serial
+            with serial.Serial(args.port, args.baudrate, timeout=1) as port:
+                while True:
+                    decoder.feed(port.read(256))
+        else:
+            source = open(args.capture, "rb") if args.capture else sys.stdin.buffer
+            with source:
+                for chunk in iter(lambda: source.read(4096), b""):
+                    decoder.feed(chunk)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if csv_file is not None:
+            csv_file.close()
+        sys.stdout.write("\n[telemetry] %d frames, %d lost, %d corrupted\n"
+                         % (decoder.frames, decoder.lost, decoder.corrupted))
+
+
+if __name__ == "__main__":
+    main()